@@ -27,4 +27,7 @@ mklink /J output\cpp\regions src\Stormancer.Plugins\Regions\cpp
 
 
 rmdir output\cpp\friends
-mklink /J output\cpp\friends src\Stormancer.Plugins\Friends\cpp
\ No newline at end of file
+mklink /J output\cpp\friends src\Stormancer.Plugins\Friends\cpp
+
+rmdir output\cpp\spectate
+mklink /J output\cpp\spectate src\Stormancer.Plugins\Spectate\cpp
\ No newline at end of file
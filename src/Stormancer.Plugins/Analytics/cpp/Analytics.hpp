@@ -22,13 +22,112 @@
 
 #pragma once
 #include "Users/ClientAPI.hpp"
+#include "Users/ConfigurationParameters.hpp"
 #include "stormancer/IPlugin.h"
+#include "stormancer/Configuration.h"
+#include "stormancer/Tasks.h"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <mutex>
 
 namespace Stormancer
 {
 	namespace Analytics
 	{
-		
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the Analytics plugin behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Maximum number of documents waiting to be sent.
+			/// Default is "10000".
+			/// </summary>
+			constexpr const char* MaxBufferedDocuments = "analytics.buffer.maxDocuments";
+
+			/// <summary>
+			/// Which documents to drop when the buffer is full: "dropOldest" or "dropNewest".
+			/// Default is "dropOldest".
+			/// </summary>
+			constexpr const char* DropPolicy = "analytics.buffer.dropPolicy";
+
+			/// <summary>
+			/// Interval between two flushes of the buffer, in milliseconds.
+			/// Default is "1000".
+			/// </summary>
+			constexpr const char* FlushIntervalMs = "analytics.flushIntervalMs";
+
+			/// <summary>
+			/// Maximum approximate size in bytes of a single Analytics.Push message. Larger flushes are split into several messages.
+			/// Default is "65536".
+			/// </summary>
+			constexpr const char* MaxBatchBytes = "analytics.maxBatchBytes";
+
+			/// <summary>
+			/// Path of the file where documents are spooled while the analytics scene is not connected.
+			/// Default is empty: documents stay in the in-memory buffer while offline.
+			/// </summary>
+			constexpr const char* SpoolPath = "analytics.spool.path";
+
+			/// <summary>
+			/// Maximum size in bytes of the spool file. Documents that don't fit are dropped.
+			/// Default is "4194304".
+			/// </summary>
+			constexpr const char* SpoolMaxBytes = "analytics.spool.maxBytes";
+		}
+
+		enum class AnalyticsDropPolicy
+		{
+			/// <summary>
+			/// Drop the oldest buffered documents to make room for new ones.
+			/// </summary>
+			DropOldest = 0,
+
+			/// <summary>
+			/// Reject new documents while the buffer is full.
+			/// </summary>
+			DropNewest = 1
+		};
+
+		/// <summary>
+		/// Counters of the analytics pipeline, since the client was created.
+		/// </summary>
+		struct AnalyticsStats
+		{
+			/// <summary>
+			/// Number of documents pushed by the application.
+			/// </summary>
+			uint64 pushed = 0;
+
+			/// <summary>
+			/// Number of documents sent to the server.
+			/// </summary>
+			uint64 sent = 0;
+
+			/// <summary>
+			/// Number of messages sent to the server.
+			/// </summary>
+			uint64 batchesSent = 0;
+
+			/// <summary>
+			/// Number of documents dropped because the buffer or the spool was full.
+			/// </summary>
+			uint64 dropped = 0;
+
+			/// <summary>
+			/// Number of documents written to the spool file while offline.
+			/// </summary>
+			uint64 spooled = 0;
+
+			/// <summary>
+			/// Number of documents currently in the in-memory buffer.
+			/// </summary>
+			std::size_t buffered = 0;
+		};
+
 		struct AnalyticsDocument
 		{
 			/// <summary>
@@ -70,9 +169,13 @@ namespace Stormancer
 				}
 
 				//push analytics
-				void pushAnalyticDocuments(std::vector<AnalyticsDocument>& documents)
+				void pushAnalyticDocuments(const std::vector<AnalyticsDocument>& documents)
 				{
 					auto scene = _scene.lock();
+					if (!scene)
+					{
+						throw std::runtime_error("The analytics scene is disconnected");
+					}
 					auto serializer = _serializer;
 					scene->send("Analytics.Push", [serializer, &documents](obytestream& s)
 					{
@@ -96,77 +199,334 @@ namespace Stormancer
 			friend class AnalyticsPlugin;
 		public:
 
-			AnalyticsApi(std::weak_ptr<IActionDispatcher> wActionDispatcher)
-				: _wActionDispatcher(wActionDispatcher)
+			AnalyticsApi(std::shared_ptr<Configuration> config, std::shared_ptr<ILogger> logger, std::shared_ptr<PeriodicTaskScheduler> scheduler)
+				: _logger(logger)
+				, _wScheduler(scheduler)
 			{
+				_maxBufferedDocuments = readConfigurationParameter(config, ConfigurationKeys::MaxBufferedDocuments, _maxBufferedDocuments);
+				_flushInterval = std::chrono::milliseconds(readConfigurationParameter(config, ConfigurationKeys::FlushIntervalMs, 1000));
+				_maxBatchBytes = readConfigurationParameter(config, ConfigurationKeys::MaxBatchBytes, _maxBatchBytes);
+				_spoolMaxBytes = readConfigurationParameter(config, ConfigurationKeys::SpoolMaxBytes, _spoolMaxBytes);
 
+				auto it = config->additionalParameters.find(ConfigurationKeys::DropPolicy);
+				if (it != config->additionalParameters.end() && it->second == "dropNewest")
+				{
+					_dropPolicy = AnalyticsDropPolicy::DropNewest;
+				}
+				it = config->additionalParameters.find(ConfigurationKeys::SpoolPath);
+				if (it != config->additionalParameters.end())
+				{
+					_spoolPath = it->second;
+				}
 			}
 
 			~AnalyticsApi() 
 			{
-				_cts.cancel();
+				if (_pushTask)
+				{
+					_pushTask->stop();
+				}
 			}
 
-			void pushAnalyticDocuments(std::vector<AnalyticsDocument>& documents)
+			/// <summary>
+			/// Adds documents to the send buffer.
+			/// </summary>
+			/// <returns>false if documents were dropped because the buffer is full. The application should then slow down.</returns>
+			bool pushAnalyticDocuments(const std::vector<AnalyticsDocument>& documents)
 			{
 				std::lock_guard<std::mutex> lg(_mutex);
-				for (auto d : documents)
+				bool accepted = true;
+				for (auto& d : documents)
 				{
-					this->_documents.push_back(d);
+					accepted = enqueue(d) && accepted;
 				}
-				
+				return accepted;
+			}
+
+			/// <summary>
+			/// Adds a document to the send buffer.
+			/// </summary>
+			/// <returns>false if a document was dropped because the buffer is full. The application should then slow down.</returns>
+			bool pushAnalyticsDocuments(const AnalyticsDocument& document)
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return enqueue(document);
 			}
-			void pushAnalyticsDocuments(AnalyticsDocument& document)
+
+			/// <summary>
+			/// Gets a value indicating whether the buffer is more than 3/4 full.
+			/// </summary>
+			/// <remarks>
+			/// Producers of high volume, low value events should skip them while this returns true.
+			/// </remarks>
+			bool isBackpressured()
 			{
 				std::lock_guard<std::mutex> lg(_mutex);
-				this->_documents.push_back(document);
+				return _documents.size() * 4 >= _maxBufferedDocuments * 3;
+			}
+
+			AnalyticsStats stats()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				auto stats = _stats;
+				stats.buffered = _documents.size();
+				return stats;
+			}
+
+			/// <summary>
+			/// Sends the buffered documents now instead of waiting for the next timer tick.
+			/// </summary>
+			void flush()
+			{
+				tryPushAnalytics();
 			}
-		
 
 		private:
+
+			static std::size_t estimateSize(const AnalyticsDocument& document)
+			{
+				// Strings + msgpack headers and timestamp.
+				return document.type.size() + document.content.size() + document.category.size() + 24;
+			}
+
+			// Requires _mutex
+			bool enqueue(const AnalyticsDocument& document)
+			{
+				_stats.pushed++;
+				if (_documents.size() >= _maxBufferedDocuments)
+				{
+					_stats.dropped++;
+					if (_dropPolicy == AnalyticsDropPolicy::DropNewest)
+					{
+						return false;
+					}
+					_documents.pop_front();
+					_documents.push_back(document);
+					return false;
+				}
+				_documents.push_back(document);
+				return true;
+			}
+
 			void initialize()
 			{
-				scheduleTryPushAnalytics();
+				auto scheduler = _wScheduler.lock();
+				if (!scheduler)
+				{
+					return;
+				}
+
+				std::weak_ptr<AnalyticsApi> wThat = this->shared_from_this();
+				// Runs on a thread pool thread: pushing may block on the spool file.
+				_pushTask = scheduler->createTask("analytics.push", _flushInterval, [wThat]()
+				{
+					if (auto that = wThat.lock())
+					{
+						try
+						{
+							that->tryPushAnalytics();
+						}
+						catch (const std::exception& ex)
+						{
+							that->_logger->log(LogLevel::Warn, "analytics", "Failed to push analytics", ex.what());
+						}
+					}
+				}, false);
+				_pushTask->start();
 			}
 
 			void tryPushAnalytics()
+			{
+				std::lock_guard<std::mutex> sendLock(_sendMutex);
+				auto scene = _wScene.lock();
+				// A failed send is handled like a disconnection: documents are kept for later.
+				if ((!scene || !sendDocuments(scene)) && !_spoolPath.empty())
+				{
+					spoolBufferedDocuments();
+				}
+			}
+
+			// Requires _sendMutex
+			// Returns false if a send failed. The documents not sent are kept in the spool file or back in the buffer.
+			bool sendDocuments(std::shared_ptr<Scene> scene)
+			{
+				auto service = scene->dependencyResolver().resolve<details::AnalyticsService>();
+				if (!_spoolPath.empty() && !sendSpooledDocuments(service))
+				{
+					return false;
+				}
+
+				std::vector<AnalyticsDocument> batch;
+				while (takeBatch(batch))
+				{
+					try
+					{
+						service->pushAnalyticDocuments(batch);
+					}
+					catch (const std::exception& ex)
+					{
+						_logger->log(LogLevel::Warn, "analytics", "Failed to send analytics documents, retrying later", ex.what());
+						requeue(batch);
+						return false;
+					}
+					std::lock_guard<std::mutex> lg(_mutex);
+					_stats.sent += batch.size();
+					_stats.batchesSent++;
+				}
+				return true;
+			}
+
+			// Puts documents that could not be sent back at the front of the buffer.
+			void requeue(std::vector<AnalyticsDocument>& batch)
 			{
 				std::lock_guard<std::mutex> lg(_mutex);
+				_documents.insert(_documents.begin(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+				while (_documents.size() > _maxBufferedDocuments)
+				{
+					_stats.dropped++;
+					if (_dropPolicy == AnalyticsDropPolicy::DropNewest)
+					{
+						_documents.pop_back();
+					}
+					else
+					{
+						_documents.pop_front();
+					}
+				}
+			}
 
-				auto scene = _wScene.lock();
-				if (scene)
+			// Moves up to _maxBatchBytes of documents from the buffer into batch. Returns false if the buffer was empty.
+			bool takeBatch(std::vector<AnalyticsDocument>& batch)
+			{
+				batch.clear();
+				std::size_t size = 0;
+				std::lock_guard<std::mutex> lg(_mutex);
+				while (!_documents.empty())
 				{
-					auto service = scene->dependencyResolver().resolve<details::AnalyticsService>();
-					service->pushAnalyticDocuments(_documents);
-					_documents.clear();
+					auto documentSize = estimateSize(_documents.front());
+					if (!batch.empty() && size + documentSize > _maxBatchBytes)
+					{
+						break;
+					}
+					size += documentSize;
+					batch.push_back(std::move(_documents.front()));
+					_documents.pop_front();
 				}
-				
+				return !batch.empty();
 			}
-			void scheduleTryPushAnalytics()
+
+			// Spool file format: a sequence of [uint32 little endian length][msgpack std::vector<AnalyticsDocument>] records.
+			// Requires _sendMutex
+			void spoolBufferedDocuments()
 			{
-				if (!_cts.get_token().is_canceled())
+				std::size_t spoolSize = 0;
 				{
-					auto now = std::chrono::system_clock::now();
-					using namespace std::chrono_literals;
-					if (_lastRun + 1s < now)
+					std::ifstream in(_spoolPath, std::ios::binary | std::ios::ate);
+					if (in)
 					{
-						_lastRun = now;
-						tryPushAnalytics();
+						spoolSize = static_cast<std::size_t>(in.tellg());
 					}
-					
+				}
 
-					if (auto actionDispatcher = _wActionDispatcher.lock())
+				std::ofstream out(_spoolPath, std::ios::binary | std::ios::app);
+				if (!out)
+				{
+					_logger->log(LogLevel::Warn, "analytics", "Could not open the analytics spool file", _spoolPath);
+					return;
+				}
+
+				std::vector<AnalyticsDocument> batch;
+				while (takeBatch(batch))
+				{
+					obytestream stream;
+					_serializer.serialize(stream, batch);
+					auto bytes = stream.bytes();
+					if (spoolSize + bytes.size() + 4 > _spoolMaxBytes)
 					{
-						auto wSteamImpl = STORM_WEAK_FROM_THIS();
-						actionDispatcher->post([wSteamImpl]()
-						{
-							if (auto steamImpl = wSteamImpl.lock())
-							{
-								steamImpl->scheduleTryPushAnalytics(); // recursive call.
-							}
-						});
+						std::lock_guard<std::mutex> lg(_mutex);
+						_stats.dropped += batch.size();
+						continue;
+					}
+
+					uint32 length = static_cast<uint32>(bytes.size());
+					char header[4] = { (char)(length & 0xff), (char)((length >> 8) & 0xff), (char)((length >> 16) & 0xff), (char)((length >> 24) & 0xff) };
+					out.write(header, 4);
+					out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+					spoolSize += bytes.size() + 4;
+
+					std::lock_guard<std::mutex> lg(_mutex);
+					_stats.spooled += batch.size();
+				}
+			}
+
+			// Requires _sendMutex
+			// Returns false if a send failed. The records not sent stay in the spool file.
+			bool sendSpooledDocuments(std::shared_ptr<details::AnalyticsService> service)
+			{
+				std::vector<char> content;
+				{
+					std::ifstream in(_spoolPath, std::ios::binary);
+					if (!in)
+					{
+						return true;
+					}
+					content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+				}
+
+				std::size_t offset = 0;
+				bool sent = true;
+				while (offset + 4 <= content.size())
+				{
+					auto header = content.data() + offset;
+					uint32 length = (uint32)(uint8)header[0] | ((uint32)(uint8)header[1] << 8) | ((uint32)(uint8)header[2] << 16) | ((uint32)(uint8)header[3] << 24);
+					if (content.size() - offset - 4 < length)
+					{
+						_logger->log(LogLevel::Warn, "analytics", "Truncated analytics spool file", _spoolPath);
+						offset = content.size();
+						break;
 					}
+
+					std::vector<AnalyticsDocument> batch;
+					try
+					{
+						ibytestream stream(reinterpret_cast<byte*>(content.data() + offset + 4), length);
+						batch = _serializer.deserializeOne<std::vector<AnalyticsDocument>>(stream);
+					}
+					catch (const std::exception& ex)
+					{
+						_logger->log(LogLevel::Warn, "analytics", "Invalid record in the analytics spool file", ex.what());
+						offset += 4 + length;
+						continue;
+					}
+
+					try
+					{
+						service->pushAnalyticDocuments(batch);
+					}
+					catch (const std::exception& ex)
+					{
+						_logger->log(LogLevel::Warn, "analytics", "Failed to send spooled analytics documents, retrying later", ex.what());
+						sent = false;
+						break;
+					}
+
+					offset += 4 + length;
+					std::lock_guard<std::mutex> lg(_mutex);
+					_stats.sent += batch.size();
+					_stats.batchesSent++;
+				}
+
+				if (offset >= content.size())
+				{
+					std::remove(_spoolPath.c_str());
 				}
+				else if (offset > 0)
+				{
+					// Keep only the records not sent.
+					std::ofstream out(_spoolPath, std::ios::binary | std::ios::trunc);
+					out.write(content.data() + offset, content.size() - offset);
+				}
+				return sent;
 			}
 
 			void OnAnalyticsSceneConnected(std::shared_ptr<Scene> scene)
@@ -180,12 +540,24 @@ namespace Stormancer
 			}
 			
 			std::weak_ptr<Scene> _wScene;
-			std::weak_ptr<IActionDispatcher> _wActionDispatcher;
-			pplx::cancellation_token_source _cts;
-			std::vector<AnalyticsDocument> _documents;
-			std::chrono::system_clock::time_point _lastRun = std::chrono::system_clock::time_point::min();
-			
+			std::shared_ptr<ILogger> _logger;
+			Serializer _serializer;
+			std::weak_ptr<PeriodicTaskScheduler> _wScheduler;
+			std::shared_ptr<PeriodicTask> _pushTask;
+
+			std::deque<AnalyticsDocument> _documents;
+			std::size_t _maxBufferedDocuments = 10000;
+			AnalyticsDropPolicy _dropPolicy = AnalyticsDropPolicy::DropOldest;
+			std::chrono::milliseconds _flushInterval;
+			std::size_t _maxBatchBytes = 65536;
+			std::string _spoolPath;
+			std::size_t _spoolMaxBytes = 4 * 1024 * 1024;
+			AnalyticsStats _stats;
+
+			// Protects _documents and _stats.
 			std::mutex _mutex;
+			// Serializes flushes, so that spooled and buffered documents are sent in order.
+			std::mutex _sendMutex;
 		};
 
 		class AnalyticsPlugin : public Stormancer::IPlugin
@@ -218,7 +590,7 @@ namespace Stormancer
 			}
 			void registerClientDependencies(Stormancer::ContainerBuilder& builder) override
 			{
-				builder.registerDependency<Stormancer::Analytics::AnalyticsApi, IActionDispatcher>().as<Stormancer::Analytics::AnalyticsApi>().singleInstance();
+				builder.registerDependency<Stormancer::Analytics::AnalyticsApi, Configuration, ILogger, PeriodicTaskScheduler>().as<Stormancer::Analytics::AnalyticsApi>().singleInstance();
 			}
 
 			void clientCreated(std::shared_ptr<IClient> client) override
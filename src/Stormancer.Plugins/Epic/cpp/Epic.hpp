@@ -462,87 +462,40 @@ namespace Stormancer
 			{
 			public:
 
-				EpicTicker(std::shared_ptr<Configuration> config, std::shared_ptr<EpicState> epicState, std::shared_ptr<ILogger> logger)
-					: _wActionDispatcher(config->actionDispatcher)
+				EpicTicker(std::shared_ptr<EpicState> epicState, std::shared_ptr<ILogger> logger, std::shared_ptr<PeriodicTaskScheduler> scheduler)
 				{
-					_platformHandle = epicState->getPlatformHandle();
-					if (_platformHandle == nullptr)
+					auto platformHandle = epicState->getPlatformHandle();
+					if (platformHandle == nullptr)
 					{
 						logger->log(LogLevel::Warn, "EpicTicker", "Epic platform handle is null");
+						return;
 					}
+
+					_task = scheduler->createTask("epic.tick", std::chrono::milliseconds(16), [platformHandle]()
+					{
+						EOS_Platform_Tick(platformHandle);
+					});
 				}
 
 				void start()
 				{
-					_stopTicker = false;
-
-					if (_stoppedTicker)
+					if (_task)
 					{
-						_stoppedTicker = false;
-
-						if (auto actionDispatcher = _wActionDispatcher.lock())
-						{
-							auto wEpicTicker = STORM_WEAK_FROM_THIS();
-							actionDispatcher->post([wEpicTicker]()
-							{
-								if (auto epicTicker = wEpicTicker.lock())
-								{
-									epicTicker->scheduleTick();
-								}
-							});
-						}
+						_task->start();
 					}
 				}
 
 				void stop()
 				{
-					_stopTicker = true;
-				}
-
-			private:
-
-				void scheduleTick()
-				{
-					if (! _stopTicker && _platformHandle)
-					{
-						EOS_Platform_Tick(_platformHandle);
-					}
-					else
-					{
-						_stoppedTicker = true;
-						return;
-					}
-
-					if (auto actionDispatcher = _wActionDispatcher.lock())
+					if (_task)
 					{
-						auto wEpicTicker = STORM_WEAK_FROM_THIS();
-						actionDispatcher->post([wEpicTicker]()
-						{
-							if (auto epicTicker = wEpicTicker.lock())
-							{
-								if (epicTicker->_stopTicker)
-								{
-									epicTicker->_stoppedTicker = true;
-								}
-								else
-								{
-									epicTicker->scheduleTick();
-								}
-							}
-						});
-					}
-					else
-					{
-						_stoppedTicker = true;
+						_task->stop();
 					}
 				}
 
-				std::weak_ptr<IActionDispatcher> _wActionDispatcher;
-
-				EOS_HPlatform _platformHandle = nullptr;
+			private:
 
-				bool _stopTicker = false;
-				bool _stoppedTicker = true;
+				std::shared_ptr<PeriodicTask> _task;
 			};
 
 			class EpicService : public std::enable_shared_from_this<EpicService>
@@ -1284,7 +1237,7 @@ namespace Stormancer
 			void registerClientDependencies(ContainerBuilder& builder) override
 			{
 				builder.registerDependency<details::EpicState, Configuration, ILogger>().singleInstance();
-				builder.registerDependency<details::EpicTicker, Configuration, details::EpicState, ILogger>().asSelf().singleInstance();
+				builder.registerDependency<details::EpicTicker, details::EpicState, ILogger, PeriodicTaskScheduler>().asSelf().singleInstance();
 				builder.registerDependency<details::EpicEventsManager, IClient, details::EpicState, ILogger>().asSelf().singleInstance();
 				builder.registerDependency<details::EpicApi, Users::UsersApi, details::EpicState, Configuration, IScheduler, ILogger, Party::PartyApi>().asSelf().as<IEpicApi>();
 				builder.registerDependency<details::EpicPartyProvider, Party::Platform::InvitationMessenger, Users::UsersApi, details::EpicState, details::EpicApi, ILogger, Party::PartyApi, IActionDispatcher>().as<Party::Platform::IPlatformSupportProvider>();
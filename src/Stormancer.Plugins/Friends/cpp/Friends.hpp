@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Users/ClientAPI.hpp"
+#include "Users/ConfigurationParameters.hpp"
 #include "Users/Users.hpp"
 #include "stormancer/StormancerTypes.h"
+#include "stormancer/Configuration.h"
+#include "stormancer/IActionDispatcher.h"
 #include "stormancer/msgpack_define.h"
 #include "stormancer/Event.h"
 #include "stormancer/Tasks.h"
@@ -10,6 +13,10 @@
 #include "stormancer/Scene.h"
 #include "stormancer/Utilities/PointerUtilities.h"
 #include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <vector>
@@ -44,6 +51,18 @@ namespace Stormancer
 			Away = 2
 		};
 
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the Friends plugin behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Interval in milliseconds during which friend list changes are merged before firing the batched friend list event.
+			/// Default is "0": one batched event is fired per notification packet received from the server.
+			/// </summary>
+			constexpr const char* BatchedEventsDebounceMs = "friends.batchedEvents.debounceMs";
+		}
+
 		struct Friend
 		{
 			std::vector<Stormancer::Users::UserId> userIds;
@@ -124,6 +143,17 @@ namespace Stormancer
 			std::shared_ptr<Friend> value;
 		};
 
+		/// <summary>
+		/// Represents a set of friend list changes delivered at once.
+		/// </summary>
+		/// <remarks>
+		/// Contains at most one entry per friend, reflecting its latest state.
+		/// </remarks>
+		struct FriendListBatchUpdatedEvent
+		{
+			std::vector<FriendListUpdatedEvent> updates;
+		};
+
 		/// <summary>
 		/// Abstract class representing the contract for friends event handlers
 		/// </summary>
@@ -232,10 +262,31 @@ namespace Stormancer
 			/// <summary>
 			/// Event fired whenever the friend list content changes.
 			/// </summary>
+			/// <remarks>
+			/// The event is raised once per notification packet. The callback is called for each of its changes.
+			/// </remarks>
 			/// <param name="callback">Callback called when the event is fired.</param>
 			/// <returns>An object that controls the lifetime of the event subscription. If all copies of this object are destroyed, the callback is automatically unregistered.</returns>
 			virtual Event<FriendListUpdatedEvent>::Subscription subscribeFriendListUpdatedEvent(std::function<void(FriendListUpdatedEvent)> callback) = 0;
 
+			/// <summary>
+			/// Event fired with all the friend list changes of a notification packet, or of a debounce interval if ConfigurationKeys::BatchedEventsDebounceMs is set.
+			/// </summary>
+			/// <remarks>
+			/// Prefer this event over subscribeFriendListUpdatedEvent to rebuild a friend list UI only once when many friends change at the same time.
+			/// </remarks>
+			/// <param name="callback">Callback called when the event is fired.</param>
+			/// <returns>An object that controls the lifetime of the event subscription. If all copies of this object are destroyed, the callback is automatically unregistered.</returns>
+			virtual Event<FriendListBatchUpdatedEvent>::Subscription subscribeFriendListBatchUpdatedEvent(std::function<void(FriendListBatchUpdatedEvent)> callback) = 0;
+
+			/// <summary>
+			/// Event fired whenever a single friend is added, updated or removed.
+			/// </summary>
+			/// <param name="userId">Any of the user ids of the friend.</param>
+			/// <param name="callback">Callback called when the event is fired.</param>
+			/// <returns>An object that controls the lifetime of the event subscription. If all copies of this object are destroyed, the callback is automatically unregistered.</returns>
+			virtual Event<FriendListUpdatedEvent>::Subscription subscribeFriendUpdatedEvent(const Stormancer::Users::UserId& userId, std::function<void(FriendListUpdatedEvent)> callback) = 0;
+
 			/// <summary>
 			/// Ask the friend list for a full refresh. This should be called only in platform events when users are added or removed from the user friend list.
 			/// </summary>
@@ -250,6 +301,46 @@ namespace Stormancer
 
 		namespace details
 		{
+			/// <summary>
+			/// Accumulates friend list changes, keeping at most one entry per friend.
+			/// </summary>
+			struct FriendListDiff
+			{
+				std::vector<FriendListUpdatedEvent> events;
+				// Position of each modified friend in events.
+				std::unordered_map<const Friend*, std::size_t> positions;
+				std::unordered_set<const Friend*> added;
+				std::unordered_set<const Friend*> removed;
+
+				void record(FriendListUpdateOperation operation, const std::shared_ptr<Friend>& fr)
+				{
+					auto it = positions.find(fr.get());
+					if (it == positions.end())
+					{
+						positions.emplace(fr.get(), events.size());
+						events.push_back(FriendListUpdatedEvent{ operation, fr });
+					}
+					else if (operation == FriendListUpdateOperation::Remove && added.count(fr.get()))
+					{
+						// Never surfaced to listeners: drop the entry instead of reporting an add then a remove.
+						auto position = it->second;
+						events.erase(events.begin() + position);
+						positions.erase(it);
+						for (auto& p : positions)
+						{
+							if (p.second > position)
+							{
+								p.second--;
+							}
+						}
+					}
+					else
+					{
+						events[it->second].operation = operation;
+					}
+				}
+			};
+
 			class FriendsService : public std::enable_shared_from_this<FriendsService>
 			{
 			public:
@@ -263,7 +354,10 @@ namespace Stormancer
 				{
 				}
 
-				Event<FriendListUpdatedEvent> friendListChanged;
+				/// <summary>
+				/// Fired once per applied notification batch, with at most one entry per modified friend.
+				/// </summary>
+				Event<std::vector<FriendListUpdatedEvent>> friendListChanged;
 				std::vector<std::shared_ptr<Friend>> friends;
 
 				void initialize()
@@ -273,10 +367,7 @@ namespace Stormancer
 						{
 							if (auto friendsService = wFriendsService.lock())
 							{
-								for (auto friendUpdate : friendUpdates)
-								{
-									friendsService->onFriendNotification(friendUpdate);
-								}
+								friendsService->applyFriendNotifications(friendUpdates);
 								friendsService->_isLoaded = true;
 							}
 						});
@@ -318,20 +409,15 @@ namespace Stormancer
 					return false;
 				}
 
-				bool tryGet(const std::vector<std::shared_ptr<Friend>>& friendsList, const std::vector<Stormancer::Users::UserId> ids, std::shared_ptr<Friend>& item)
+				bool tryGet(const std::vector<Stormancer::Users::UserId>& ids, std::shared_ptr<Friend>& item) const
 				{
-					for (auto& i : friendsList)
+					for (auto& lookupUid : ids)
 					{
-						for (auto& uid : i->userIds)
+						auto it = _friendsIndex.find(lookupUid.toString());
+						if (it != _friendsIndex.end())
 						{
-							for (auto& lookupUid : ids)
-							{
-								if (uid == lookupUid)
-								{
-									item = i;
-									return true;
-								}
-							}
+							item = it->second;
+							return true;
 						}
 					}
 					return false;
@@ -374,6 +460,7 @@ namespace Stormancer
 				pplx::task<void> refresh()
 				{
 					friends.clear();
+					_friendsIndex.clear();
 					_eventHandlerSubscriptions.clear();
 					return _rpcService->rpc<void>("Friends.RefreshSubscription").then([wFriendsService = weak_from_this()]()
 						{
@@ -418,18 +505,47 @@ namespace Stormancer
 						});
 				}
 
-				void onFriendNotification(const FriendListUpdateDto& update)
+				/// <summary>
+				/// Applies a batch of notifications as a single diff, then fires friendListChanged once.
+				/// </summary>
+				/// <remarks>
+				/// A friend modified several times in the batch appears only once in the event, with its latest state.
+				/// Friends added then removed in the same batch are not reported.
+				/// </remarks>
+				void applyFriendNotifications(const std::vector<FriendListUpdateDto>& updates)
+				{
+					FriendListDiff diff;
+					for (auto& update : updates)
+					{
+						onFriendNotification(update, diff);
+					}
+
+					if (!diff.removed.empty())
+					{
+						friends.erase(std::remove_if(friends.begin(), friends.end(), [&diff](const std::shared_ptr<Friend>& fr)
+							{
+								return diff.removed.count(fr.get()) > 0;
+							}), friends.end());
+					}
+
+					if (!diff.events.empty())
+					{
+						friendListChanged(diff.events);
+					}
+				}
+
+				void onFriendNotification(const FriendListUpdateDto& update, FriendListDiff& diff)
 				{
 					switch (update.operation)
 					{
 					case FriendListUpdateOperationInternal::Remove:
-						onFriendRemove(update);
+						onFriendRemove(update, diff);
 						break;
 					case FriendListUpdateOperationInternal::AddOrUpdate:
-						onFriendAddOrUpdate(update);
+						onFriendAddOrUpdate(update, diff);
 						break;
 					case FriendListUpdateOperationInternal::UpdateStatus:
-						onFriendUpdateStatus(update);
+						onFriendUpdateStatus(update, diff);
 						break;
 					default:
 						_logger->log(LogLevel::Error, "friends", "Unknown friends operation: " + std::to_string((int)update.operation));
@@ -437,62 +553,68 @@ namespace Stormancer
 					}
 				}
 
-				void onFriendAddOrUpdate(const FriendListUpdateDto& update)
+				void onFriendAddOrUpdate(const FriendListUpdateDto& update, FriendListDiff& diff)
 				{
-
 					std::shared_ptr<Friend> fr;
-					if (tryGet(friends, update.data.userIds, fr))
+					if (tryGet(update.data.userIds, fr))
 					{
-						if (fr)
-						{
-							fr->status = update.data.status;
-							fr->tags = update.data.tags;
-							fr->userIds = update.data.userIds;
-							fr->customData = update.data.customData;
-							friendListChanged(FriendListUpdatedEvent{ FriendListUpdateOperation::AddOrUpdate, fr });
-						}
+						unindexFriend(fr);
+						fr->status = update.data.status;
+						fr->tags = update.data.tags;
+						fr->userIds = update.data.userIds;
+						fr->customData = update.data.customData;
+						indexFriend(fr);
+						diff.record(FriendListUpdateOperation::AddOrUpdate, fr);
 					}
 					else
 					{
 						fr = std::make_shared<Friend>(update.data);
 						friends.push_back(fr);
-						friendListChanged(FriendListUpdatedEvent{ FriendListUpdateOperation::AddOrUpdate, fr });
+						indexFriend(fr);
+						diff.added.insert(fr.get());
+						diff.record(FriendListUpdateOperation::AddOrUpdate, fr);
 					}
 				}
 
-				void onFriendUpdateStatus(const FriendListUpdateDto& update)
+				void onFriendUpdateStatus(const FriendListUpdateDto& update, FriendListDiff& diff)
 				{
 					std::shared_ptr<Friend> fr;
-					if (tryGet(friends, update.data.userIds, fr))
+					if (tryGet(update.data.userIds, fr))
 					{
-						if (fr)
-						{
-							fr->status = update.data.status;
-							friendListChanged(FriendListUpdatedEvent{ FriendListUpdateOperation::AddOrUpdate, fr });
-						}
+						fr->status = update.data.status;
+						diff.record(FriendListUpdateOperation::AddOrUpdate, fr);
 					}
 				}
 
-				void onFriendRemove(const FriendListUpdateDto& update)
+				void onFriendRemove(const FriendListUpdateDto& update, FriendListDiff& diff)
 				{
+					std::shared_ptr<Friend> fr;
+					if (tryGet(update.data.userIds, fr))
+					{
+						unindexFriend(fr);
+						diff.removed.insert(fr.get());
+						diff.record(FriendListUpdateOperation::Remove, fr);
+					}
+				}
+
+				void indexFriend(const std::shared_ptr<Friend>& fr)
+				{
+					for (auto& uid : fr->userIds)
+					{
+						_friendsIndex[uid.toString()] = fr;
+					}
+				}
 
-					for (auto it = friends.begin(); it != friends.end(); it++)
+				void unindexFriend(const std::shared_ptr<Friend>& fr)
+				{
+					for (auto& uid : fr->userIds)
 					{
-						for (auto& uid : update.data.userIds)
+						auto it = _friendsIndex.find(uid.toString());
+						if (it != _friendsIndex.end() && it->second == fr)
 						{
-							auto fr = *it;
-							for (auto& uid2 : fr->userIds)
-							{
-								if (uid == uid2)
-								{
-									friends.erase(it);
-									friendListChanged(FriendListUpdatedEvent{ FriendListUpdateOperation::Remove, fr });
-									return;
-								}
-							}
+							_friendsIndex.erase(it);
 						}
 					}
-
 				}
 
 				void subscribeFriendsChangedForAllEventHandlers()
@@ -515,6 +637,8 @@ namespace Stormancer
 				std::shared_ptr<Serializer> _serializer;
 				std::vector<std::shared_ptr<IFriendsEventHandler>> _friendsEventHandlers;
 				std::vector<Subscription> _eventHandlerSubscriptions;
+				// userId.toString() -> friend, for every user id of every friend in the list.
+				std::unordered_map<std::string, std::shared_ptr<Friend>> _friendsIndex;
 				bool _isLoaded = false;
 			};
 
@@ -522,10 +646,12 @@ namespace Stormancer
 			{
 			public:
 
-				Friends_Impl(std::weak_ptr<Users::UsersApi> users, std::shared_ptr<ILogger> logger)
+				Friends_Impl(std::weak_ptr<Users::UsersApi> users, std::shared_ptr<ILogger> logger, std::shared_ptr<Configuration> config, std::shared_ptr<IActionDispatcher> dispatcher)
 					: ClientAPI(users, "stormancer.friends")
 					, _logger(logger)
+					, _dispatcher(dispatcher)
 				{
+					_batchDebounce = readConfigurationParameter(config, ConfigurationKeys::BatchedEventsDebounceMs, _batchDebounce);
 				}
 
 				FriendsResult friends() override
@@ -598,7 +724,48 @@ namespace Stormancer
 
 				Subscription subscribeFriendListUpdatedEvent(std::function<void(FriendListUpdatedEvent)> callback) override
 				{
-					return friendListChanged.subscribe(callback);
+					// The event is raised once per notification packet, the per-change callback of existing callers is called for each of its changes.
+					return friendListChanged.subscribe([callback](FriendListBatchUpdatedEvent batch)
+						{
+							for (auto& update : batch.updates)
+							{
+								callback(update);
+							}
+						});
+				}
+
+				Event<FriendListBatchUpdatedEvent>::Subscription subscribeFriendListBatchUpdatedEvent(std::function<void(FriendListBatchUpdatedEvent)> callback) override
+				{
+					if (_batchDebounce.count() == 0)
+					{
+						// Without debouncing, the batch of a notification packet is the one already carried by friendListChanged.
+						return friendListChanged.subscribe(callback);
+					}
+					return friendListBatchChanged.subscribe(callback);
+				}
+
+				Event<FriendListUpdatedEvent>::Subscription subscribeFriendUpdatedEvent(const Stormancer::Users::UserId& userId, std::function<void(FriendListUpdatedEvent)> callback) override
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					// Drop the events of the friends nobody follows anymore, so that the map only grows with live subscriptions.
+					for (auto it = _friendChangedEvents.begin(); it != _friendChangedEvents.end();)
+					{
+						if (it->second->hasSubscribers())
+						{
+							++it;
+						}
+						else
+						{
+							it = _friendChangedEvents.erase(it);
+						}
+					}
+
+					auto& ev = _friendChangedEvents[userId.toString()];
+					if (!ev)
+					{
+						ev = std::make_shared<Event<FriendListUpdatedEvent>>();
+					}
+					return ev->subscribe(callback);
 				}
 
 				pplx::task<void> block(const Stormancer::Users::UserId& userIdToBlock, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
@@ -616,16 +783,100 @@ namespace Stormancer
 					return getFriendService().then([ct](std::shared_ptr<FriendsService> s) { return s->getBlockedList(ct); });
 				}
 
-				Event<FriendListUpdatedEvent> friendListChanged;
+				/// <summary>
+				/// Raised once per notification packet, with all its changes.
+				/// </summary>
+				Event<FriendListBatchUpdatedEvent> friendListChanged;
+
+				/// <summary>
+				/// Raised once per debounce interval if ConfigurationKeys::BatchedEventsDebounceMs is set. It is never raised without debouncing.
+				/// </summary>
+				Event<FriendListBatchUpdatedEvent> friendListBatchChanged;
 
 			private:
 
+				void onFriendListChanged(const std::vector<FriendListUpdatedEvent>& events)
+				{
+					std::vector<std::shared_ptr<Event<FriendListUpdatedEvent>>> friendEvents;
+					bool scheduleFlush = false;
+					{
+						std::lock_guard<std::mutex> lg(_mutex);
+						for (auto& ev : events)
+						{
+							std::shared_ptr<Event<FriendListUpdatedEvent>> friendEvent;
+							for (auto& uid : ev.value->userIds)
+							{
+								auto it = _friendChangedEvents.find(uid.toString());
+								if (it != _friendChangedEvents.end())
+								{
+									if (!it->second->hasSubscribers())
+									{
+										// All the subscriptions to this friend were destroyed.
+										_friendChangedEvents.erase(it);
+										continue;
+									}
+									friendEvent = it->second;
+									break;
+								}
+							}
+							friendEvents.push_back(friendEvent);
+						}
+
+						if (_batchDebounce.count() > 0)
+						{
+							for (auto& ev : events)
+							{
+								_pendingBatch.record(ev.operation, ev.value);
+							}
+							scheduleFlush = !_flushScheduled;
+							_flushScheduled = true;
+						}
+					}
+
+					friendListChanged(FriendListBatchUpdatedEvent{ events });
+					for (std::size_t i = 0; i < events.size(); i++)
+					{
+						if (friendEvents[i])
+						{
+							(*friendEvents[i])(events[i]);
+						}
+					}
+
+					if (scheduleFlush)
+					{
+						auto wThat = this->weak_from_this();
+						taskDelay(_batchDebounce).then([wThat]()
+							{
+								if (auto that = wThat.lock())
+								{
+									that->flushPendingBatch();
+								}
+							}, pplx::task_options(_dispatcher));
+					}
+				}
+
+				void flushPendingBatch()
+				{
+					FriendListBatchUpdatedEvent batch;
+					{
+						std::lock_guard<std::mutex> lg(_mutex);
+						batch.updates = std::move(_pendingBatch.events);
+						_pendingBatch = FriendListDiff();
+						_flushScheduled = false;
+					}
+
+					if (!batch.updates.empty())
+					{
+						friendListBatchChanged(batch);
+					}
+				}
+
 				pplx::task<std::shared_ptr<FriendsService>> getFriendService()
 				{
 					auto initializer = [](auto that, auto friends, auto /*scene*/)
 						{
 							auto wThat = that->weak_from_this();
-							that->_friendListChangedSubscription = friends->friendListChanged.subscribe([wThat](FriendListUpdatedEvent ev)
+							that->_friendListChangedSubscription = friends->friendListChanged.subscribe([wThat](std::vector<FriendListUpdatedEvent> events)
 								{
 									auto that = wThat.lock();
 									if (!that)
@@ -633,7 +884,7 @@ namespace Stormancer
 										throw ObjectDeletedException("Friends");
 									}
 
-									that->friendListChanged(ev);
+									that->onFriendListChanged(events);
 								});
 						};
 
@@ -661,9 +912,17 @@ namespace Stormancer
 					return result;
 				}
 
-				Event<FriendListUpdatedEvent>::Subscription _friendListChangedSubscription;
+				Event<std::vector<FriendListUpdatedEvent>>::Subscription _friendListChangedSubscription;
 
 				std::shared_ptr<ILogger> _logger;
+				std::shared_ptr<IActionDispatcher> _dispatcher;
+				std::chrono::milliseconds _batchDebounce = std::chrono::milliseconds(0);
+
+				std::mutex _mutex;
+				// Per-friend events, keyed by userId.toString().
+				std::unordered_map<std::string, std::shared_ptr<Event<FriendListUpdatedEvent>>> _friendChangedEvents;
+				FriendListDiff _pendingBatch;
+				bool _flushScheduled = false;
 			};
 
 		}
@@ -685,7 +944,7 @@ namespace Stormancer
 
 			void registerClientDependencies(ContainerBuilder& builder) override
 			{
-				builder.registerDependency<details::Friends_Impl, Users::UsersApi, ILogger>().as<FriendsApi>().singleInstance();
+				builder.registerDependency<details::Friends_Impl, Users::UsersApi, ILogger, Configuration, IActionDispatcher>().as<FriendsApi>().singleInstance();
 			}
 
 			void registerSceneDependencies(ContainerBuilder& builder, std::shared_ptr<Scene> scene) override
@@ -184,74 +184,27 @@ namespace Stormancer
 		{
 		public:
 
-			GalaxyTicker(std::shared_ptr<Configuration> config, std::shared_ptr<GalaxyState> galaxyState, std::shared_ptr<ILogger> logger)
-				: _wActionDispatcher(config->actionDispatcher)
-				, _logger(logger)
+			GalaxyTicker(std::shared_ptr<PeriodicTaskScheduler> scheduler)
+				: _task(scheduler->createTask("galaxy.processData", std::chrono::milliseconds(16), []()
+				{
+					galaxy::api::ProcessData();
+				}))
 			{
 			}
 
 			void start()
 			{
-				_stopTicker = false;
-
-				if (_stoppedTicker)
-				{
-					_stoppedTicker = false;
-
-					if (auto actionDispatcher = _wActionDispatcher.lock())
-					{
-						auto wGalaxyTicker = STORM_WEAK_FROM_THIS();
-						actionDispatcher->post([wGalaxyTicker]()
-						{
-							if (auto galaxyTicker = wGalaxyTicker.lock())
-							{
-								galaxyTicker->scheduleTick();
-							}
-						});
-					}
-				}
+				_task->start();
 			}
 
 			void stop()
 			{
-				_stopTicker = true;
+				_task->stop();
 			}
 
 		private:
 
-			void scheduleTick()
-			{
-				galaxy::api::ProcessData();
-
-				if (auto actionDispatcher = _wActionDispatcher.lock())
-				{
-					auto wGalaxyTicker = STORM_WEAK_FROM_THIS();
-					actionDispatcher->post([wGalaxyTicker]()
-					{
-						if (auto galaxyTicker = wGalaxyTicker.lock())
-						{
-							if (galaxyTicker->_stopTicker)
-							{
-								galaxyTicker->_stoppedTicker = true;
-							}
-							else
-							{
-								galaxyTicker->scheduleTick();
-							}
-						}
-					});
-				}
-				else
-				{
-					_stoppedTicker = true;
-				}
-			}
-
-			std::weak_ptr<IActionDispatcher> _wActionDispatcher;
-			std::shared_ptr<ILogger> _logger;
-
-			bool _stopTicker = false;
-			bool _stoppedTicker = true;
+			std::shared_ptr<PeriodicTask> _task;
 		};
 
 		class GalaxyService : public std::enable_shared_from_this<GalaxyService>
@@ -520,21 +473,18 @@ namespace Stormancer
 				auto galaxyApi = client->dependencyResolver().resolve<IGalaxyApi>();
 				galaxyApi->initialize();
 
-				auto galaxyState = client->dependencyResolver().resolve<GalaxyState>();
-				auto config = client->dependencyResolver().resolve<Configuration>();
-				auto logger = client->dependencyResolver().resolve<ILogger>();
-				_galaxyTicker = std::make_shared<GalaxyTicker>(config, galaxyState, logger);
+				_galaxyTicker = std::make_shared<GalaxyTicker>(client->dependencyResolver().resolve<PeriodicTaskScheduler>());
 				_galaxyTicker->start();
 			}
 
 			void clientDisconnecting(std::shared_ptr<IClient> client) override
 			{
+				_galaxyTicker->stop();
 				auto galaxyState = client->dependencyResolver().resolve<GalaxyState>();
 				if (galaxyState->getStormancerInitializedPlatform())
 				{
 					galaxy::api::Shutdown();
 				}
-				_galaxyTicker->stop();
 			}
 
 			void registerSceneDependencies(ContainerBuilder& builder, std::shared_ptr<Scene> scene) override
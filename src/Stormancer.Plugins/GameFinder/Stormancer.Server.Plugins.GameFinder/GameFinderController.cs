@@ -43,14 +43,17 @@ namespace Stormancer.Server.Plugins.GameFinder
         public const string FindGameS2SRoute = "gamefinder.findgame";
 
         private readonly IGameFinderService _gameFinderService;
+        private readonly GameFinderMetricsPublisher _metricsPublisher;
 
         /// <summary>
         /// Constructor
         /// </summary>
         /// <param name="gameFinderService"></param>
-        public GameFinderController(IGameFinderService gameFinderService)
+        /// <param name="metricsPublisher"></param>
+        public GameFinderController(IGameFinderService gameFinderService, GameFinderMetricsPublisher metricsPublisher)
         {
             _gameFinderService = gameFinderService;
+            _metricsPublisher = metricsPublisher;
         }
 
         /// <summary>
@@ -107,6 +110,69 @@ namespace Stormancer.Server.Plugins.GameFinder
         }
     
 
+        /// <summary>
+        /// Gets the latest public metrics of the gamefinder.
+        /// </summary>
+        /// <returns></returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "gamefinder.getmetrics")]
+        public Dictionary<string, int> GetMetrics()
+        {
+            return _metricsPublisher.GetSnapshot().Values;
+        }
+
+        /// <summary>
+        /// Subscribes the calling peer to the public metrics of the gamefinder.
+        /// </summary>
+        /// <remarks>
+        /// Changes are pushed on the route <c>gamefinder.metrics.update</c> until the peer unsubscribes or disconnects.
+        /// </remarks>
+        /// <param name="request"></param>
+        /// <returns>The latest metrics.</returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "gamefinder.metrics.subscribe")]
+        public GameFinderMetricsUpdate SubscribeMetrics(RequestContext<IScenePeerClient> request)
+        {
+            return _metricsPublisher.Subscribe(request.RemotePeer.SessionId);
+        }
+
+        /// <summary>
+        /// Unsubscribes the calling peer from the public metrics of the gamefinder.
+        /// </summary>
+        /// <param name="request"></param>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "gamefinder.metrics.unsubscribe")]
+        public void UnsubscribeMetrics(RequestContext<IScenePeerClient> request)
+        {
+            _metricsPublisher.Unsubscribe(request.RemotePeer.SessionId);
+        }
+
+        /// <summary>
+        /// Starts a game search ticket for the calling player.
+        /// </summary>
+        /// <param name="ticketId">Id of the ticket, unique among the tickets of the player.</param>
+        /// <param name="customData"></param>
+        /// <param name="request"></param>
+        /// <returns>A task that completes when the ticket ends. Status updates are sent on the route <c>gamefinder.ticket.update</c>.</returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "gamefinder.tickets.find")]
+        public async Task FindGameTicket(string ticketId, string? customData, RequestContext<IScenePeerClient> request)
+        {
+            var result = await _gameFinderService.FindGameTicket(ticketId, customData, request.RemotePeer, request.CancellationToken);
+            if (!result.Success)
+            {
+                throw new ClientException(result.ErrorMsg);
+            }
+        }
+
+        /// <summary>
+        /// Cancels a game search ticket of the calling player.
+        /// </summary>
+        /// <param name="ticketId"></param>
+        /// <param name="request"></param>
+        /// <returns>True once the ticket has been removed from the gamefinder, false if it was not running.</returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "gamefinder.tickets.cancel")]
+        public Task<bool> CancelTicket(string ticketId, RequestContext<IScenePeerClient> request)
+        {
+            return _gameFinderService.CancelTicket(request.RemotePeer, ticketId);
+        }
+
         /// <summary>
         /// Cancels matchmaking
         /// </summary>
@@ -124,7 +190,11 @@ namespace Stormancer.Server.Plugins.GameFinder
         /// </summary>
         /// <param name="args"></param>
         /// <returns></returns>
-        protected override Task OnDisconnected(DisconnectedArgs args) => _gameFinderService.CancelGame(args.Peer, false);
+        protected override Task OnDisconnected(DisconnectedArgs args)
+        {
+            _metricsPublisher.Unsubscribe(args.Peer.SessionId);
+            return _gameFinderService.CancelGame(args.Peer, false);
+        }
 
      
         string IServiceMetadataProvider.GetServiceInstanceId(ISceneHost scene)
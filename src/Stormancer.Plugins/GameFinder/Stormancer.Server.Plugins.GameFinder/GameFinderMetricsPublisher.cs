@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+using MessagePack;
+using Stormancer.Core;
+using Stormancer.Plugins;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace Stormancer.Server.Plugins.GameFinder
+{
+    /// <summary>
+    /// Public metrics of a gamefinder, sent to clients.
+    /// </summary>
+    [MessagePackObject]
+    public class GameFinderMetricsUpdate
+    {
+        /// <summary>
+        /// True if <see cref="Values"/> contains all the metrics, false if it only contains the metrics that changed since the previous update.
+        /// </summary>
+        [Key(0)]
+        public bool IsFull { get; set; }
+
+        /// <summary>
+        /// Metrics values.
+        /// </summary>
+        [Key(1)]
+        public Dictionary<string, int> Values { get; set; } = new Dictionary<string, int>();
+
+        /// <summary>
+        /// Metrics removed since the previous update.
+        /// </summary>
+        [Key(2)]
+        public List<string> Removed { get; set; } = new List<string>();
+
+        /// <summary>
+        /// Date the metrics were computed, in milliseconds since the unix epoch.
+        /// </summary>
+        [Key(3)]
+        public long Timestamp { get; set; }
+
+        /// <summary>
+        /// Interval between two computations of the metrics, in milliseconds.
+        /// </summary>
+        [Key(4)]
+        public int IntervalMs { get; set; }
+    }
+
+    /// <summary>
+    /// Keeps the latest public metrics of the gamefinder, and pushes the changes to the clients subscribed to them.
+    /// </summary>
+    /// <remarks>
+    /// Metrics are computed by the gamefinder pass at most once per <see cref="PushInterval"/>, whatever the number of subscribers.
+    /// Nothing is sent when the metrics didn't change.
+    /// </remarks>
+    public class GameFinderMetricsPublisher
+    {
+        /// <summary>
+        /// Route used to push metrics updates to clients.
+        /// </summary>
+        public const string METRICS_UPDATE_ROUTE = "gamefinder.metrics.update";
+
+        private readonly object _syncRoot = new object();
+        private readonly HashSet<SessionId> _subscribers = new HashSet<SessionId>();
+        private readonly ISceneHost _scene;
+        private readonly ISerializer _serializer;
+
+        private Dictionary<string, int> _metrics = new Dictionary<string, int>();
+        private DateTime _lastUpdate = DateTime.MinValue;
+
+        /// <summary>
+        /// Constructor
+        /// </summary>
+        /// <param name="scene"></param>
+        /// <param name="serializer"></param>
+        public GameFinderMetricsPublisher(ISceneHost scene, ISerializer serializer)
+        {
+            _scene = scene;
+            _serializer = serializer;
+        }
+
+        /// <summary>
+        /// Minimum interval between two computations of the metrics.
+        /// </summary>
+        public TimeSpan PushInterval { get; set; } = TimeSpan.FromSeconds(5);
+
+        /// <summary>
+        /// Gets a value indicating whether the metrics should be computed again.
+        /// </summary>
+        public bool IsUpdateDue
+        {
+            get
+            {
+                lock (_syncRoot)
+                {
+                    return DateTime.UtcNow - _lastUpdate >= PushInterval;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the latest metrics.
+        /// </summary>
+        /// <returns></returns>
+        public GameFinderMetricsUpdate GetSnapshot()
+        {
+            lock (_syncRoot)
+            {
+                return CreateSnapshot();
+            }
+        }
+
+        /// <summary>
+        /// Subscribes a peer to metrics updates.
+        /// </summary>
+        /// <param name="sessionId"></param>
+        /// <returns>The latest metrics. Updates are pushed from there.</returns>
+        public GameFinderMetricsUpdate Subscribe(SessionId sessionId)
+        {
+            lock (_syncRoot)
+            {
+                _subscribers.Add(sessionId);
+                return CreateSnapshot();
+            }
+        }
+
+        /// <summary>
+        /// Unsubscribes a peer from metrics updates.
+        /// </summary>
+        /// <param name="sessionId"></param>
+        public void Unsubscribe(SessionId sessionId)
+        {
+            lock (_syncRoot)
+            {
+                _subscribers.Remove(sessionId);
+            }
+        }
+
+        /// <summary>
+        /// Updates the metrics, and pushes the changes to the subscribers.
+        /// </summary>
+        /// <param name="metrics"></param>
+        /// <returns></returns>
+        public Task Publish(Dictionary<string, int> metrics)
+        {
+            GameFinderMetricsUpdate update;
+            SessionId[] subscribers;
+            lock (_syncRoot)
+            {
+                _lastUpdate = DateTime.UtcNow;
+                update = new GameFinderMetricsUpdate
+                {
+                    IsFull = false,
+                    Values = metrics.Where(kvp => !_metrics.TryGetValue(kvp.Key, out var value) || value != kvp.Value).ToDictionary(kvp => kvp.Key, kvp => kvp.Value),
+                    Removed = _metrics.Keys.Where(key => !metrics.ContainsKey(key)).ToList(),
+                    Timestamp = new DateTimeOffset(_lastUpdate).ToUnixTimeMilliseconds(),
+                    IntervalMs = (int)PushInterval.TotalMilliseconds
+                };
+                _metrics = new Dictionary<string, int>(metrics);
+                subscribers = _subscribers.ToArray();
+            }
+
+            if (subscribers.Length == 0 || (update.Values.Count == 0 && update.Removed.Count == 0))
+            {
+                return Task.CompletedTask;
+            }
+
+            return _scene.Send(new MatchArrayFilter(subscribers), METRICS_UPDATE_ROUTE, s => _serializer.Serialize(update, s), PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE_ORDERED);
+        }
+
+        // Requires _syncRoot
+        private GameFinderMetricsUpdate CreateSnapshot()
+        {
+            return new GameFinderMetricsUpdate
+            {
+                IsFull = true,
+                Values = new Dictionary<string, int>(_metrics),
+                Timestamp = _lastUpdate == DateTime.MinValue ? 0 : new DateTimeOffset(_lastUpdate).ToUnixTimeMilliseconds(),
+                IntervalMs = (int)PushInterval.TotalMilliseconds
+            };
+        }
+    }
+}
@@ -106,6 +106,7 @@ namespace Stormancer.Server.Plugins.GameFinder
             {
                 //The game finder service must be registered at the scene level to prevent it from being instantiated on each scene including non game finder when IConfigurationChangedEventHandler is resolved.
                 builder.Register<GameFinderService>().As<IGameFinderService>().As<IConfigurationChangedEventHandler>().InstancePerScene();
+                builder.Register<GameFinderMetricsPublisher>().AsSelf().InstancePerScene();
                 if (Configs.TryGetValue(scene.Id, out var config))
                 {
                     
@@ -76,6 +76,24 @@ namespace Stormancer.Server.Plugins.GameFinder
             FailedClients.Add((party, reason));
         }
 
+        /// <summary>
+        /// Progress of the parties set by the algorithm during this pass.
+        /// </summary>
+        public Dictionary<Party, GameFinderProgress> Progress { get; } = new Dictionary<Party, GameFinderProgress>();
+
+        /// <summary>
+        /// Sets the progress of a party, sent to its players in status updates.
+        /// </summary>
+        /// <remarks>
+        /// Fields left to null are filled with the estimates of the gamefinder.
+        /// </remarks>
+        /// <param name="party"></param>
+        /// <param name="progress"></param>
+        public void SetProgress(Party party, GameFinderProgress progress)
+        {
+            Progress[party] = progress;
+        }
+
         /// <summary>
         /// Game Sessions that are open to new players.
         /// </summary>
@@ -136,18 +154,31 @@ namespace Stormancer.Server.Plugins.GameFinder
     internal class GameFinderService : IGameFinderService, IConfigurationChangedEventHandler
     {
         private const string UPDATE_NOTIFICATION_ROUTE = "gamefinder.update";
+        private const string UPDATE_TICKET_NOTIFICATION_ROUTE = "gamefinder.ticket.update";
+        private const string STATUS_ROUTE = "gamefinder.status";
         private const string UPDATE_READYCHECK_ROUTE = "gamefinder.ready.update";
         private const string UPDATE_FINDGAME_REQUEST_PARAMS_ROUTE = "gamefinder.parameters.update";
         private const string LOG_CATEGORY = "GameFinderService";
 
         public const long ProtocolVersion = 2020_01_10_1;
 
+        // First client protocol version receiving binary status updates on STATUS_ROUTE.
+        private const long TypedStatusProtocolVersion = 2026_10_18_2;
+
         private ISceneHost _scene;
         private readonly IAnalyticsService _analytics;
         private readonly ILogger _logger;
         private readonly IConfiguration _configuration;
         private readonly ISerializer _serializer;
         private readonly GameFinderData _data;
+        private readonly GameFinderMetricsPublisher _metricsPublisher;
+
+        // Monotonic clock of the status updates.
+        private readonly Stopwatch _clock = Stopwatch.StartNew();
+        private readonly object _searchTimeLock = new object();
+        // Moving average of the duration of successful searches, 0 if unknown.
+        private double _averageSearchTimeMs;
+        private TimeSpan _progressInterval;
 
         // GameFinder Configuration
         public bool IsRunning { get => _data.IsRunning; private set => _data.IsRunning = value; }
@@ -158,13 +189,15 @@ namespace Stormancer.Server.Plugins.GameFinder
             ILogger logger,
             IConfiguration configuration,
             ISerializer serializer,
-            GameFinderData data)
+            GameFinderData data,
+            GameFinderMetricsPublisher metricsPublisher)
         {
             _analytics = analytics;
             _logger = logger;
             _configuration = configuration;
             _serializer = serializer;
             _data = data;
+            _metricsPublisher = metricsPublisher;
             _scene = scene;
             _data.kind = _scene.TemplateMetadata[GameFinderPlugin.METADATA_KEY];
             env.ActiveDeploymentChanged += Env_ActiveDeploymentChanged;
@@ -196,9 +229,63 @@ namespace Stormancer.Server.Plugins.GameFinder
             _data.interval = TimeSpan.FromSeconds((double)(specificConfig?.interval ?? 1));
             _data.isReadyCheckEnabled = (bool?)specificConfig?.readyCheck?.enabled ?? false;
             _data.readyCheckTimeout = (int)(specificConfig?.readyCheck?.timeout ?? 1000);
+            _metricsPublisher.PushInterval = TimeSpan.FromSeconds((double)(specificConfig?.metrics?.pushInterval ?? 5));
+            _progressInterval = TimeSpan.FromSeconds((double)(specificConfig?.statusUpdateInterval ?? 5));
+        }
+
+        public Task<FindGameResult> FindGame(Party party, CancellationToken ct)
+        {
+            return FindGame(party, null, ct);
         }
 
-        public async Task<FindGameResult> FindGame(Party party, CancellationToken ct)
+        public async Task<FindGameResult> FindGameTicket(string ticketId, string? customData, IScenePeerClient peer, CancellationToken ct)
+        {
+            if (string.IsNullOrEmpty(ticketId))
+            {
+                return new FindGameResult { Success = false, ErrorMsg = "gamefinder.ticket.invalidId" };
+            }
+
+            Session? session = null;
+            await using (var scope = _scene.CreateRequestScope())
+            {
+                var sessions = scope.Resolve<IUserSessions>();
+                session = await sessions.GetSession(peer, ct);
+            }
+
+            if (session?.User == null)
+            {
+                return new FindGameResult { Success = false, ErrorMsg = "notAuthenticated" };
+            }
+
+            // Tickets only search for the calling player. A party search already includes the player with the other members.
+            if (_data.peersToGroup.ContainsKey(session.SessionId))
+            {
+                return new FindGameResult { Success = false, ErrorMsg = "gamefinder.ticket.partySearchRunning" };
+            }
+
+            var party = new Party() { Players = new Dictionary<string, Player>() };
+            party.Players.Add(session.User.Id, new Player(session.SessionId, session.User.Id));
+            party.PartyId = $"{session.SessionId}#{ticketId}";
+            party.PartyLeaderId = session.User.Id;
+            party.CustomData = customData;
+
+            var tickets = _data.ticketsBySession.GetOrAdd(session.SessionId, _ => new ConcurrentDictionary<string, Party>());
+            if (!tickets.TryAdd(ticketId, party))
+            {
+                return new FindGameResult { Success = false, ErrorMsg = "gamefinder.ticket.alreadyExists" };
+            }
+
+            try
+            {
+                return await FindGame(party, ticketId, ct);
+            }
+            finally
+            {
+                tickets.TryRemove(ticketId, out _);
+            }
+        }
+
+        private async Task<FindGameResult> FindGame(Party party, string? ticketId, CancellationToken ct)
         {
             try
             {
@@ -223,7 +310,7 @@ namespace Stormancer.Server.Plugins.GameFinder
                         return new PlayerPeer { SessionId = player.Value.SessionId, Player = player.Value };
                     }).ToArray();
                 }
-                var state = new GameFinderRequestState(party);
+                var state = new GameFinderRequestState(party) { TicketId = ticketId, StartTimeMs = _clock.ElapsedMilliseconds };
 
                 try
                 {
@@ -241,9 +328,12 @@ namespace Stormancer.Server.Plugins.GameFinder
                     //}
 
                     _data.waitingParties[party] = state;
-                    foreach (var p in peersInGroup)
+                    if (ticketId == null)
                     {
-                        _data.peersToGroup[p.SessionId] = party;
+                        foreach (var p in peersInGroup)
+                        {
+                            _data.peersToGroup[p.SessionId] = party;
+                        }
                     }
 
                     using var registration = ct.Register(() =>
@@ -259,11 +349,7 @@ namespace Stormancer.Server.Plugins.GameFinder
                     //    memStream.Seek(0, System.IO.SeekOrigin.Begin);
                     //    memStream.CopyTo(s);
                     //});
-                    await BroadcastToPlayers(party, UPDATE_NOTIFICATION_ROUTE, (s, sz) =>
-                    {
-                        s.WriteByte((byte)GameFinderStatusUpdate.SearchStart);
-
-                    }, ct);
+                    await BroadcastStatus(party, GameFinderStatusUpdate.SearchStart, ct);
                     state.State = RequestState.Ready;
                 }
                 catch (Exception ex)
@@ -271,19 +357,20 @@ namespace Stormancer.Server.Plugins.GameFinder
                     state.Tcs.SetException(ex);
                     _logger.Log(LogLevel.Error, "gamefinder", $"Matchmaking failed : {ex}", ex);
                     _analytics.Push("gameFinder", "end", JObject.FromObject(new { partySize = party.Players.Count, duration = (DateTime.UtcNow - startTime).TotalMilliseconds, type = "failed" }));
-                    await BroadcastToPlayers(party, UPDATE_NOTIFICATION_ROUTE, (s, sz) => s.WriteByte((byte)GameFinderStatusUpdate.Failed), ct);
+                    await BroadcastStatus(party, GameFinderStatusUpdate.Failed, ct);
                 }
 
                 try
                 {
                     await state.Tcs.Task;
                     _analytics.Push("gameFinder", "end", JObject.FromObject(new { partySize = party.Players.Count, duration = (DateTime.UtcNow - startTime).TotalMilliseconds, type = "success" }));
+                    UpdateSearchTimeEstimate(DateTime.UtcNow - startTime);
 
                 }
                 catch (TaskCanceledException)
                 {
                     _analytics.Push("gameFinder", "end", JObject.FromObject(new { partySize = party.Players.Count , duration = (DateTime.UtcNow - startTime).TotalMilliseconds, type = "cancelled" }));
-                    await BroadcastToPlayers(party, UPDATE_NOTIFICATION_ROUTE, (s, sz) => s.WriteByte((byte)GameFinderStatusUpdate.Cancelled), CancellationToken.None);
+                    await BroadcastStatus(party, GameFinderStatusUpdate.Cancelled, CancellationToken.None);
                 }
                 catch (Exception ex)
                 {
@@ -291,11 +378,14 @@ namespace Stormancer.Server.Plugins.GameFinder
                 }
                 finally //Always remove party from list.
                 {
-                    foreach (var p in peersInGroup)
+                    if (ticketId == null)
                     {
-                        if (p?.SessionId != null)
+                        foreach (var p in peersInGroup)
                         {
-                            _data.peersToGroup.TryRemove(p.SessionId, out _);
+                            if (p?.SessionId != null)
+                            {
+                                _data.peersToGroup.TryRemove(p.SessionId, out _);
+                            }
                         }
                     }
 
@@ -310,6 +400,7 @@ namespace Stormancer.Server.Plugins.GameFinder
                             }
                         }
                     }
+                    state.Completed.TrySetResult(null);
                 }
                return new FindGameResult { Success = true };
             }
@@ -357,7 +448,11 @@ namespace Stormancer.Server.Plugins.GameFinder
 
         private async Task FindGamesOnce(CancellationToken cancellationToken)
         {
-            var waitingParties = _data.waitingParties.Where(kvp => kvp.Value.State == RequestState.Ready).ToDictionary(kvp => kvp.Key, kvp => kvp.Value);
+            // A player can only be in one game candidate at a time: the other searches of players who already have one wait for its outcome.
+            var busySessions = _data.waitingParties.Where(kvp => kvp.Value.State == RequestState.Found).SelectMany(kvp => kvp.Key.Players.Values).Select(p => p.SessionId).ToHashSet();
+            var waitingParties = _data.waitingParties
+                .Where(kvp => kvp.Value.State == RequestState.Ready && !kvp.Key.Players.Values.Any(p => busySessions.Contains(p.SessionId)))
+                .ToDictionary(kvp => kvp.Key, kvp => kvp.Value);
             try
             {
                 await using (var scope = _scene.CreateRequestScope())
@@ -391,6 +486,19 @@ namespace Stormancer.Server.Plugins.GameFinder
                         return;
                     }
 
+                    foreach (var (party, progress) in mmCtx.Progress)
+                    {
+                        if (waitingParties.TryGetValue(party, out var state))
+                        {
+                            state.Progress = progress;
+                        }
+                    }
+
+                    if (_metricsPublisher.IsUpdateDue)
+                    {
+                        await PublishMetrics(gameFinder);
+                    }
+
                     _analytics.Push("gameFinder", "pass", JObject.FromObject(new
                     {
                         type = _data.kind,
@@ -410,6 +518,11 @@ namespace Stormancer.Server.Plugins.GameFinder
                         games.Games.RemoveAll(m => m.AllParties().Contains(party));
                     }
 
+                    // Several searches of the same player may have been matched during this pass: keep the first game.
+                    var claimedSessions = new HashSet<SessionId>();
+                    games.Games.RemoveAll(game => !TryClaimPlayers(game, claimedSessions));
+                    games.GameSessionTickets.RemoveAll(ticket => !TryClaimPlayers(ticket, claimedSessions));
+
                     if (games.Games.Any() || games.GameSessionTickets.Any())
                     {
                         //_logger.Log(LogLevel.Debug, $"{LOG_CATEGORY}.FindGamesOnce", $"Prepare resolutions {waitingParties.Count} players for {matches.Matches.Count} matches.", new { waitingCount = waitingParties.Count });
@@ -467,6 +580,100 @@ namespace Stormancer.Server.Plugins.GameFinder
                     value.Party.PastPasses++;
                 }
             }
+
+            if (!cancellationToken.IsCancellationRequested)
+            {
+                await PublishProgress();
+            }
+        }
+
+        // Sends the progress of the searches to the clients supporting binary status updates, at most once per interval per search.
+        private async Task PublishProgress()
+        {
+            if (_progressInterval <= TimeSpan.Zero)
+            {
+                return;
+            }
+
+            try
+            {
+                var now = _clock.ElapsedMilliseconds;
+                var tasks = new List<Task>();
+                var position = 0;
+                foreach (var state in _data.waitingParties.Values.Where(s => s.State == RequestState.Ready).OrderBy(s => s.StartTimeMs))
+                {
+                    position++;
+                    if (now - state.LastProgressSentMs < _progressInterval.TotalMilliseconds)
+                    {
+                        continue;
+                    }
+
+                    var progress = new GameFinderProgress
+                    {
+                        EstimatedWait = state.Progress?.EstimatedWait ?? EstimateWait(now - state.StartTimeMs),
+                        QueuePosition = state.Progress?.QueuePosition ?? position,
+                        CriteriaLevel = state.Progress?.CriteriaLevel
+                    };
+                    if (progress == state.LastProgress)
+                    {
+                        continue;
+                    }
+
+                    state.LastProgress = progress;
+                    state.LastProgressSentMs = now;
+                    tasks.Add(SendStatus(state.Party, GameFinderStatusUpdate.SearchStart, null, true, true));
+                }
+                await Task.WhenAll(tasks);
+            }
+            catch (Exception ex)
+            {
+                _logger.Log(LogLevel.Error, LOG_CATEGORY, "An error occurred while sending the progress of the searches.", ex);
+            }
+        }
+
+        private void UpdateSearchTimeEstimate(TimeSpan duration)
+        {
+            lock (_searchTimeLock)
+            {
+                _averageSearchTimeMs = _averageSearchTimeMs == 0 ? duration.TotalMilliseconds : _averageSearchTimeMs * 0.9 + duration.TotalMilliseconds * 0.1;
+            }
+        }
+
+        private TimeSpan? EstimateWait(long searchTimeMs)
+        {
+            double average;
+            lock (_searchTimeLock)
+            {
+                average = _averageSearchTimeMs;
+            }
+            if (average == 0)
+            {
+                return null;
+            }
+            // Rounded to the second, so that the estimate doesn't change at each pass.
+            return TimeSpan.FromSeconds(Math.Round(Math.Max(0, average - searchTimeMs) / 1000));
+        }
+
+        private async Task PublishMetrics(IGameFinderAlgorithm gameFinder)
+        {
+            try
+            {
+                var metrics = new Dictionary<string, int>
+                {
+                    ["waitingParties"] = _data.waitingParties.Count,
+                    ["waitingPlayers"] = _data.waitingParties.Keys.Sum(party => party.Players.Count)
+                };
+                foreach (var metric in gameFinder.GetMetrics())
+                {
+                    metrics[metric.Key] = metric.Value;
+                }
+
+                await _metricsPublisher.Publish(metrics);
+            }
+            catch (Exception ex)
+            {
+                _logger.Log(LogLevel.Error, LOG_CATEGORY, "An error occurred while publishing the gamefinder metrics.", ex);
+            }
         }
 
         private async Task ResolveGameFound(IGameCandidate gameCandidate, Dictionary<Party, GameFinderRequestState> waitingParties, IGameFinderResolver resolver, CancellationToken cancellationToken)
@@ -506,10 +713,7 @@ namespace Stormancer.Server.Plugins.GameFinder
 
                 if (_data.isReadyCheckEnabled)
                 {
-                    await BroadcastToPlayers(gameCandidate, UPDATE_NOTIFICATION_ROUTE, (s, sz) =>
-                    {
-                        s.WriteByte((byte)GameFinderStatusUpdate.WaitingPlayersReady);
-                    }, cancellationToken);
+                    await BroadcastStatus(gameCandidate, GameFinderStatusUpdate.WaitingPlayersReady, cancellationToken);
 
                     using (var gameReadyCheckState = CreateReadyCheck(gameCandidate))
                     {
@@ -536,10 +740,7 @@ namespace Stormancer.Server.Plugins.GameFinder
                                 if (_data.waitingParties.TryGetValue(party, out var mrs))
                                 {
                                     mrs.State = RequestState.Ready;
-                                    await BroadcastToPlayers(party, UPDATE_NOTIFICATION_ROUTE, (s, sz) =>
-                                    {
-                                        s.WriteByte((byte)GameFinderStatusUpdate.SearchStart);
-                                    }, cancellationToken);
+                                    await BroadcastStatus(party, GameFinderStatusUpdate.SearchStart, cancellationToken);
                                 }
                             }
                             return; //stop here
@@ -547,7 +748,9 @@ namespace Stormancer.Server.Plugins.GameFinder
                     }
                 }
 
-                foreach (var player in GetPlayers(gameCandidate.AllParties(), cancellationToken))
+                await CancelOtherSearches(gameCandidate);
+
+                foreach (var (player, state) in gameCandidate.AllParties().SelectMany(party => GetPlayers(party, cancellationToken).Select(player => (player, GetState(party)))))
                 {
                     try
                     {
@@ -575,22 +778,17 @@ namespace Stormancer.Server.Plugins.GameFinder
                             {
                                 await resolutionAction(writerContext);
                             }
-                            await _scene.Send(new MatchPeerFilter(player), UPDATE_NOTIFICATION_ROUTE, s =>
+                            await SendStatus(player, state, GameFinderStatusUpdate.Success, s =>
                             {
-                                s.WriteByte((byte)GameFinderStatusUpdate.Success);
                                 stream.Seek(0, SeekOrigin.Begin);
                                 stream.CopyTo(s);
-                            }
-                            , PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
+                            }, false);
                         }
                     }
                     catch (Exception ex)
                     {
                         _logger.Log(LogLevel.Error, "gamefinder", "An error occured while trying to resolve a game for a player", ex);
-                        await _scene.Send(new MatchPeerFilter(player), UPDATE_NOTIFICATION_ROUTE, s =>
-                        {
-                            s.WriteByte((byte)GameFinderStatusUpdate.Failed);
-                        }, PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
+                        await SendStatus(player, state, GameFinderStatusUpdate.Failed, null, false);
                     }
                 }
 
@@ -611,7 +809,7 @@ namespace Stormancer.Server.Plugins.GameFinder
             }
             catch (Exception)
             {
-                await BroadcastToPlayers(gameCandidate, UPDATE_NOTIFICATION_ROUTE, (s, sz) => s.WriteByte((byte)GameFinderStatusUpdate.Failed), cancellationToken);
+                await BroadcastStatus(gameCandidate, GameFinderStatusUpdate.Failed, cancellationToken);
                 throw;
             }
         }
@@ -634,15 +832,12 @@ namespace Stormancer.Server.Plugins.GameFinder
 
         private GameReadyCheck? GetReadyCheck(IScenePeerClient peer)
         {
-            if (_data.peersToGroup.TryGetValue(peer.SessionId, out var g))
+            foreach (var party in GetSearches(peer.SessionId))
             {
-                var gameFinderRq = _data.waitingParties[g];
-                var gameCandidate = _data.waitingParties[g].Candidate;
-                if (gameCandidate == null)
+                if (_data.waitingParties.TryGetValue(party, out var gameFinderRq) && gameFinderRq.Candidate != null)
                 {
-                    return null;
+                    return GetReadyCheck(gameFinderRq.Candidate.Id);
                 }
-                return GetReadyCheck(gameCandidate.Id);
             }
             return null;
         }
@@ -692,23 +887,58 @@ namespace Stormancer.Server.Plugins.GameFinder
 
         public async Task CancelGame(IScenePeerClient peer, bool requestedByPlayer)
         {
+            var tasks = new List<Task>();
+            if (_data.ticketsBySession.TryGetValue(peer.SessionId, out var tickets))
+            {
+                foreach (var ticket in tickets.Values)
+                {
+                    tasks.Add(Cancel(ticket, requestedByPlayer));
+                }
+                if (!requestedByPlayer)
+                {
+                    _data.ticketsBySession.TryRemove(peer.SessionId, out _);
+                }
+            }
 
             if (!_data.peersToGroup.TryGetValue(peer.SessionId, out var party))
             {
-                await _scene.Send(new MatchPeerFilter(peer), UPDATE_NOTIFICATION_ROUTE, s => s.WriteByte((byte)GameFinderStatusUpdate.Cancelled), PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
-
+                if (tasks.Count == 0)
+                {
+                    await SendStatus(peer.SessionId, null, GameFinderStatusUpdate.Cancelled, null, false);
+                }
             }
             else
             {
+                tasks.Add(Cancel(party, requestedByPlayer));
+            }
 
-                await Cancel(party, requestedByPlayer);
+            await Task.WhenAll(tasks);
+        }
+
+        public async Task<bool> CancelTicket(IScenePeerClient peer, string ticketId)
+        {
+            if (!_data.ticketsBySession.TryGetValue(peer.SessionId, out var tickets) ||
+                !tickets.TryGetValue(ticketId, out var party) ||
+                !_data.waitingParties.TryGetValue(party, out var state))
+            {
+                return false;
             }
+
+            // Without a ready check, a ticket with a game candidate is already being resolved.
+            if (state.State == RequestState.Found && !_data.isReadyCheckEnabled)
+            {
+                return false;
+            }
+
+            await Cancel(party, SearchEndReason.Canceled);
+            await state.Completed.Task;
+            return true;
         }
 
         public async Task CancelAll()
         {
             var tasks = new List<Task>();
-            foreach (var party in _data.peersToGroup.Values.ToArray())
+            foreach (var party in _data.peersToGroup.Values.Concat(_data.ticketsBySession.Values.SelectMany(tickets => tickets.Values)).Distinct().ToArray())
             {
                 tasks.Add(Cancel(party, false));
             }
@@ -716,6 +946,11 @@ namespace Stormancer.Server.Plugins.GameFinder
         }
 
         public Task Cancel(Party party, bool requestedByPlayer)
+        {
+            return Cancel(party, requestedByPlayer ? SearchEndReason.Canceled : SearchEndReason.Disconnected);
+        }
+
+        private Task Cancel(Party party, SearchEndReason reason)
         {
 
             if (!_data.waitingParties.TryGetValue(party, out var mmrs))
@@ -729,10 +964,61 @@ namespace Stormancer.Server.Plugins.GameFinder
             sectx.GameFinderId = this._scene.Id;
             sectx.Party = party;
             sectx.PassesCount = party.PastPasses;
-            sectx.Reason = requestedByPlayer ? SearchEndReason.Canceled : SearchEndReason.Disconnected;
+            sectx.Reason = reason;
             return RunEventHandlerInRequestScope<IGameFinderEventHandler>(_scene, h => h.OnEnd(sectx), ex => _logger.Log(LogLevel.Error, LOG_CATEGORY, "an error occured while running OnEnd event handler.", ex));
         }
 
+        /// <summary>
+        /// Cancels the other searches of the players of a game, and waits for their players to be notified.
+        /// </summary>
+        private async Task CancelOtherSearches(IGameCandidate game)
+        {
+            var parties = game.AllParties().ToHashSet();
+            var others = game.AllPlayers().SelectMany(p => GetSearches(p.SessionId)).Where(party => !parties.Contains(party)).Distinct().ToList();
+
+            var completions = new List<Task>();
+            foreach (var party in others)
+            {
+                if (_data.waitingParties.TryGetValue(party, out var state))
+                {
+                    await Cancel(party, SearchEndReason.MatchedElsewhere);
+                    completions.Add(state.Completed.Task);
+                }
+            }
+            await Task.WhenAll(completions);
+        }
+
+        private IEnumerable<Party> GetSearches(SessionId sessionId)
+        {
+            if (_data.peersToGroup.TryGetValue(sessionId, out var party))
+            {
+                yield return party;
+            }
+            if (_data.ticketsBySession.TryGetValue(sessionId, out var tickets))
+            {
+                foreach (var ticket in tickets.Values)
+                {
+                    yield return ticket;
+                }
+            }
+        }
+
+        private static bool TryClaimPlayers(IGameCandidate game, HashSet<SessionId> claimedSessions)
+        {
+            var sessions = game.AllPlayers().Select(p => p.SessionId).ToList();
+            if (sessions.Any(claimedSessions.Contains) || sessions.Distinct().Count() != sessions.Count)
+            {
+                return false;
+            }
+            claimedSessions.UnionWith(sessions);
+            return true;
+        }
+
+        private GameFinderRequestState? GetState(Party party)
+        {
+            return _data.waitingParties.TryGetValue(party, out var state) ? state : null;
+        }
+
         private SessionId GetPlayer(Player member)
         {
             return member.SessionId;
@@ -770,6 +1056,95 @@ namespace Stormancer.Server.Plugins.GameFinder
             
         }
 
+        private Task BroadcastStatus(IGameCandidate game, GameFinderStatusUpdate status, CancellationToken cancellationToken)
+        {
+            return BroadcastStatus(game.AllParties(), status, cancellationToken);
+        }
+
+        private Task BroadcastStatus(Party party, GameFinderStatusUpdate status, CancellationToken cancellationToken)
+        {
+            return BroadcastStatus(Enumerable.Repeat(party, 1), status, cancellationToken);
+        }
+
+        private Task BroadcastStatus(IEnumerable<Party> parties, GameFinderStatusUpdate status, CancellationToken cancellationToken)
+        {
+            return Task.WhenAll(parties.Select(party => SendStatus(party, status, null, false)));
+        }
+
+        // Status updates shared by the members of a party are multicast: one message to the clients supporting binary status updates, one to the others.
+        private Task SendStatus(Party party, GameFinderStatusUpdate status, Action<Stream>? payloadWriter, bool typedOnly, bool progressOnly = false)
+        {
+            var state = GetState(party);
+            var typedSessions = new List<SessionId>();
+            var legacySessions = new List<SessionId>();
+            foreach (var player in party.Players.Values)
+            {
+                if (_scene.TryGetPeer(player.SessionId, out var peer) && ClientSupportsTypedStatus(peer))
+                {
+                    typedSessions.Add(player.SessionId);
+                }
+                else if (!typedOnly)
+                {
+                    legacySessions.Add(player.SessionId);
+                }
+            }
+
+            return Task.WhenAll(
+                SendTypedStatus(typedSessions, state, status, payloadWriter, progressOnly),
+                SendLegacyStatus(legacySessions, state, status, payloadWriter));
+        }
+
+        // Clients supporting it receive binary status updates with timestamps and progress.
+        // Older clients are notified on the legacy routes: the ticket route for ticket searches, the update route otherwise.
+        private Task SendStatus(SessionId sessionId, GameFinderRequestState? state, GameFinderStatusUpdate status, Action<Stream>? payloadWriter, bool typedOnly)
+        {
+            if (_scene.TryGetPeer(sessionId, out var peer) && ClientSupportsTypedStatus(peer))
+            {
+                return SendTypedStatus(new List<SessionId> { sessionId }, state, status, payloadWriter, false);
+            }
+
+            if (typedOnly)
+            {
+                return Task.CompletedTask;
+            }
+
+            return SendLegacyStatus(new List<SessionId> { sessionId }, state, status, payloadWriter);
+        }
+
+        private Task SendTypedStatus(List<SessionId> sessionIds, GameFinderRequestState? state, GameFinderStatusUpdate status, Action<Stream>? payloadWriter, bool progressOnly)
+        {
+            if (sessionIds.Count == 0)
+            {
+                return Task.CompletedTask;
+            }
+
+            var now = _clock.ElapsedMilliseconds;
+            return _scene.Send(new MatchArrayFilter(sessionIds), STATUS_ROUTE, s =>
+            {
+                GameFinderStatusFrame.Write(s, status, now, state != null ? now - state.StartTimeMs : 0, state?.TicketId, status == GameFinderStatusUpdate.SearchStart ? state?.LastProgress : null, progressOnly);
+                payloadWriter?.Invoke(s);
+            }, PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
+        }
+
+        private Task SendLegacyStatus(List<SessionId> sessionIds, GameFinderRequestState? state, GameFinderStatusUpdate status, Action<Stream>? payloadWriter)
+        {
+            if (sessionIds.Count == 0)
+            {
+                return Task.CompletedTask;
+            }
+
+            var ticketId = state?.TicketId;
+            return _scene.Send(new MatchArrayFilter(sessionIds), ticketId == null ? UPDATE_NOTIFICATION_ROUTE : UPDATE_TICKET_NOTIFICATION_ROUTE, s =>
+            {
+                s.WriteByte((byte)status);
+                if (ticketId != null)
+                {
+                    _serializer.Serialize(ticketId, s);
+                }
+                payloadWriter?.Invoke(s);
+            }, PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
+        }
+
         public async Task<JObject> GetStatus(bool isAdmin)
         {
             await using (var scope = _scene.CreateRequestScope())
@@ -906,6 +1281,13 @@ namespace Stormancer.Server.Plugins.GameFinder
             }
         }
 
+        private static bool ClientSupportsTypedStatus(IScenePeerClient client)
+        {
+            return client.Metadata.TryGetValue(GameFinderPlugin.ProtocolVersionKey, out var versionString)
+                && long.TryParse(versionString, out long version)
+                && version >= TypedStatusProtocolVersion;
+        }
+
         private static bool ClientSupportsV3Token(IScenePeerClient client)
         {
             if (client.Metadata.TryGetValue(GameFinderPlugin.ProtocolVersionKey, out var versionString))
@@ -0,0 +1,112 @@
+// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+using System;
+using System.IO;
+using System.Text;
+
+namespace Stormancer.Server.Plugins.GameFinder
+{
+    /// <summary>
+    /// Binary encoding of the status updates sent on the route <c>gamefinder.status</c>.
+    /// </summary>
+    /// <remarks>
+    /// Layout:
+    /// byte version, byte status, byte flags,
+    /// varint server time (ms, monotonic since the gamefinder started), varint search time (ms since the search started),
+    /// then, if present in flags: varint length + UTF8 ticket id, varint estimated wait (ms), varint queue position, varint criteria level.
+    /// The payload of the status (connection token for Success, reason for Failed) follows, msgpack encoded as on <c>gamefinder.update</c>.
+    /// Varints are unsigned LEB128.
+    /// The <c>ProgressOnly</c> flag marks periodic progress updates, which don't change the status of the search.
+    /// </remarks>
+    internal static class GameFinderStatusFrame
+    {
+        public const byte Version = 1;
+
+        [Flags]
+        private enum Fields : byte
+        {
+            None = 0,
+            TicketId = 1,
+            EstimatedWait = 2,
+            QueuePosition = 4,
+            CriteriaLevel = 8,
+            ProgressOnly = 16
+        }
+
+        public static void Write(Stream stream, GameFinderStatusUpdate status, long serverTimeMs, long searchTimeMs, string? ticketId, GameFinderProgress? progress, bool progressOnly = false)
+        {
+            var fields = progressOnly ? Fields.ProgressOnly : Fields.None;
+            if (ticketId != null)
+            {
+                fields |= Fields.TicketId;
+            }
+            if (progress?.EstimatedWait != null)
+            {
+                fields |= Fields.EstimatedWait;
+            }
+            if (progress?.QueuePosition != null)
+            {
+                fields |= Fields.QueuePosition;
+            }
+            if (progress?.CriteriaLevel != null)
+            {
+                fields |= Fields.CriteriaLevel;
+            }
+
+            stream.WriteByte(Version);
+            stream.WriteByte((byte)status);
+            stream.WriteByte((byte)fields);
+            WriteVarint(stream, (ulong)Math.Max(0, serverTimeMs));
+            WriteVarint(stream, (ulong)Math.Max(0, searchTimeMs));
+
+            if (ticketId != null)
+            {
+                var bytes = Encoding.UTF8.GetBytes(ticketId);
+                WriteVarint(stream, (ulong)bytes.Length);
+                stream.Write(bytes, 0, bytes.Length);
+            }
+            if (progress?.EstimatedWait is TimeSpan estimatedWait)
+            {
+                WriteVarint(stream, (ulong)Math.Max(0, (long)estimatedWait.TotalMilliseconds));
+            }
+            if (progress?.QueuePosition is int queuePosition)
+            {
+                WriteVarint(stream, (ulong)Math.Max(0, queuePosition));
+            }
+            if (progress?.CriteriaLevel is int criteriaLevel)
+            {
+                WriteVarint(stream, (ulong)Math.Max(0, criteriaLevel));
+            }
+        }
+
+        private static void WriteVarint(Stream stream, ulong value)
+        {
+            while (value >= 0x80)
+            {
+                stream.WriteByte((byte)(value | 0x80));
+                value >>= 7;
+            }
+            stream.WriteByte((byte)value);
+        }
+    }
+}
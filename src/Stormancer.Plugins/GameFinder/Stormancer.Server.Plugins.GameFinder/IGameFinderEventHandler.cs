@@ -45,7 +45,12 @@ namespace Stormancer.Server.Plugins.GameFinder
         /// <summary>
         /// The search succeeded.
         /// </summary>
-        Succeeded = 2
+        Succeeded = 2,
+
+        /// <summary>
+        /// The search was cancelled because another search of one of its players succeeded.
+        /// </summary>
+        MatchedElsewhere = 3
     }
 
     /// <summary>
@@ -55,7 +55,22 @@ namespace Stormancer.Server.Plugins.GameFinder
         /// <param name="ct"></param>
         /// <returns></returns>
         Task<FindGameResult> FindGame(Party party, CancellationToken ct);
-      
+
+        /// <summary>
+        /// Starts a game search for a single player, identified by a ticket.
+        /// </summary>
+        /// <remarks>
+        /// A player can have several tickets running concurrently in the gamefinder, for instance with different custom data.
+        /// When a game is found for one of them, the other searches of the player are cancelled before the player is notified.
+        /// Tickets are solo searches: they fail with <c>gamefinder.ticket.partySearchRunning</c> while a party search of the player is running.
+        /// </remarks>
+        /// <param name="ticketId">Id of the ticket, chosen by the client. It must be unique among the tickets of the player.</param>
+        /// <param name="customData">Custom data of the search.</param>
+        /// <param name="peer">Peer of the player.</param>
+        /// <param name="ct"></param>
+        /// <returns></returns>
+        Task<FindGameResult> FindGameTicket(string ticketId, string? customData, IScenePeerClient peer, CancellationToken ct);
+
         /// <summary>
         /// Cancels a pending game search.
         /// </summary>
@@ -64,6 +79,14 @@ namespace Stormancer.Server.Plugins.GameFinder
         /// <returns></returns>
         Task CancelGame(IScenePeerClient peer, bool playerRequest);
 
+        /// <summary>
+        /// Cancels a search ticket of a player.
+        /// </summary>
+        /// <param name="peer"></param>
+        /// <param name="ticketId"></param>
+        /// <returns>True if the ticket was cancelled, false if it doesn't exist or has already ended.</returns>
+        Task<bool> CancelTicket(IScenePeerClient peer, string ticketId);
+
       
 
         /// <summary>
@@ -31,6 +31,9 @@ namespace Stormancer.Server.Plugins.GameFinder
         public ConcurrentDictionary<Party, GameFinderRequestState> waitingParties { get; } = new ConcurrentDictionary<Party, GameFinderRequestState>();
         public ConcurrentDictionary<SessionId, Party> peersToGroup { get; } = new ConcurrentDictionary<SessionId, Party>();
 
+        // Search tickets of each player, by ticket id.
+        public ConcurrentDictionary<SessionId, ConcurrentDictionary<string, Party>> ticketsBySession { get; } = new ConcurrentDictionary<SessionId, ConcurrentDictionary<string, Party>>();
+
         public ConcurrentDictionary<string, OpenGameSession> openGameSessions { get; } = new ConcurrentDictionary<string, OpenGameSession>();
 
         public bool IsRunning { get; set; }
@@ -0,0 +1,50 @@
+// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+using System;
+
+namespace Stormancer.Server.Plugins.GameFinder
+{
+    /// <summary>
+    /// Progress of a search, sent to the players of the party in status updates.
+    /// </summary>
+    /// <remarks>
+    /// Fields left to null are filled by the gamefinder with its own estimates when it can compute them.
+    /// </remarks>
+    public record GameFinderProgress
+    {
+        /// <summary>
+        /// Gets the estimated remaining time before a game is found.
+        /// </summary>
+        public TimeSpan? EstimatedWait { get; init; }
+
+        /// <summary>
+        /// Gets the position of the party in the queue, starting at 1.
+        /// </summary>
+        public int? QueuePosition { get; init; }
+
+        /// <summary>
+        /// Gets how many times the search criteria of the party were widened.
+        /// </summary>
+        public int? CriteriaLevel { get; init; }
+    }
+}
@@ -34,6 +34,33 @@ namespace Stormancer.Server.Plugins.GameFinder
 
         public TaskCompletionSource<object?> Tcs { get; } = new TaskCompletionSource<object?>();
 
+        /// <summary>
+        /// Completes when the request has been removed from the gamefinder and its players notified.
+        /// </summary>
+        public TaskCompletionSource<object?> Completed { get; } = new TaskCompletionSource<object?>(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        /// <summary>
+        /// Id of the ticket if the request was made by a player with the ticket API, null if it was made by a party.
+        /// </summary>
+        public string? TicketId { get; set; }
+
+        /// <summary>
+        /// Time the search started, on the monotonic clock of the gamefinder.
+        /// </summary>
+        public long StartTimeMs { get; set; }
+
+        /// <summary>
+        /// Progress set by the gamefinder algorithm during the last pass.
+        /// </summary>
+        public GameFinderProgress? Progress { get; set; }
+
+        /// <summary>
+        /// Last progress sent to the players.
+        /// </summary>
+        public GameFinderProgress? LastProgress { get; set; }
+
+        public long LastProgressSentMs { get; set; }
+
         public RequestState State { get; set; } = RequestState.NotStarted;
 
         public Party Party { get; }
@@ -7,7 +7,11 @@
 #include "stormancer/msgpack_define.h"
 #include "stormancer/Scene.h"
 #include "Users/Users.hpp"
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Stormancer
 {
@@ -40,6 +44,48 @@ namespace Stormancer
 			class GameFinderService;
 		}
 
+		/// <summary>
+		/// Timing and progress information attached to a status update by the server.
+		/// </summary>
+		/// <remarks>
+		/// Only sent by GameFinders supporting binary status updates. <c>available</c> is false otherwise.
+		/// </remarks>
+		struct GameFinderStatusDetails
+		{
+			bool available = false;
+
+			/// <summary>
+			/// Date the server sent the update, on a monotonic clock specific to the GameFinder.
+			/// Can be compared between updates of the same GameFinder to measure server side delays.
+			/// </summary>
+			std::chrono::milliseconds serverTime{ 0 };
+
+			/// <summary>
+			/// Time elapsed on the server since the search started.
+			/// </summary>
+			std::chrono::milliseconds searchTime{ 0 };
+
+			/// <summary>
+			/// Estimated time before a game is found. Negative if unknown.
+			/// </summary>
+			std::chrono::milliseconds estimatedWait{ -1 };
+
+			/// <summary>
+			/// Position of the search in the queue, starting at 1. -1 if unknown.
+			/// </summary>
+			int queuePosition = -1;
+
+			/// <summary>
+			/// Level of relaxation of the search criteria reported by the GameFinder algorithm. -1 if unknown.
+			/// </summary>
+			int criteriaLevel = -1;
+
+			/// <summary>
+			/// Local date the update was received.
+			/// </summary>
+			std::chrono::steady_clock::time_point receivedOn;
+		};
+
 		struct GameFinderResponse
 		{
 			friend class details::GameFinderService;
@@ -48,6 +94,11 @@ namespace Stormancer
 
 			std::string connectionToken;
 
+			/// <summary>
+			/// Details of the Success status update.
+			/// </summary>
+			GameFinderStatusDetails details;
+
 			template<typename TData>
 			TData readData()
 			{
@@ -71,18 +122,71 @@ namespace Stormancer
 		{
 			GameFinderStatus status;
 			std::string gameFinder;
+
+			/// <summary>
+			/// Id of the search ticket, empty if the search was not started with <c>submitTicket()</c>.
+			/// </summary>
+			std::string ticketId;
+
+			/// <summary>
+			/// Timing and progress sent by the server with the status.
+			/// </summary>
+			GameFinderStatusDetails details;
 		};
 
 		struct GameFoundEvent
 		{
 			std::string gameFinder;
 			GameFinderResponse data;
+
+			/// <summary>
+			/// Id of the search ticket that found the game, empty if the search was not started with <c>submitTicket()</c>.
+			/// </summary>
+			std::string ticketId;
 		};
 
 		struct FindGameFailedEvent
 		{
 			std::string reason;
 			std::string gameFinder;
+
+			/// <summary>
+			/// Id of the search ticket, empty if the search was not started with <c>submitTicket()</c>.
+			/// </summary>
+			std::string ticketId;
+		};
+
+		/// <summary>
+		/// Public metrics of a GameFinder, kept up to date by the server after a call to <c>subscribeMetrics()</c>.
+		/// </summary>
+		struct GameFinderMetrics
+		{
+			std::string gameFinder;
+			std::unordered_map<std::string, int> values;
+
+			/// <summary>
+			/// Date the server computed the metrics.
+			/// </summary>
+			std::chrono::system_clock::time_point serverTime;
+
+			/// <summary>
+			/// Local date of the last update received from the server.
+			/// </summary>
+			std::chrono::steady_clock::time_point lastUpdate;
+
+			/// <summary>
+			/// Interval between two computations of the metrics by the server.
+			/// </summary>
+			std::chrono::milliseconds interval{ 0 };
+		};
+
+		/// <summary>
+		/// A queue to search a game in with <c>findGameMultiQueue()</c>.
+		/// </summary>
+		struct GameFinderQueue
+		{
+			std::string gameFinder;
+			std::string customData;
 		};
 
 		/// <summary>
@@ -168,6 +272,19 @@ namespace Stormancer
 			/// When the reference count of this object drops to zero, the subscription will be canceled.</returns>
 			virtual Subscription subscribeGameFinderStateChanged(std::function<void(GameFinderStatusChangedEvent)> callback) = 0;
 
+			/// <summary>
+			/// Subscribe to progress updates of the running searches.
+			/// </summary>
+			/// <remarks>
+			/// GameFinders supporting binary status updates periodically send the progress of a search (estimated wait, queue position...)
+			/// while its status doesn't change. These updates are raised on this event only, not as status changes.
+			/// The <c>status</c> of the event is the current status of the search.
+			/// </remarks>
+			/// <param name="callback">Callable object to be called when the progress of a search is updated.</param>
+			/// <returns>A reference-counted <c>Subscription</c> object that tracks the lifetime of the subscription.
+			/// When the reference count of this object drops to zero, the subscription will be canceled.</returns>
+			virtual Subscription subscribeGameFinderProgressUpdated(std::function<void(GameFinderStatusChangedEvent)> callback) = 0;
+
 			/// <summary>
 			/// Subscribe to <c>GameFoundEvent</c> notifications.
 			/// </summary>
@@ -190,8 +307,90 @@ namespace Stormancer
 			/// When the reference count of this object drops to zero, the subscription will be canceled.</returns>
 			virtual Subscription subscribeFindGameFailed(std::function<void(FindGameFailedEvent)> callback) = 0;
 
+			/// <summary>
+			/// Get the public metrics of a GameFinder.
+			/// </summary>
+			/// <remarks>To display metrics continuously, prefer <c>subscribeMetrics()</c> to polling this method.</remarks>
 			virtual pplx::task<std::unordered_map<std::string, int>> getMetrics(const std::string& gameFinderName, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
 
+			/// <summary>
+			/// Subscribe to the public metrics of a GameFinder.
+			/// </summary>
+			/// <remarks>
+			/// The server pushes the metrics that changed, at an interval it controls.
+			/// The latest metrics are available with <c>getCachedMetrics()</c>, and each update raises the event of <c>subscribeMetricsUpdated()</c>.
+			/// The subscription ends when the client disconnects from the GameFinder.
+			/// </remarks>
+			/// <param name="gameFinderName">Name of the GameFinder.</param>
+			/// <returns>A task that completes when the initial metrics have been received.</returns>
+			virtual pplx::task<void> subscribeMetrics(const std::string& gameFinderName, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
+			/// <summary>
+			/// Stop receiving the public metrics of a GameFinder.
+			/// </summary>
+			/// <param name="gameFinderName">Name of the GameFinder.</param>
+			virtual pplx::task<void> unsubscribeMetrics(const std::string& gameFinderName, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
+			/// <summary>
+			/// Retrieve the latest metrics received for each subscribed GameFinder.
+			/// </summary>
+			/// <returns>A map with the GameFinder name as key.</returns>
+			virtual std::unordered_map<std::string, GameFinderMetrics> getCachedMetrics() = 0;
+
+			/// <summary>
+			/// Subscribe to metrics updates of the GameFinders subscribed to with <c>subscribeMetrics()</c>.
+			/// </summary>
+			/// <param name="callback">Callable object to be called with the updated metrics.</param>
+			/// <returns>A reference-counted <c>Subscription</c> object that tracks the lifetime of the subscription.
+			/// When the reference count of this object drops to zero, the subscription will be canceled.</returns>
+			virtual Subscription subscribeMetricsUpdated(std::function<void(GameFinderMetrics)> callback) = 0;
+
+			/// <summary>
+			/// Start a game search ticket for the local player.
+			/// </summary>
+			/// <remarks>
+			/// Unlike <c>findGame()</c>, several tickets can run at the same time, in the same GameFinder or in different ones.
+			/// Status updates, found games and failures of tickets are raised on the same events as the other searches,
+			/// with the <c>ticketId</c> field set to the id returned by this method.
+			/// When a game is found for a ticket, the GameFinder cancels the other tickets of the player it hosts before notifying the game,
+			/// and a <c>GameFinderStatus::Canceled</c> update is raised for each of them.
+			/// Tickets in different GameFinders are independent: each of them can find a game.
+			/// A ticket searches for the local player alone, the other members of their party are not included.
+			/// Party searches are started by the server when all party members are ready, and the GameFinder rejects tickets while such a search is running.
+			/// </remarks>
+			/// <param name="gameFinder">Name of the server-side GameFinder to search in.</param>
+			/// <param name="customData">Custom data of the search, passed to the GameFinder algorithm.</param>
+			/// <param name="ct">Cancels the ticket without waiting for the server confirmation.</param>
+			/// <returns>The id of the ticket.</returns>
+			virtual std::string submitTicket(const std::string& gameFinder, const std::string& customData, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
+			/// <summary>
+			/// Cancel a search ticket.
+			/// </summary>
+			/// <param name="ticketId">Id of the ticket returned by <c>submitTicket()</c>.</param>
+			/// <returns>A task that completes with true once the GameFinder has removed the ticket,
+			/// or false if the ticket had already ended or a game was already found for it.</returns>
+			virtual pplx::task<bool> cancelTicket(const std::string& ticketId, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
+			/// <summary>
+			/// Retrieve the status of the running search tickets.
+			/// </summary>
+			virtual std::vector<GameFinderStatusChangedEvent> getTickets() = 0;
+
+			/// <summary>
+			/// Search a game in several queues at once, and return the first game found.
+			/// </summary>
+			/// <remarks>
+			/// A ticket is submitted for each queue. All the queues must be in the same GameFinder:
+			/// when a game is found, the GameFinder cancels the other tickets before notifying the game, so the player never gets a second game.
+			/// Tickets are solo searches, see <c>submitTicket()</c>.
+			/// </remarks>
+			/// <param name="queues">Queues to search in. They differ by their custom data, and must all target the same GameFinder.</param>
+			/// <param name="ct">Cancels all the tickets. The task is canceled once their cancellation has been confirmed.</param>
+			/// <returns>A task that completes with the first game found, or fails when all the tickets have failed or have been cancelled.
+			/// Fails with <c>std::invalid_argument</c> if the queues target several GameFinders.</returns>
+			virtual pplx::task<GameFoundEvent> findGameMultiQueue(const std::vector<GameFinderQueue>& queues, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
 			/// <summary>
 			/// Returns a task that completes the next time a game is found and fails when game finding fails.
 			/// </summary>
@@ -232,6 +431,119 @@ namespace Stormancer
 
 		namespace details
 		{
+			struct GameFinderMetricsUpdate
+			{
+				bool isFull = false;
+				std::unordered_map<std::string, int> values;
+				std::vector<std::string> removed;
+				// Milliseconds since the unix epoch
+				int64 timestamp = 0;
+				int32 intervalMs = 0;
+
+				MSGPACK_DEFINE(isFull, values, removed, timestamp, intervalMs)
+			};
+
+			// Decodes the status updates received on the route gamefinder.status. See GameFinderStatusFrame on the server for the layout.
+			struct GameFinderStatusFrame
+			{
+				static constexpr byte Version = 1;
+
+				enum Fields : byte
+				{
+					TicketId = 1,
+					EstimatedWait = 2,
+					QueuePosition = 4,
+					CriteriaLevel = 8,
+					ProgressOnly = 16
+				};
+
+				// Unsigned LEB128. Fails on truncated values and on values longer than 64 bits.
+				static bool readVarint(ibytestream& stream, uint64& value)
+				{
+					value = 0;
+					for (int shift = 0; shift < 64; shift += 7)
+					{
+						if (stream.availableSize() < 1)
+						{
+							return false;
+						}
+						byte b;
+						stream.read(&b, 1);
+						value |= (uint64)(b & 0x7F) << shift;
+						if ((b & 0x80) == 0)
+						{
+							return true;
+						}
+					}
+					return false;
+				}
+
+				// Returns false if the frame is truncated or of an unknown version. The payload of the status, if any, follows in the stream.
+				static bool read(ibytestream& stream, GameFinderStatus& status, GameFinderStatusDetails& details, std::string& ticketId, bool& progressOnly)
+				{
+					if (stream.availableSize() < 3)
+					{
+						return false;
+					}
+					byte header[3];
+					stream.read(header, 3);
+					if (header[0] != Version)
+					{
+						// Unknown frame version
+						return false;
+					}
+					status = (GameFinderStatus)(int32)header[1];
+					byte flags = header[2];
+					progressOnly = (flags & ProgressOnly) != 0;
+
+					uint64 serverTime, searchTime;
+					if (!readVarint(stream, serverTime) || !readVarint(stream, searchTime))
+					{
+						return false;
+					}
+					details.available = true;
+					details.serverTime = std::chrono::milliseconds(serverTime);
+					details.searchTime = std::chrono::milliseconds(searchTime);
+					details.receivedOn = std::chrono::steady_clock::now();
+
+					uint64 value;
+					if (flags & TicketId)
+					{
+						if (!readVarint(stream, value) || value == 0 || value > (uint64)stream.availableSize())
+						{
+							return false;
+						}
+						ticketId.resize((size_t)value);
+						stream.read((byte*)&ticketId[0], (std::streamsize)value);
+					}
+					if (flags & EstimatedWait)
+					{
+						if (!readVarint(stream, value))
+						{
+							return false;
+						}
+						details.estimatedWait = std::chrono::milliseconds(value);
+					}
+					if (flags & QueuePosition)
+					{
+						if (!readVarint(stream, value))
+						{
+							return false;
+						}
+						details.queuePosition = (int)value;
+					}
+					if (flags & CriteriaLevel)
+					{
+						if (!readVarint(stream, value))
+						{
+							return false;
+						}
+						details.criteriaLevel = (int)value;
+					}
+					return true;
+				}
+			};
+
 			class GameFinderService : public std::enable_shared_from_this<GameFinderService>
 			{
 			public:
@@ -239,6 +551,7 @@ namespace Stormancer
 				GameFinderService(std::shared_ptr<Scene> scene)
 					: _scene(scene)
 					, _rpcService(scene->dependencyResolver().resolve<RpcService>())
+					, _logger(scene->dependencyResolver().resolve<ILogger>())
 				{
 				}
 
@@ -257,58 +570,67 @@ namespace Stormancer
 					std::weak_ptr<GameFinderService> wThat = this->shared_from_this();
 					_scene.lock()->addRoute("gamefinder.update", [wThat](Packetisp_ptr packet)
 					{
-						byte gameStateByte;
-						packet->stream.read(&gameStateByte, 1);
-						int32 gameState = gameStateByte;
+						byte statusByte;
+						packet->stream.read(&statusByte, 1);
+						auto status = (GameFinderStatus)(int32)statusByte;
 
 						if (auto that = wThat.lock())
 						{
-							that->_currentState = (GameFinderStatus)gameState;
+							that->onStatusUpdate(status, GameFinderStatusDetails(), packet);
+						}
+					});
 
-							auto ms = std::to_string(gameState);
+					_scene.lock()->addRoute("gamefinder.ticket.update", [wThat](Packetisp_ptr packet)
+					{
+						byte statusByte;
+						packet->stream.read(&statusByte, 1);
+						auto status = (GameFinderStatus)(int32)statusByte;
 
-							that->GameFinderStatusUpdated(that->_currentState);
+						if (auto that = wThat.lock())
+						{
+							auto ticketId = that->_serializer.deserializeOne<std::string>(packet->stream);
+							that->onTicketUpdate(ticketId, status, GameFinderStatusDetails(), packet);
+						}
+					});
 
-							switch (that->_currentState)
-							{
-							case GameFinderStatus::Success:
+					// Sent instead of the two routes above to clients announcing a protocol revision >= 202610182.
+					_scene.lock()->addRoute("gamefinder.status", [wThat](Packetisp_ptr packet)
+					{
+						if (auto that = wThat.lock())
+						{
+							GameFinderStatus status;
+							GameFinderStatusDetails details;
+							std::string ticketId;
+							bool progressOnly;
+							if (!GameFinderStatusFrame::read(packet->stream, status, details, ticketId, progressOnly))
 							{
-								auto connectionToken = that->_serializer.deserializeOne<std::string>(packet->stream);
-
-								GameFinderResponse response;
-								response.connectionToken = connectionToken;
-								response.packet = packet;
-
-								that->GameFound(response);
-								that->_currentState = GameFinderStatus::Idle;
-								that->GameFinderStatusUpdated(that->_currentState);
-								break;
+								that->_logger->log(LogLevel::Warn, that->_logCategory, "Ignored an invalid GameFinder status update");
+								return;
 							}
-							case GameFinderStatus::Canceled:
+
+							// The payload of the status follows the frame in the packet stream.
+							if (progressOnly)
 							{
-								that->_currentState = GameFinderStatus::Idle;
-								that->GameFinderStatusUpdated(that->_currentState);
-								break;
+								that->onProgressUpdate(ticketId, status, details);
 							}
-							case GameFinderStatus::Failed:
+							else if (ticketId.empty())
 							{
-								std::string reason;
-								// There may or may not be a reason string supplied with the failure notification, so check if the stream has more data
-								if (packet->stream.good() && packet->stream.availableSize() > 0)
-								{
-									reason = that->_serializer.deserializeOne<std::string>(packet->stream);
-								}
-								that->FindGameRequestFailed(reason);
-								that->_currentState = GameFinderStatus::Idle;
-								that->GameFinderStatusUpdated(that->_currentState);
-								break;
+								that->onStatusUpdate(status, details, packet);
 							}
-							default:
-								// ignore
-								break;
+							else
+							{
+								that->onTicketUpdate(ticketId, status, details, packet);
 							}
 						}
 					});
+
+					_scene.lock()->addRoute("gamefinder.metrics.update", [wThat](Packetisp_ptr packet)
+					{
+						if (auto that = wThat.lock())
+						{
+							that->applyMetrics(that->_serializer.deserializeOne<GameFinderMetricsUpdate>(packet->stream));
+						}
+					});
 				}
 
 				GameFinderStatus currentState() const
@@ -316,6 +638,82 @@ namespace Stormancer
 					return _currentState;
 				}
 
+				/// <summary>
+				/// Details of the last status update received for the current findGame() request.
+				/// </summary>
+				GameFinderStatusDetails currentStatusDetails() const
+				{
+					std::lock_guard<std::mutex> lg(_ticketsMutex);
+					return _currentDetails;
+				}
+
+				/// <summary>
+				/// Status of a ticket started with findGameTicket(). Idle if the ticket is unknown or has ended.
+				/// </summary>
+				GameFinderStatus ticketStatus(const std::string& ticketId) const
+				{
+					std::lock_guard<std::mutex> lg(_ticketsMutex);
+					auto it = _tickets.find(ticketId);
+					return it != _tickets.end() ? it->second.status : GameFinderStatus::Idle;
+				}
+
+				/// <summary>
+				/// Details of the last status update received for a ticket.
+				/// </summary>
+				GameFinderStatusDetails ticketStatusDetails(const std::string& ticketId) const
+				{
+					std::lock_guard<std::mutex> lg(_ticketsMutex);
+					auto it = _tickets.find(ticketId);
+					return it != _tickets.end() ? it->second.details : GameFinderStatusDetails();
+				}
+
+				// The task completes when the server has ended the ticket. The outcome is raised on the Ticket* events.
+				pplx::task<void> findGameTicket(const std::string& ticketId, const std::string& customData, pplx::cancellation_token ct = pplx::cancellation_token::none())
+				{
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						TicketState ticket;
+						ticket.status = GameFinderStatus::Loading;
+						if (!_tickets.emplace(ticketId, ticket).second)
+						{
+							STORM_RETURN_TASK_FROM_EXCEPTION(std::runtime_error("A ticket with id '" + ticketId + "' is already running"), void);
+						}
+					}
+
+					std::weak_ptr<GameFinderService> wThat = this->shared_from_this();
+					return _rpcService->rpc("gamefinder.tickets.find", ct, ticketId, customData)
+						.then([wThat, ticketId](pplx::task<void> task)
+					{
+						// If the RPC fails (e.g. because of a disconnection), we might not have received the final status update of the ticket.
+						try
+						{
+							task.get();
+						}
+						catch (const pplx::task_canceled&)
+						{
+							if (auto that = wThat.lock())
+							{
+								that->endTicket(ticketId, GameFinderStatus::Canceled, "");
+							}
+							throw;
+						}
+						catch (const std::exception& ex)
+						{
+							if (auto that = wThat.lock())
+							{
+								that->endTicket(ticketId, GameFinderStatus::Failed, ex.what());
+							}
+							throw;
+						}
+					});
+				}
+
+				/// <returns>True once the server has removed the ticket, false if it was not running.</returns>
+				pplx::task<bool> cancelTicket(const std::string& ticketId, pplx::cancellation_token ct = pplx::cancellation_token::none())
+				{
+					return _rpcService->rpc<bool>("gamefinder.tickets.cancel", ct, ticketId);
+				}
+
 				pplx::task<void> findGame(const std::string &provider, const StreamWriter& streamWriter, pplx::cancellation_token ct = pplx::cancellation_token::none())
 				{
 					return findGameInternal(provider, streamWriter, ct);
@@ -351,7 +749,20 @@ namespace Stormancer
 						_currentState != GameFinderStatus::Success)
 					{
 						_currentState = GameFinderStatus::Failed;
-						GameFinderStatusUpdated(_currentState);
+						GameFinderStatusUpdated(_currentState, GameFinderStatusDetails());
+					}
+
+					std::vector<std::string> tickets;
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						for (const auto& ticket : _tickets)
+						{
+							tickets.push_back(ticket.first);
+						}
+					}
+					for (const auto& ticketId : tickets)
+					{
+						endTicket(ticketId, GameFinderStatus::Failed, "disconnected");
 					}
 				}
 
@@ -366,62 +777,352 @@ namespace Stormancer
 					return _rpcService->rpc<std::unordered_map<std::string, int>>("gamefinder.getmetrics", ct);
 				}
 
-				Event<GameFinderStatus> GameFinderStatusUpdated;
-				Event<GameFinderResponse> GameFound;
-				Event<std::string> FindGameRequestFailed;
-
-			private:
-
-				pplx::task<void> findGameInternal(const std::string& provider, const StreamWriter& streamWriter, pplx::cancellation_token ct = pplx::cancellation_token::none())
+				pplx::task<void> subscribeMetrics(pplx::cancellation_token ct = pplx::cancellation_token::none())
 				{
-					if (currentState() != GameFinderStatus::Idle)
 					{
-						STORM_RETURN_TASK_FROM_EXCEPTION(std::runtime_error("Already finding a game !"), void);
+						std::lock_guard<std::mutex> lg(_metricsMutex);
+						_metricsSubscribed = true;
 					}
 
-					_currentState = GameFinderStatus::Searching;
-					_gameFinderCTS = pplx::cancellation_token_source();
-
-					StreamWriter streamWriter2 = [provider, streamWriter](obytestream& stream)
-					{
-						Serializer serializer;
-						serializer.serialize(stream, provider);
-						streamWriter(stream);
-					};
-
 					std::weak_ptr<GameFinderService> wThat = this->shared_from_this();
-					return _rpcService->rpc("gamefinder.find", ct, streamWriter2)
-						.then([wThat](pplx::task<void> res)
+					return _rpcService->rpc<GameFinderMetricsUpdate>("gamefinder.metrics.subscribe", ct)
+						.then([wThat](GameFinderMetricsUpdate update)
 					{
-						// If the RPC fails (e.g. because of a disconnection), we might not have received a failed/canceled status update.
-						// Make sure we go back to Idle state anyway.
-						try
-						{
-							res.get();
-						}
-						catch (...)
+						if (auto that = wThat.lock())
 						{
-							if (auto that = wThat.lock())
-							{
-								if (that->_currentState != GameFinderStatus::Idle)
-								{
-									that->_currentState = GameFinderStatus::Idle;
-									that->GameFinderStatusUpdated(that->_currentState);
-								}
-							}
-							throw;
+							that->applyMetrics(update);
 						}
-						return res;
 					});
 				}
 
-				template<typename... TData>
-				pplx::task<void> findGameInternal(const std::string& provider, pplx::cancellation_token ct = pplx::cancellation_token::none(), TData... tData)
+				pplx::task<void> unsubscribeMetrics(pplx::cancellation_token ct = pplx::cancellation_token::none())
 				{
-					StreamWriter streamWriter = [tData...](obytestream* stream)
 					{
-						Serializer serializer;
-						serializer.serialize(stream, tData...);
+						std::lock_guard<std::mutex> lg(_metricsMutex);
+						_metricsSubscribed = false;
+						_hasMetrics = false;
+						_pendingMetricsUpdates.clear();
+					}
+					return _rpcService->rpc("gamefinder.metrics.unsubscribe", ct);
+				}
+
+				/// <summary>
+				/// Latest metrics pushed by the server.
+				/// </summary>
+				/// <returns>False if no metrics were received since the subscription.</returns>
+				bool tryGetMetrics(GameFinderMetrics& metrics) const
+				{
+					std::lock_guard<std::mutex> lg(_metricsMutex);
+					if (_hasMetrics)
+					{
+						metrics = _metrics;
+					}
+					return _hasMetrics;
+				}
+
+				Event<GameFinderStatus, GameFinderStatusDetails> GameFinderStatusUpdated;
+				Event<GameFinderResponse> GameFound;
+				Event<std::string> FindGameRequestFailed;
+
+				Event<GameFinderMetrics> MetricsUpdated;
+
+				// Parameters: ticket id, status, details
+				Event<std::string, GameFinderStatus, GameFinderStatusDetails> TicketStatusUpdated;
+				// Parameters: ticket id, response
+				Event<std::string, GameFinderResponse> TicketGameFound;
+				// Parameters: ticket id, reason
+				Event<std::string, std::string> TicketFailed;
+				// Parameters: ticket id (empty for searches started with findGame), status, details
+				Event<std::string, GameFinderStatus, GameFinderStatusDetails> ProgressUpdated;
+
+				static bool isTicketEnded(GameFinderStatus status)
+				{
+					return status == GameFinderStatus::Success || status == GameFinderStatus::Failed || status == GameFinderStatus::Canceled;
+				}
+
+			private:
+
+				struct TicketState
+				{
+					GameFinderStatus status = GameFinderStatus::Idle;
+					GameFinderStatusDetails details;
+				};
+
+				// Binary updates can be checked for ordering: an update older than the last one received is dropped, unless it ends the search.
+				static bool isStale(const GameFinderStatusDetails& last, const GameFinderStatusDetails& details, GameFinderStatus status)
+				{
+					return details.available && last.available && details.serverTime < last.serverTime && !isTicketEnded(status);
+				}
+
+				void onStatusUpdate(GameFinderStatus status, const GameFinderStatusDetails& details, Packetisp_ptr packet)
+				{
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						if (isStale(_currentDetails, details, status))
+						{
+							return;
+						}
+						_currentDetails = isTicketEnded(status) ? GameFinderStatusDetails() : details;
+					}
+
+					_currentState = status;
+					GameFinderStatusUpdated(_currentState, details);
+
+					switch (_currentState)
+					{
+					case GameFinderStatus::Success:
+					{
+						auto connectionToken = _serializer.deserializeOne<std::string>(packet->stream);
+
+						GameFinderResponse response;
+						response.connectionToken = connectionToken;
+						response.details = details;
+						response.packet = packet;
+
+						GameFound(response);
+						_currentState = GameFinderStatus::Idle;
+						GameFinderStatusUpdated(_currentState, GameFinderStatusDetails());
+						break;
+					}
+					case GameFinderStatus::Canceled:
+					{
+						_currentState = GameFinderStatus::Idle;
+						GameFinderStatusUpdated(_currentState, GameFinderStatusDetails());
+						break;
+					}
+					case GameFinderStatus::Failed:
+					{
+						std::string reason;
+						// There may or may not be a reason string supplied with the failure notification, so check if the stream has more data
+						if (packet->stream.good() && packet->stream.availableSize() > 0)
+						{
+							reason = _serializer.deserializeOne<std::string>(packet->stream);
+						}
+						FindGameRequestFailed(reason);
+						_currentState = GameFinderStatus::Idle;
+						GameFinderStatusUpdated(_currentState, GameFinderStatusDetails());
+						break;
+					}
+					default:
+						// ignore
+						break;
+					}
+				}
+
+				// Progress updates don't change the status of the search, only its details.
+				void onProgressUpdate(const std::string& ticketId, GameFinderStatus status, const GameFinderStatusDetails& details)
+				{
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						if (ticketId.empty())
+						{
+							if (_currentState != status || isStale(_currentDetails, details, status))
+							{
+								return;
+							}
+							_currentDetails = details;
+						}
+						else
+						{
+							auto it = _tickets.find(ticketId);
+							if (it == _tickets.end() || it->second.status != status || isStale(it->second.details, details, status))
+							{
+								return;
+							}
+							it->second.details = details;
+						}
+					}
+
+					ProgressUpdated(ticketId, status, details);
+				}
+
+				void applyMetrics(const GameFinderMetricsUpdate& update)
+				{
+					GameFinderMetrics metrics;
+					{
+						std::lock_guard<std::mutex> lg(_metricsMutex);
+						if (!_metricsSubscribed)
+						{
+							return;
+						}
+
+						if (!update.isFull && !_hasMetrics)
+						{
+							// Pushed before the response of the subscription: applied on top of it.
+							_pendingMetricsUpdates.push_back(update);
+							return;
+						}
+
+						applyMetricsValues(update);
+						if (update.isFull)
+						{
+							for (const auto& pending : _pendingMetricsUpdates)
+							{
+								if (pending.timestamp > update.timestamp)
+								{
+									applyMetricsValues(pending);
+								}
+							}
+							_pendingMetricsUpdates.clear();
+							_hasMetrics = true;
+						}
+						metrics = _metrics;
+					}
+
+					MetricsUpdated(metrics);
+				}
+
+				// Requires _metricsMutex
+				void applyMetricsValues(const GameFinderMetricsUpdate& update)
+				{
+					if (update.isFull)
+					{
+						_metrics.values = update.values;
+					}
+					else
+					{
+						for (const auto& value : update.values)
+						{
+							_metrics.values[value.first] = value.second;
+						}
+						for (const auto& key : update.removed)
+						{
+							_metrics.values.erase(key);
+						}
+					}
+
+					if (update.timestamp > 0)
+					{
+						_metrics.serverTime = std::chrono::system_clock::time_point(std::chrono::milliseconds(update.timestamp));
+					}
+					_metrics.interval = std::chrono::milliseconds(update.intervalMs);
+					_metrics.lastUpdate = std::chrono::steady_clock::now();
+				}
+
+				void onTicketUpdate(const std::string& ticketId, GameFinderStatus status, const GameFinderStatusDetails& details, Packetisp_ptr packet)
+				{
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						auto it = _tickets.find(ticketId);
+						if (it == _tickets.end())
+						{
+							// The ticket has already ended locally.
+							return;
+						}
+						if (isStale(it->second.details, details, status))
+						{
+							return;
+						}
+						if (isTicketEnded(status))
+						{
+							_tickets.erase(it);
+						}
+						else
+						{
+							it->second.status = status;
+							it->second.details = details;
+						}
+					}
+
+					TicketStatusUpdated(ticketId, status, details);
+
+					switch (status)
+					{
+					case GameFinderStatus::Success:
+					{
+						GameFinderResponse response;
+						response.connectionToken = _serializer.deserializeOne<std::string>(packet->stream);
+						response.details = details;
+						response.packet = packet;
+						TicketGameFound(ticketId, response);
+						break;
+					}
+					case GameFinderStatus::Failed:
+					{
+						std::string reason;
+						if (packet->stream.good() && packet->stream.availableSize() > 0)
+						{
+							reason = _serializer.deserializeOne<std::string>(packet->stream);
+						}
+						TicketFailed(ticketId, reason);
+						break;
+					}
+					default:
+						break;
+					}
+				}
+
+				void endTicket(const std::string& ticketId, GameFinderStatus status, const std::string& reason)
+				{
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						if (_tickets.erase(ticketId) == 0)
+						{
+							return;
+						}
+					}
+
+					TicketStatusUpdated(ticketId, status, GameFinderStatusDetails());
+					if (status == GameFinderStatus::Failed)
+					{
+						TicketFailed(ticketId, reason);
+					}
+				}
+
+				pplx::task<void> findGameInternal(const std::string& provider, const StreamWriter& streamWriter, pplx::cancellation_token ct = pplx::cancellation_token::none())
+				{
+					if (currentState() != GameFinderStatus::Idle)
+					{
+						STORM_RETURN_TASK_FROM_EXCEPTION(std::runtime_error("Already finding a game !"), void);
+					}
+
+					_currentState = GameFinderStatus::Searching;
+					_gameFinderCTS = pplx::cancellation_token_source();
+					{
+						std::lock_guard<std::mutex> lg(_ticketsMutex);
+						_currentDetails = GameFinderStatusDetails();
+					}
+
+					StreamWriter streamWriter2 = [provider, streamWriter](obytestream& stream)
+					{
+						Serializer serializer;
+						serializer.serialize(stream, provider);
+						streamWriter(stream);
+					};
+
+					std::weak_ptr<GameFinderService> wThat = this->shared_from_this();
+					return _rpcService->rpc("gamefinder.find", ct, streamWriter2)
+						.then([wThat](pplx::task<void> res)
+					{
+						// If the RPC fails (e.g. because of a disconnection), we might not have received a failed/canceled status update.
+						// Make sure we go back to Idle state anyway.
+						try
+						{
+							res.get();
+						}
+						catch (...)
+						{
+							if (auto that = wThat.lock())
+							{
+								if (that->_currentState != GameFinderStatus::Idle)
+								{
+									that->_currentState = GameFinderStatus::Idle;
+									that->GameFinderStatusUpdated(that->_currentState, GameFinderStatusDetails());
+								}
+							}
+							throw;
+						}
+						return res;
+					});
+				}
+
+				template<typename... TData>
+				pplx::task<void> findGameInternal(const std::string& provider, pplx::cancellation_token ct = pplx::cancellation_token::none(), TData... tData)
+				{
+					StreamWriter streamWriter = [tData...](obytestream* stream)
+					{
+						Serializer serializer;
+						serializer.serialize(stream, tData...);
 					};
 					return findGameInternal(provider, streamWriter, ct);
 				}
@@ -434,6 +1135,17 @@ namespace Stormancer
 				GameFinderStatus _currentState = GameFinderStatus::Idle;
 				Serializer _serializer;
 
+				mutable std::mutex _metricsMutex;
+				bool _metricsSubscribed = false;
+				bool _hasMetrics = false;
+				GameFinderMetrics _metrics;
+				std::vector<GameFinderMetricsUpdate> _pendingMetricsUpdates;
+
+				// Also protects _currentDetails
+				mutable std::mutex _ticketsMutex;
+				std::unordered_map<std::string, TicketState> _tickets;
+				GameFinderStatusDetails _currentDetails;
+
 				std::shared_ptr<ILogger> _logger;
 				std::string _logCategory = "GameFinder";
 			};
@@ -458,9 +1170,52 @@ namespace Stormancer
 				Subscription gameFoundSubscription;
 				Subscription gameFinderStateUpdatedSubscription;
 				Subscription findGamefailedSubscription;
+				Subscription ticketStatusUpdatedSubscription;
+				Subscription ticketGameFoundSubscription;
+				Subscription ticketFailedSubscription;
+				Subscription metricsUpdatedSubscription;
+				Subscription progressUpdatedSubscription;
 				rxcpp::subscription connectionStateChangedSubscription;
 			};
 
+			struct MultiQueueSearch
+			{
+				std::mutex mutex;
+				std::unordered_set<std::string> tickets;
+				bool completed = false;
+				std::string lastError;
+				pplx::task_completion_event<GameFoundEvent> tce;
+
+				pplx::cancellation_token ct = pplx::cancellation_token::none();
+				pplx::cancellation_token_registration ctRegistration;
+
+				Subscription gameFoundSubscription;
+				Subscription gameFinderStateChangedSubscription;
+				Subscription findGameFailedSubscription;
+
+				// Fails the search when all its tickets have ended without finding a game.
+				void onTicketEnded(const std::string& ticketId, const std::string& reason)
+				{
+					{
+						std::lock_guard<std::mutex> lg(mutex);
+						if (tickets.erase(ticketId) == 0)
+						{
+							return;
+						}
+						if (!reason.empty())
+						{
+							lastError = reason;
+						}
+						if (completed || !tickets.empty())
+						{
+							return;
+						}
+						completed = true;
+					}
+					tce.set_exception(std::runtime_error(lastError.empty() ? "operation_cancelled" : lastError));
+				}
+			};
+
 			class GameFinder_Impl : public std::enable_shared_from_this<GameFinder_Impl>, public GameFinderApi
 			{
 			public:
@@ -523,8 +1278,10 @@ namespace Stormancer
 				}
 
 				Event<GameFinderStatusChangedEvent> gameFinderStateChanged;
+				Event<GameFinderStatusChangedEvent> gameFinderProgressUpdated;
 				Event<GameFoundEvent> gameFound;
 				Event<FindGameFailedEvent> findGameFailed;
+				Event<GameFinderMetrics> metricsUpdated;
 
 				std::unordered_map<std::string, GameFinderStatusChangedEvent> getPendingFindGameStatus() override
 				{
@@ -539,6 +1296,7 @@ namespace Stormancer
 
 							auto container = task.get();
 							status.status = container->service()->currentState();
+							status.details = container->service()->currentStatusDetails();
 						}
 						else
 						{
@@ -576,6 +1334,11 @@ namespace Stormancer
 					return gameFinderStateChanged.subscribe(callback);
 				}
 
+				Subscription subscribeGameFinderProgressUpdated(std::function<void(GameFinderStatusChangedEvent)> callback) override
+				{
+					return gameFinderProgressUpdated.subscribe(callback);
+				}
+
 				Subscription subscribeGameFound(std::function<void(GameFoundEvent)> callback)  override
 				{
 					return gameFound.subscribe(callback);
@@ -595,8 +1358,362 @@ namespace Stormancer
 					});
 				}
 
+				pplx::task<void> subscribeMetrics(const std::string& gameFinderName, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					return getGameFinderContainer(gameFinderName, ct)
+						.then([ct](std::shared_ptr<GameFinderContainer> gameFinderContainer)
+					{
+						return gameFinderContainer->service()->subscribeMetrics(ct);
+					});
+				}
+
+				pplx::task<void> unsubscribeMetrics(const std::string& gameFinderName, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					pplx::task<std::shared_ptr<GameFinderContainer>> containerTask;
+					{
+						std::lock_guard<std::recursive_mutex> lg(_lock);
+						auto it = _gameFinders.find(gameFinderName);
+						if (it == _gameFinders.end())
+						{
+							// Not connected: there is no subscription.
+							return pplx::task_from_result();
+						}
+						containerTask = it->second;
+					}
+
+					return containerTask.then([ct](std::shared_ptr<GameFinderContainer> gameFinderContainer)
+					{
+						return gameFinderContainer->service()->unsubscribeMetrics(ct);
+					});
+				}
+
+				std::unordered_map<std::string, GameFinderMetrics> getCachedMetrics() override
+				{
+					std::lock_guard<std::recursive_mutex> lg(_lock);
+					std::unordered_map<std::string, GameFinderMetrics> result;
+					for (auto gameFinder : _gameFinders)
+					{
+						auto task = gameFinder.second;
+						if (task.is_done())
+						{
+							try
+							{
+								GameFinderMetrics metrics;
+								if (task.get()->service()->tryGetMetrics(metrics))
+								{
+									metrics.gameFinder = gameFinder.first;
+									result.emplace(gameFinder.first, metrics);
+								}
+							}
+							catch (const std::exception&)
+							{
+							}
+						}
+					}
+					return result;
+				}
+
+				Subscription subscribeMetricsUpdated(std::function<void(GameFinderMetrics)> callback) override
+				{
+					return metricsUpdated.subscribe(callback);
+				}
+
+				std::string submitTicket(const std::string& gameFinder, const std::string& customData, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					std::weak_ptr<GameFinder_Impl> wThat = this->shared_from_this();
+
+					std::string ticketId;
+					pplx::cancellation_token_source ticketCts;
+					{
+						std::lock_guard<std::recursive_mutex> lg(_lock);
+						ticketId = std::to_string(++_ticketCounter);
+
+						PendingTicket ticket;
+						ticket.gameFinder = gameFinder;
+						ticket.cts = ticketCts;
+						_tickets.emplace(ticketId, ticket);
+					}
+
+					auto cts = create_linked_source(ct, ticketCts.get_token());
+					auto newCt = cts.get_token();
+
+					getGameFinderContainer(gameFinder, newCt)
+						.then([wThat, ticketId, customData, newCt](std::shared_ptr<GameFinderContainer> gameFinderContainer)
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							throw ObjectDeletedException("GameFinder");
+						}
+
+						{
+							std::lock_guard<std::recursive_mutex> lg(that->_lock);
+							auto it = that->_tickets.find(ticketId);
+							if (newCt.is_canceled() || it == that->_tickets.end())
+							{
+								pplx::cancel_current_task();
+							}
+							it->second.sent = true;
+						}
+						return gameFinderContainer->service()->findGameTicket(ticketId, customData, newCt);
+					})
+						.then([wThat, gameFinder, ticketId](pplx::task<void> task)
+					{
+						// The service raises the final status of the tickets it has sent. This handles the failures that happen before.
+						try
+						{
+							task.get();
+						}
+						catch (const pplx::task_canceled&)
+						{
+							if (auto that = wThat.lock())
+							{
+								that->abortTicket(gameFinder, ticketId, GameFinderStatus::Canceled, "");
+							}
+						}
+						catch (const std::exception& ex)
+						{
+							if (auto that = wThat.lock())
+							{
+								that->abortTicket(gameFinder, ticketId, GameFinderStatus::Failed, ex.what());
+							}
+						}
+					});
+
+					return ticketId;
+				}
+
+				pplx::task<bool> cancelTicket(const std::string& ticketId, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					std::string gameFinder;
+					{
+						std::lock_guard<std::recursive_mutex> lg(_lock);
+						auto it = _tickets.find(ticketId);
+						if (it == _tickets.end())
+						{
+							return pplx::task_from_result(false);
+						}
+						if (!it->second.sent)
+						{
+							// The ticket has not reached the server yet.
+							it->second.cts.cancel();
+							return pplx::task_from_result(true);
+						}
+						gameFinder = it->second.gameFinder;
+					}
+
+					return getGameFinderContainer(gameFinder, ct)
+						.then([ticketId, ct](std::shared_ptr<GameFinderContainer> gameFinderContainer)
+					{
+						return gameFinderContainer->service()->cancelTicket(ticketId, ct);
+					});
+				}
+
+				std::vector<GameFinderStatusChangedEvent> getTickets() override
+				{
+					std::lock_guard<std::recursive_mutex> lg(_lock);
+					std::vector<GameFinderStatusChangedEvent> result;
+					for (const auto& ticket : _tickets)
+					{
+						GameFinderStatusChangedEvent status;
+						status.gameFinder = ticket.second.gameFinder;
+						status.ticketId = ticket.first;
+						status.status = GameFinderStatus::Loading;
+
+						auto it = _gameFinders.find(ticket.second.gameFinder);
+						if (ticket.second.sent && it != _gameFinders.end() && it->second.is_done())
+						{
+							try
+							{
+								auto service = it->second.get()->service();
+								status.status = service->ticketStatus(ticket.first);
+								status.details = service->ticketStatusDetails(ticket.first);
+							}
+							catch (const std::exception&)
+							{
+							}
+						}
+						result.push_back(status);
+					}
+					return result;
+				}
+
+				pplx::task<GameFoundEvent> findGameMultiQueue(const std::vector<GameFinderQueue>& queues, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					if (queues.empty())
+					{
+						STORM_RETURN_TASK_FROM_EXCEPTION(std::invalid_argument("No queue to search in"), GameFoundEvent);
+					}
+					// Only a GameFinder can make sure that a single ticket of the player wins, it can't claim players from another GameFinder.
+					for (const auto& queue : queues)
+					{
+						if (queue.gameFinder != queues.front().gameFinder)
+						{
+							STORM_RETURN_TASK_FROM_EXCEPTION(std::invalid_argument("All the queues of a multi-queue search must target the same GameFinder"), GameFoundEvent);
+						}
+					}
+
+					std::weak_ptr<GameFinder_Impl> wThat = this->shared_from_this();
+					auto search = std::make_shared<MultiQueueSearch>();
+					std::weak_ptr<MultiQueueSearch> wSearch = search;
+
+					search->gameFoundSubscription = gameFound.subscribe([wThat, wSearch](GameFoundEvent ev)
+					{
+						auto that = wThat.lock();
+						auto search = wSearch.lock();
+						if (!that || !search)
+						{
+							return;
+						}
+
+						std::vector<std::string> otherTickets;
+						{
+							std::lock_guard<std::mutex> lg(search->mutex);
+							if (search->completed || search->tickets.erase(ev.ticketId) == 0)
+							{
+								return;
+							}
+							search->completed = true;
+							otherTickets.assign(search->tickets.begin(), search->tickets.end());
+						}
+
+						// The other tickets have already been cancelled by the server, cancelTicket() returns false for them.
+						// It only stops the tickets that had not been sent yet.
+						that->cancelTickets(otherTickets).then([search, ev]()
+						{
+							search->tce.set(ev);
+						});
+					});
+					search->gameFinderStateChangedSubscription = gameFinderStateChanged.subscribe([wSearch](GameFinderStatusChangedEvent ev)
+					{
+						if (ev.status == GameFinderStatus::Canceled)
+						{
+							if (auto search = wSearch.lock())
+							{
+								search->onTicketEnded(ev.ticketId, "");
+							}
+						}
+					});
+					search->findGameFailedSubscription = findGameFailed.subscribe([wSearch](FindGameFailedEvent ev)
+					{
+						if (auto search = wSearch.lock())
+						{
+							search->onTicketEnded(ev.ticketId, ev.reason);
+						}
+					});
+
+					{
+						std::lock_guard<std::mutex> lg(search->mutex);
+						for (const auto& queue : queues)
+						{
+							search->tickets.insert(submitTicket(queue.gameFinder, queue.customData));
+						}
+					}
+
+					if (ct.is_cancelable())
+					{
+						search->ct = ct;
+						search->ctRegistration = ct.register_callback([wThat, wSearch]()
+						{
+							auto search = wSearch.lock();
+							if (!search)
+							{
+								return;
+							}
+
+							std::vector<std::string> tickets;
+							{
+								std::lock_guard<std::mutex> lg(search->mutex);
+								if (search->completed)
+								{
+									return;
+								}
+								search->completed = true;
+								tickets.assign(search->tickets.begin(), search->tickets.end());
+							}
+
+							auto that = wThat.lock();
+							if (!that)
+							{
+								search->tce.set_exception(pplx::task_canceled());
+								return;
+							}
+							that->cancelTickets(tickets).then([search]()
+							{
+								search->tce.set_exception(pplx::task_canceled());
+							});
+						});
+					}
+
+					// The continuation also makes sure the subscriptions don't expire before task completion.
+					return pplx::create_task(search->tce).then([search](pplx::task<GameFoundEvent> task)
+					{
+						if (search->ct.is_cancelable())
+						{
+							search->ct.deregister_callback(search->ctRegistration);
+						}
+						return task;
+					});
+				}
+
 			private:
 
+				struct PendingTicket
+				{
+					std::string gameFinder;
+					// Cancels the ticket before it is sent to the server.
+					pplx::cancellation_token_source cts;
+					bool sent = false;
+				};
+
+				void abortTicket(const std::string& gameFinder, const std::string& ticketId, GameFinderStatus status, const std::string& reason)
+				{
+					{
+						std::lock_guard<std::recursive_mutex> lg(_lock);
+						if (_tickets.erase(ticketId) == 0)
+						{
+							return;
+						}
+					}
+
+					GameFinderStatusChangedEvent ev;
+					ev.gameFinder = gameFinder;
+					ev.ticketId = ticketId;
+					ev.status = status;
+					gameFinderStateChanged(ev);
+
+					if (status == GameFinderStatus::Failed)
+					{
+						FindGameFailedEvent failedEvent;
+						failedEvent.gameFinder = gameFinder;
+						failedEvent.ticketId = ticketId;
+						failedEvent.reason = reason;
+						findGameFailed(failedEvent);
+					}
+				}
+
+				// Completes when the GameFinders have confirmed the cancellation of all the tickets, or failed to.
+				pplx::task<void> cancelTickets(const std::vector<std::string>& tickets)
+				{
+					std::vector<pplx::task<void>> tasks;
+					tasks.reserve(tickets.size());
+					for (const auto& ticketId : tickets)
+					{
+						tasks.push_back(cancelTicket(ticketId).then([](pplx::task<bool> task)
+						{
+							try
+							{
+								task.get();
+							}
+							catch (const std::exception&)
+							{
+								// The ticket ends anyway when its scene disconnects.
+							}
+						}));
+					}
+					return pplx::when_all(tasks.begin(), tasks.end());
+				}
+
 				pplx::task<std::shared_ptr<GameFinderContainer>> connectToGameFinderImpl(std::string gameFinderName, pplx::cancellation_token ct = pplx::cancellation_token::none())
 				{
 					auto users = _users.lock();
@@ -641,13 +1758,14 @@ namespace Stormancer
 									that->gameFound(ev);
 								}
 							});
-							container->gameFinderStateUpdatedSubscription = service->GameFinderStatusUpdated.subscribe([wThat, gameFinderName](GameFinderStatus s)
+							container->gameFinderStateUpdatedSubscription = service->GameFinderStatusUpdated.subscribe([wThat, gameFinderName](GameFinderStatus s, GameFinderStatusDetails details)
 							{
 								if (auto that = wThat.lock())
 								{
 									GameFinderStatusChangedEvent ev;
 									ev.gameFinder = gameFinderName;
 									ev.status = s;
+									ev.details = details;
 									that->gameFinderStateChanged(ev);
 								}
 							});
@@ -661,6 +1779,66 @@ namespace Stormancer
 									that->findGameFailed(ev);
 								}
 							});
+							container->metricsUpdatedSubscription = service->MetricsUpdated.subscribe([wThat, gameFinderName](GameFinderMetrics metrics)
+							{
+								if (auto that = wThat.lock())
+								{
+									metrics.gameFinder = gameFinderName;
+									that->metricsUpdated(metrics);
+								}
+							});
+							container->progressUpdatedSubscription = service->ProgressUpdated.subscribe([wThat, gameFinderName](std::string ticketId, GameFinderStatus s, GameFinderStatusDetails details)
+							{
+								if (auto that = wThat.lock())
+								{
+									GameFinderStatusChangedEvent ev;
+									ev.gameFinder = gameFinderName;
+									ev.ticketId = ticketId;
+									ev.status = s;
+									ev.details = details;
+									that->gameFinderProgressUpdated(ev);
+								}
+							});
+							container->ticketStatusUpdatedSubscription = service->TicketStatusUpdated.subscribe([wThat, gameFinderName](std::string ticketId, GameFinderStatus s, GameFinderStatusDetails details)
+							{
+								if (auto that = wThat.lock())
+								{
+									if (GameFinderService::isTicketEnded(s))
+									{
+										std::lock_guard<std::recursive_mutex> lg(that->_lock);
+										that->_tickets.erase(ticketId);
+									}
+
+									GameFinderStatusChangedEvent ev;
+									ev.gameFinder = gameFinderName;
+									ev.ticketId = ticketId;
+									ev.status = s;
+									ev.details = details;
+									that->gameFinderStateChanged(ev);
+								}
+							});
+							container->ticketGameFoundSubscription = service->TicketGameFound.subscribe([wThat, gameFinderName](std::string ticketId, GameFinderResponse r)
+							{
+								if (auto that = wThat.lock())
+								{
+									GameFoundEvent ev;
+									ev.gameFinder = gameFinderName;
+									ev.ticketId = ticketId;
+									ev.data = r;
+									that->gameFound(ev);
+								}
+							});
+							container->ticketFailedSubscription = service->TicketFailed.subscribe([wThat, gameFinderName](std::string ticketId, std::string reason)
+							{
+								if (auto that = wThat.lock())
+								{
+									FindGameFailedEvent ev;
+									ev.gameFinder = gameFinderName;
+									ev.ticketId = ticketId;
+									ev.reason = reason;
+									that->findGameFailed(ev);
+								}
+							});
 							return container;
 						}
 						catch (const std::exception& ex)
@@ -707,6 +1885,8 @@ namespace Stormancer
 				std::recursive_mutex _lock;
 				std::unordered_map<std::string, pplx::task<std::shared_ptr<GameFinderContainer>>> _gameFinders;
 				std::unordered_map<std::string, pplx::cancellation_token_source> _pendingFindGameRequests;
+				std::unordered_map<std::string, PendingTicket> _tickets;
+				uint64 _ticketCounter = 0;
 				std::weak_ptr<Users::UsersApi> _users;
 			};
 		}
@@ -716,7 +1896,7 @@ namespace Stormancer
 		public:
 
 			static constexpr const char* PLUGIN_NAME = "GameFinder";
-			static constexpr const char* PLUGIN_REVISION = "202006091";
+			static constexpr const char* PLUGIN_REVISION = "202610182";
 			static constexpr const char* PLUGIN_PROTOCOL_KEY = "stormancer.plugins.gamefinder.protocol";
 
 			PluginDescription getDescription() override
@@ -24,20 +24,30 @@ using Stormancer.Plugins;
 using Stormancer.Server.Plugins.API;
 using Stormancer.Server.Plugins.Users;
 using System;
+using System.Collections.Generic;
+using System.IO;
 using System.Linq;
+using System.Threading;
 using System.Threading.Tasks;
 
 namespace Stormancer.Server.Plugins.Leaderboards
 {
     class LeaderboardController : ControllerBase
     {
+        /// <summary>
+        /// Maximum number of queries accepted by <see cref="QueryMany(RequestContext{IScenePeerClient})"/>.
+        /// </summary>
+        private const int MaxQueriesPerRequest = 32;
+
         private readonly ILeaderboardService _leaderboard;
         private readonly IUserSessions userSessions;
+        private readonly ISerializer serializer;
 
-        public LeaderboardController(ILeaderboardService leaderboard, IUserSessions userSessions)
+        public LeaderboardController(ILeaderboardService leaderboard, IUserSessions userSessions, ISerializer serializer)
         {
             _leaderboard = leaderboard;
             this.userSessions = userSessions;
+            this.serializer = serializer;
         }
 
         public async Task Query(RequestContext<IScenePeerClient> ctx)
@@ -50,24 +60,48 @@ namespace Stormancer.Server.Plugins.Leaderboards
             }
 
             var query = ctx.ReadObject<LeaderboardQuery>();
-            query.UserId = session?.User?.Id;
-            if (query.Size <= 0)
+            await ctx.SendValue(await RunQuery(query, session.User?.Id, ctx.CancellationToken));
+        }
+
+        /// <summary>
+        /// Runs several leaderboard queries in a single request.
+        /// </summary>
+        /// <remarks>
+        /// Each result is serialized separately and sent as a byte array, in the order of the queries,
+        /// so that clients can decode each of them with its own score and document types.
+        /// </remarks>
+        public async Task QueryMany(RequestContext<IScenePeerClient> ctx)
+        {
+            var session = await userSessions.GetSession(ctx.RemotePeer, ctx.CancellationToken);
+
+            if (session == null)
             {
-                query.Size = 10;
+                throw new ClientException("notAuthenticated");
             }
-            var result = await _leaderboard.Query(query,ctx.CancellationToken);
-            var rankings = result.Results.Select(v => new LeaderboardRanking<ScoreDto>() { Ranking = v.Ranking, Document = new ScoreDto(v.Document) }).ToList();
-            var dto = new LeaderboardResult<ScoreDto>() { LeaderboardName = result.LeaderboardName, Next = result.Next, Previous = result.Previous, Results = rankings, Total = result.Total };
-            await ctx.SendValue(dto);
+
+            var queries = ctx.ReadObject<List<LeaderboardQuery>>();
+            if (queries.Count > MaxQueriesPerRequest)
+            {
+                throw new ClientException($"tooManyQueries?max={MaxQueriesPerRequest}");
+            }
+
+            var results = await Task.WhenAll(queries.Select(async query =>
+            {
+                var dto = await RunQuery(query, session.User?.Id, ctx.CancellationToken);
+
+                using var stream = new MemoryStream();
+                serializer.Serialize(dto, stream);
+                return stream.ToArray();
+            }));
+
+            await ctx.SendValue(results);
         }
 
         public async Task Cursor(RequestContext<IScenePeerClient> ctx)
         {
             var cursor = ctx.ReadObject<string>();
             var result = await _leaderboard.QueryCursor(cursor,ctx.CancellationToken);
-            var rankings = result.Results.Select(v => new LeaderboardRanking<ScoreDto>() { Ranking = v.Ranking, Document = new ScoreDto(v.Document) }).ToList();
-            var dto = new LeaderboardResult<ScoreDto>() { LeaderboardName = result.LeaderboardName, Next = result.Next, Previous = result.Previous, Results = rankings, Total = result.Total };
-            await ctx.SendValue(dto);
+            await ctx.SendValue(ToDto(result));
         }
 
         public async Task GetRanking(RequestContext<IScenePeerClient> ctx)
@@ -84,9 +118,27 @@ namespace Stormancer.Server.Plugins.Leaderboards
                 result = new LeaderboardResult<ScoreRecord>();
                 result.LeaderboardName = query.Name;
             }
+            await ctx.SendValue(ToDto(result));
+        }
+
+        /// <summary>
+        /// Runs a leaderboard query on behalf of a user, as done by <see cref="Query(RequestContext{IScenePeerClient})"/> and for each query of <see cref="QueryMany(RequestContext{IScenePeerClient})"/>.
+        /// </summary>
+        private async Task<LeaderboardResult<ScoreDto>> RunQuery(LeaderboardQuery query, string? userId, CancellationToken cancellationToken)
+        {
+            query.UserId = userId;
+            if (query.Size <= 0)
+            {
+                query.Size = 10;
+            }
+            var result = await _leaderboard.Query(query, cancellationToken);
+            return ToDto(result);
+        }
+
+        private static LeaderboardResult<ScoreDto> ToDto(LeaderboardResult<ScoreRecord> result)
+        {
             var rankings = result.Results.Select(v => new LeaderboardRanking<ScoreDto>() { Ranking = v.Ranking, Document = new ScoreDto(v.Document) }).ToList();
-            var dto = new LeaderboardResult<ScoreDto>() { LeaderboardName = result.LeaderboardName, Next = result.Next, Previous = result.Previous, Results = rankings, Total = result.Total };
-            await ctx.SendValue(dto);
+            return new LeaderboardResult<ScoreDto>() { LeaderboardName = result.LeaderboardName, Next = result.Next, Previous = result.Previous, Results = rankings, Total = result.Total };
         }
     }
 }
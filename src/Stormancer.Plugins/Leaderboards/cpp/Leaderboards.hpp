@@ -22,12 +22,37 @@
 
 #pragma once
 #include "Users/ClientAPI.hpp"
+#include "Users/ConfigurationParameters.hpp"
 #include "stormancer/IPlugin.h"
+#include "stormancer/Configuration.h"
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
 
 namespace Stormancer
 {
 	namespace Leaderboards
 	{
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the Leaderboards plugin behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Default max age in milliseconds of cached leaderboard pages, used by the query overloads that don't take a maxAge argument.
+			/// Default is "0": these overloads always query the server.
+			/// </summary>
+			constexpr const char* CacheMaxAgeMs = "leaderboards.cache.maxAgeMs";
+
+			/// <summary>
+			/// Maximum number of pages kept in the leaderboard cache.
+			/// Default is "64".
+			/// </summary>
+			constexpr const char* CacheMaxEntries = "leaderboards.cache.maxEntries";
+		}
+
 		enum class ComparisonOperator : int8
 		{
 			GREATER_THAN_OR_EQUAL = 0,
@@ -117,6 +142,45 @@ namespace Stormancer
 
 
 
+		/// <summary>
+		/// Results of a batched leaderboard query, in the order of the queries.
+		/// </summary>
+		/// <remarks>
+		/// Each result is decoded on demand, so that leaderboards with different score and document types can be queried in the same request.
+		/// </remarks>
+		class LeaderboardResults
+		{
+		public:
+
+			LeaderboardResults() = default;
+
+			LeaderboardResults(std::vector<std::vector<byte>> results)
+				: _results(std::move(results))
+			{
+			}
+
+			std::size_t size() const
+			{
+				return _results.size();
+			}
+
+			/// <summary>
+			/// Decodes the result of the query at the given index.
+			/// </summary>
+			template<typename TScores, typename TDocument>
+			LeaderboardResult<TScores, TDocument> get(std::size_t index) const
+			{
+				auto& data = _results.at(index);
+				ibytestream stream(data.data(), data.size());
+				Serializer serializer;
+				return serializer.deserializeOne<LeaderboardResult<TScores, TDocument>>(stream);
+			}
+
+		private:
+
+			std::vector<std::vector<byte>> _results;
+		};
+
 		class LeaderboardPlugin;
 
 		namespace details
@@ -145,19 +209,162 @@ namespace Stormancer
 					return _rpcService->rpc<LeaderboardResult<TScores, TDocument>>("leaderboard.cursor", cursor);
 				}
 
+				//Query several leaderboards in a single request
+				pplx::task<LeaderboardResults> queryMany(const std::vector<LeaderboardQuery>& queries)
+				{
+					return _rpcService->rpc<std::vector<std::vector<byte>>>("leaderboard.querymany", queries)
+						.then([](std::vector<std::vector<byte>> results)
+							{
+								return LeaderboardResults(std::move(results));
+							});
+				}
+
 			private:
 
 				std::weak_ptr<Scene> _scene;
 				std::shared_ptr<RpcService> _rpcService;
 			};
+
+			/// <summary>
+			/// Client side cache of leaderboard pages, keyed by result type and query fingerprint or cursor.
+			/// </summary>
+			/// <remarks>
+			/// Pending requests are cached too, so that a page being prefetched is not requested twice.
+			/// </remarks>
+			class LeaderboardCache
+			{
+			public:
+
+				LeaderboardCache(std::size_t maxEntries)
+					: _maxEntries(maxEntries)
+				{
+				}
+
+				template<typename TResult>
+				pplx::task<TResult> getOrAdd(const std::string& fingerprint, std::chrono::milliseconds maxAge, std::function<pplx::task<TResult>()> factory)
+				{
+					auto key = std::string(typeid(TResult).name()) + "|" + fingerprint;
+					auto now = std::chrono::steady_clock::now();
+
+					pplx::task_completion_event<TResult> tce;
+					auto task = pplx::create_task(tce);
+					{
+						std::lock_guard<std::mutex> lg(_mutex);
+						auto it = _entries.find(key);
+						if (it != _entries.end())
+						{
+							auto cached = *std::static_pointer_cast<pplx::task<TResult>>(it->second.task);
+							if (!cached.is_done() || (now - it->second.createdOn <= maxAge && succeeded(cached)))
+							{
+								return cached;
+							}
+							_entries.erase(it);
+						}
+
+						if (maxAge.count() > 0)
+						{
+							// Placeholder completed by the factory, so that concurrent lookups share the request.
+							evictIfFull();
+							_entries[key] = Entry{ std::make_shared<pplx::task<TResult>>(task), now };
+						}
+					}
+
+					// The factory runs outside the lock: it sends a request, and may use the cache itself.
+					if (maxAge.count() <= 0)
+					{
+						return factory();
+					}
+
+					pplx::task<TResult> created;
+					try
+					{
+						created = factory();
+					}
+					catch (...)
+					{
+						tce.set_exception(std::current_exception());
+						return task;
+					}
+					created.then([tce](pplx::task<TResult> t)
+						{
+							try
+							{
+								tce.set(t.get());
+							}
+							catch (...)
+							{
+								tce.set_exception(std::current_exception());
+							}
+						});
+					return task;
+				}
+
+				void clear()
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					_entries.clear();
+				}
+
+			private:
+
+				struct Entry
+				{
+					std::shared_ptr<void> task;
+					std::chrono::steady_clock::time_point createdOn;
+				};
+
+				template<typename TResult>
+				static bool succeeded(const pplx::task<TResult>& task)
+				{
+					try
+					{
+						task.get();
+						return true;
+					}
+					catch (...)
+					{
+						return false;
+					}
+				}
+
+				void evictIfFull()
+				{
+					while (!_entries.empty() && _entries.size() >= _maxEntries)
+					{
+						auto oldest = _entries.begin();
+						for (auto it = _entries.begin(); it != _entries.end(); ++it)
+						{
+							if (it->second.createdOn < oldest->second.createdOn)
+							{
+								oldest = it;
+							}
+						}
+						_entries.erase(oldest);
+					}
+				}
+
+				std::size_t _maxEntries;
+				std::mutex _mutex;
+				std::unordered_map<std::string, Entry> _entries;
+			};
+
+			inline std::string fingerprint(const LeaderboardQuery& query)
+			{
+				obytestream stream;
+				msgpack::pack(&stream, query);
+				auto bytes = stream.bytes();
+				return std::string("query:") + std::string(bytes.begin(), bytes.end());
+			}
 		}
 
 		class Leaderboard : public Stormancer::ClientAPI<Leaderboard, details::LeaderboardService>
 		{
 		public:
 
-			Leaderboard(std::weak_ptr<Stormancer::Users::UsersApi> users)
+			Leaderboard(std::weak_ptr<Stormancer::Users::UsersApi> users, std::shared_ptr<Configuration> config)
 				: Stormancer::ClientAPI<Leaderboard, details::LeaderboardService>(users, "stormancer.plugins.leaderboards")
+				, _cache(readConfigurationParameter(config, ConfigurationKeys::CacheMaxEntries, 64))
+				, _defaultMaxAge(readConfigurationParameter(config, ConfigurationKeys::CacheMaxAgeMs, 0))
 			{
 			}
 
@@ -167,30 +374,288 @@ namespace Stormancer
 			template<typename TScores, typename TDocument>
 			pplx::task<LeaderboardResult<TScores, TDocument>> query(LeaderboardQuery query)
 			{
-				return getLeaderboardService()
-					.then([query](std::shared_ptr<Stormancer::Leaderboards::details::LeaderboardService> service)
+				return this->query<TScores, TDocument>(query, _defaultMaxAge);
+			}
+
+			//Query a leaderboard, returning a cached result if the same query was run less than maxAge ago.
+			template<typename TScores, typename TDocument>
+			pplx::task<LeaderboardResult<TScores, TDocument>> query(LeaderboardQuery query, std::chrono::milliseconds maxAge)
+			{
+				auto wThat = this->weak_from_this();
+				return _cache.getOrAdd<LeaderboardResult<TScores, TDocument>>(details::fingerprint(query), maxAge, [wThat, query]()
+					{
+						auto that = wThat.lock();
+						if (!that)
 						{
-							return service->query<TScores, TDocument>(query);
-						});
+							return pplx::task_from_exception<LeaderboardResult<TScores, TDocument>>(ObjectDeletedException("Leaderboard"));
+						}
+						return that->getLeaderboardService()
+							.then([query](std::shared_ptr<Stormancer::Leaderboards::details::LeaderboardService> service)
+								{
+									return service->query<TScores, TDocument>(query);
+								});
+					});
 			}
 
 			template<typename TScores, typename TDocument>
 			//Query a leaderboard using a cursor obtained from a LeaderboardResult (result.next or result.previous)
 			pplx::task<LeaderboardResult<TScores, TDocument>> query(const std::string& cursor)
 			{
+				return this->query<TScores, TDocument>(cursor, _defaultMaxAge);
+			}
+
+			template<typename TScores, typename TDocument>
+			//Query a leaderboard using a cursor, returning a cached or prefetched result if it is less than maxAge old.
+			pplx::task<LeaderboardResult<TScores, TDocument>> query(const std::string& cursor, std::chrono::milliseconds maxAge)
+			{
+				auto wThat = this->weak_from_this();
+				return _cache.getOrAdd<LeaderboardResult<TScores, TDocument>>("cursor:" + cursor, maxAge, [wThat, cursor]()
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							return pplx::task_from_exception<LeaderboardResult<TScores, TDocument>>(ObjectDeletedException("Leaderboard"));
+						}
+						return that->getLeaderboardService()
+							.then([cursor](std::shared_ptr<Stormancer::Leaderboards::details::LeaderboardService> service)
+								{
+									return service->query<TScores, TDocument>(cursor);
+								});
+					});
+			}
+
+			//Query several leaderboards in a single request. Use LeaderboardResults::get to decode each result with its own score and document types.
+			pplx::task<LeaderboardResults> queryMany(std::vector<LeaderboardQuery> queries)
+			{
+				if (queries.empty())
+				{
+					return pplx::task_from_result(LeaderboardResults());
+				}
 				return getLeaderboardService()
-					.then([cursor](std::shared_ptr<Stormancer::Leaderboards::details::LeaderboardService> service)
+					.then([queries](std::shared_ptr<Stormancer::Leaderboards::details::LeaderboardService> service)
 						{
-							return service->query<TScores, TDocument>(cursor);
+							return service->queryMany(queries);
 						});
 			}
 
+			//Query several leaderboards sharing the same score and document types in a single request.
+			template<typename TScores, typename TDocument>
+			pplx::task<std::vector<LeaderboardResult<TScores, TDocument>>> queryMany(std::vector<LeaderboardQuery> queries)
+			{
+				return queryMany(std::move(queries)).then([](LeaderboardResults results)
+					{
+						std::vector<LeaderboardResult<TScores, TDocument>> typedResults;
+						typedResults.reserve(results.size());
+						for (std::size_t i = 0; i < results.size(); i++)
+						{
+							typedResults.push_back(results.get<TScores, TDocument>(i));
+						}
+						return typedResults;
+					});
+			}
+
+			//Fetch in the background the page behind a cursor (typically result.next, when the UI nears the end of the current page).
+			//A later query on this cursor with a maxAge covering the prefetch returns the prefetched page without waiting for the server.
+			template<typename TScores, typename TDocument>
+			void prefetch(const std::string& cursor, std::chrono::milliseconds maxAge = std::chrono::seconds(30))
+			{
+				if (cursor.empty())
+				{
+					return;
+				}
+				// Observe the exception: a failed prefetch is evicted and retried by the next query.
+				query<TScores, TDocument>(cursor, maxAge).then([](pplx::task<LeaderboardResult<TScores, TDocument>> t)
+					{
+						try
+						{
+							t.get();
+						}
+						catch (...)
+						{
+						}
+					});
+			}
+
+			//Drop every cached page.
+			void clearCache()
+			{
+				_cache.clear();
+			}
+
 		private:
 
 			pplx::task<std::shared_ptr<Stormancer::Leaderboards::details::LeaderboardService>> getLeaderboardService()
 			{
 				return this->getService();
 			}
+
+			details::LeaderboardCache _cache;
+			std::chrono::milliseconds _defaultMaxAge;
+		};
+
+		/// <summary>
+		/// Sliding window over a leaderboard, for instance the ranks around the current player.
+		/// </summary>
+		/// <remarks>
+		/// The window is made of consecutive pages. Scrolling fetches the adjacent page through its cursor and drops the pages at the other end once the window holds more than maxSize rankings.
+		/// The next adjacent page is prefetched after each move, so that scrolling again in the same direction doesn't wait for the server.
+		/// </remarks>
+		template<typename TScores, typename TDocument>
+		class LeaderboardWindow : public std::enable_shared_from_this<LeaderboardWindow<TScores, TDocument>>
+		{
+		public:
+
+			/// <param name="leaderboard">Leaderboard API.</param>
+			/// <param name="query">Initial query. To get the ranks around the current player, set startId to the player's score id.</param>
+			/// <param name="maxSize">Number of rankings above which pages are dropped from the window.</param>
+			/// <param name="maxAge">Max age of the cached pages used by the window.</param>
+			LeaderboardWindow(std::shared_ptr<Leaderboard> leaderboard, LeaderboardQuery query, std::size_t maxSize, std::chrono::milliseconds maxAge = std::chrono::seconds(30))
+				: _leaderboard(leaderboard)
+				, _query(query)
+				, _maxSize(maxSize)
+				, _maxAge(maxAge)
+			{
+			}
+
+			/// <summary>
+			/// Loads the page of the initial query, and the page before it if it has one.
+			/// </summary>
+			pplx::task<void> load()
+			{
+				std::weak_ptr<LeaderboardWindow> wThat = this->shared_from_this();
+				return leaderboard()->query<TScores, TDocument>(_query, _maxAge).then([wThat](LeaderboardResult<TScores, TDocument> result)
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							throw ObjectDeletedException("LeaderboardWindow");
+						}
+						{
+							std::lock_guard<std::mutex> lg(that->_mutex);
+							that->_pages.clear();
+							that->_pages.push_back(result);
+						}
+						return that->scrollUp().then([](bool) {});
+					});
+			}
+
+			/// <summary>
+			/// Extends the window with the next page, dropping the first pages if the window is full.
+			/// </summary>
+			/// <returns>A task that completes with false if there is no next page.</returns>
+			pplx::task<bool> scrollDown()
+			{
+				return scroll(false);
+			}
+
+			/// <summary>
+			/// Extends the window with the previous page, dropping the last pages if the window is full.
+			/// </summary>
+			/// <returns>A task that completes with false if there is no previous page.</returns>
+			pplx::task<bool> scrollUp()
+			{
+				return scroll(true);
+			}
+
+			std::vector<LeaderboardRanking<TScores, TDocument>> rankings() const
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				std::vector<LeaderboardRanking<TScores, TDocument>> rankings;
+				for (auto& page : _pages)
+				{
+					rankings.insert(rankings.end(), page.results.begin(), page.results.end());
+				}
+				return rankings;
+			}
+
+			int64 total() const
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return _pages.empty() ? 0 : _pages.back().total;
+			}
+
+		private:
+
+			std::shared_ptr<Leaderboard> leaderboard()
+			{
+				auto leaderboard = _leaderboard.lock();
+				if (!leaderboard)
+				{
+					throw ObjectDeletedException("Leaderboard");
+				}
+				return leaderboard;
+			}
+
+			std::size_t size() const
+			{
+				std::size_t size = 0;
+				for (auto& page : _pages)
+				{
+					size += page.results.size();
+				}
+				return size;
+			}
+
+			pplx::task<bool> scroll(bool up)
+			{
+				std::string cursor;
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					if (!_pages.empty())
+					{
+						cursor = up ? _pages.front().previous : _pages.back().next;
+					}
+				}
+				if (cursor.empty())
+				{
+					return pplx::task_from_result(false);
+				}
+
+				std::weak_ptr<LeaderboardWindow> wThat = this->shared_from_this();
+				return leaderboard()->query<TScores, TDocument>(cursor, _maxAge).then([wThat, up](LeaderboardResult<TScores, TDocument> result)
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							throw ObjectDeletedException("LeaderboardWindow");
+						}
+						std::string adjacentCursor;
+						{
+							std::lock_guard<std::mutex> lg(that->_mutex);
+							if (up)
+							{
+								that->_pages.push_front(result);
+								while (that->_pages.size() > 1 && that->size() > that->_maxSize)
+								{
+									that->_pages.pop_back();
+								}
+								adjacentCursor = that->_pages.front().previous;
+							}
+							else
+							{
+								that->_pages.push_back(result);
+								while (that->_pages.size() > 1 && that->size() > that->_maxSize)
+								{
+									that->_pages.pop_front();
+								}
+								adjacentCursor = that->_pages.back().next;
+							}
+						}
+						if (auto leaderboard = that->_leaderboard.lock())
+						{
+							leaderboard->template prefetch<TScores, TDocument>(adjacentCursor, that->_maxAge);
+						}
+						return true;
+					});
+			}
+
+			std::weak_ptr<Leaderboard> _leaderboard;
+			LeaderboardQuery _query;
+			std::size_t _maxSize;
+			std::chrono::milliseconds _maxAge;
+
+			mutable std::mutex _mutex;
+			std::deque<LeaderboardResult<TScores, TDocument>> _pages;
 		};
 
 		class LeaderboardPlugin : public Stormancer::IPlugin
@@ -223,7 +688,7 @@ namespace Stormancer
 			}
 			void registerClientDependencies(Stormancer::ContainerBuilder& builder) override
 			{
-				builder.registerDependency<Stormancer::Leaderboards::Leaderboard, Users::UsersApi>().as<Leaderboard>().singleInstance();
+				builder.registerDependency<Stormancer::Leaderboards::Leaderboard, Users::UsersApi, Configuration>().as<Leaderboard>().singleInstance();
 			}
 
 		};
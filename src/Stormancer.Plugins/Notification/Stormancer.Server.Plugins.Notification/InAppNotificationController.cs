@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+using MessagePack;
+
+using Stormancer.Core;
+using Stormancer.Plugins;
+using Stormancer.Server.Plugins.API;
+using Stormancer.Server.Plugins.Users;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace Stormancer.Server.Plugins.Notification
+{
+    /// <summary>
+    /// Lets players retrieve their stored notifications.
+    /// </summary>
+    class InAppNotificationController : ControllerBase
+    {
+        internal const int MaxPageSize = 100;
+        internal const int MaxAcknowledgementBatchSize = 100;
+
+        private readonly InAppNotificationRepository _repository;
+        private readonly IUserSessions _userSessions;
+
+        public InAppNotificationController(InAppNotificationRepository repository, IUserSessions userSessions)
+        {
+            _repository = repository;
+            _userSessions = userSessions;
+        }
+
+        /// <summary>
+        /// Gets the stored notifications of the current user created after a cursor, oldest first.
+        /// </summary>
+        /// <remarks>
+        /// Used by clients on connection to retrieve the notifications stored since their last synchronization.
+        /// Notifications stored with <see cref="InAppNotificationAcknowledgment.OnSend"/> are kept until the client acknowledges them.
+        /// </remarks>
+        /// <param name="cursor"><see cref="InAppNotificationPage.NextCursor"/> of the previous synchronization, or an empty string to start from the oldest notification.</param>
+        /// <param name="count">Maximum number of notifications to return.</param>
+        /// <param name="ctx"></param>
+        /// <returns></returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "inappnotification.sync")]
+        public async Task<InAppNotificationPage> Sync(string? cursor, int count, RequestContext<IScenePeerClient> ctx)
+        {
+            var user = await _userSessions.GetUser(ctx.RemotePeer, ctx.CancellationToken);
+            if (user == null)
+            {
+                throw new ClientException("NotAuthenticated");
+            }
+
+            count = Math.Clamp(count, 1, MaxPageSize);
+            var (records, nextCursor) = await _repository.GetNotificationsAfter(user.Id, cursor, count);
+
+            return new InAppNotificationPage
+            {
+                Notifications = records.Select(ToClientNotification).ToList(),
+                NextCursor = nextCursor ?? "",
+                HasMore = records.Count == count
+            };
+        }
+
+        /// <summary>
+        /// Gets a page of the stored notifications of the current user, newest first.
+        /// </summary>
+        /// <param name="cursor"><see cref="InAppNotificationPage.NextCursor"/> of the previous page, or an empty string to get the first page.</param>
+        /// <param name="count">Maximum number of notifications to return.</param>
+        /// <param name="ctx"></param>
+        /// <returns></returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "inappnotification.history")]
+        public async Task<InAppNotificationPage> History(string? cursor, int count, RequestContext<IScenePeerClient> ctx)
+        {
+            var user = await _userSessions.GetUser(ctx.RemotePeer, ctx.CancellationToken);
+            if (user == null)
+            {
+                throw new ClientException("NotAuthenticated");
+            }
+
+            count = Math.Clamp(count, 1, MaxPageSize);
+            var (records, nextCursor) = await _repository.GetNotificationsPage(user.Id, cursor, count);
+            return new InAppNotificationPage
+            {
+                Notifications = records.Select(ToClientNotification).ToList(),
+                NextCursor = nextCursor ?? "",
+                HasMore = nextCursor != null
+            };
+        }
+
+        /// <summary>
+        /// Acknowledges notifications of the current user, removing them from the database.
+        /// </summary>
+        /// <param name="notificationIds">Ids of the notifications. Unknown ids and notifications of other users are ignored.</param>
+        /// <param name="ctx"></param>
+        /// <returns></returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "inappnotification.acknowledge")]
+        public async Task Acknowledge(List<string> notificationIds, RequestContext<IScenePeerClient> ctx)
+        {
+            if (notificationIds.Count > MaxAcknowledgementBatchSize)
+            {
+                throw new ClientException($"Cannot acknowledge more than {MaxAcknowledgementBatchSize} notifications at once.");
+            }
+
+            var user = await _userSessions.GetUser(ctx.RemotePeer, ctx.CancellationToken);
+            if (user == null)
+            {
+                throw new ClientException("NotAuthenticated");
+            }
+
+            if (notificationIds.Count > 0)
+            {
+                await _repository.AcknowledgeNotifications(user.Id, notificationIds);
+            }
+        }
+
+        /// <summary>
+        /// Acknowledges a notification of the current user.
+        /// </summary>
+        /// <remarks>
+        /// Used by clients that don't batch acknowledgements.
+        /// </remarks>
+        /// <param name="notificationId"></param>
+        /// <param name="ctx"></param>
+        /// <returns></returns>
+        [Api(ApiAccess.Public, ApiType.Rpc, Route = "inappnotification.acknowledgenotification")]
+        public Task AcknowledgeNotification(string notificationId, RequestContext<IScenePeerClient> ctx)
+        {
+            return Acknowledge(new List<string> { notificationId }, ctx);
+        }
+
+        private static InAppNotification ToClientNotification(InAppNotificationRecord record)
+        {
+            // The recipients are not sent to clients, as for pushed notifications.
+            return new InAppNotification(record) { UserId = "" };
+        }
+    }
+}
@@ -153,17 +153,8 @@ namespace Stormancer.Server.Plugins.Notification
             }
             else
             {
-                var list = new List<SessionId>();
-                foreach (var userId in notif.UserId.Split(new[] { ',' }, StringSplitOptions.RemoveEmptyEntries))
-                {
-                    var sessionIds = await _userSessions.GetPeers(userId, cancellationToken);
-                    foreach(var sessionId in sessionIds)
-                    { 
-                        list.Add(sessionId);
-                        sent = true;
-                    }
-                }
-                filter = new MatchArrayFilter(list);
+                await SendToUsers(notif, notif.UserId.Split(new[] { ',' }, StringSplitOptions.RemoveEmptyEntries), cancellationToken);
+                return true;
             }
 
             notif.Id = Guid.NewGuid().ToString("N");
@@ -182,6 +173,33 @@ namespace Stormancer.Server.Plugins.Notification
             return true;
         }
 
+        // Each user gets their own copy of the notification, stored under their id so that they can retrieve it later.
+        private async Task SendToUsers(InAppNotification notif, IEnumerable<string> userIds, CancellationToken cancellationToken)
+        {
+            var createdOn = DateTime.UtcNow;
+            foreach (var userId in userIds.Distinct())
+            {
+                var record = new InAppNotificationRecord(notif)
+                {
+                    Id = Guid.NewGuid().ToString("N"),
+                    UserId = userId,
+                    CreatedOn = createdOn
+                };
+                var userNotif = new InAppNotification(record) { UserId = "" };
+
+                var sessionIds = (await _userSessions.GetPeers(userId, cancellationToken)).ToList();
+                if (sessionIds.Count > 0)
+                {
+                    await _scene.Send(new MatchArrayFilter(sessionIds), "inappnotification.push", s => serializer.Serialize(userNotif, s), PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE_ORDERED);
+                }
+
+                if (record.Acknowledgment == InAppNotificationAcknowledgment.OnReceive || record.Acknowledgment == InAppNotificationAcknowledgment.ByUser || (sessionIds.Count == 0 && record.Acknowledgment == InAppNotificationAcknowledgment.OnSend))
+                {
+                    await _repository.IndexNotification(record);
+                }
+            }
+        }
+
         private readonly ISceneHost _scene;
         private readonly ISerializer serializer;
         private readonly ILogger _logger;
@@ -78,6 +78,113 @@ namespace Stormancer.Server.Plugins.Notification
             return result.Documents;
         }
 
+        /// <summary>
+        /// Gets the notifications of a user created after a cursor, oldest first.
+        /// </summary>
+        /// <param name="userId"></param>
+        /// <param name="cursor">Cursor returned with the previous page, or null to start from the oldest notification.</param>
+        /// <param name="count"></param>
+        /// <returns>The notifications, and the cursor to continue from. The cursor is returned unchanged if there is no notification after it.</returns>
+        public async Task<(IReadOnlyCollection<InAppNotificationRecord> Records, string? NextCursor)> GetNotificationsAfter(string userId, string? cursor, int count)
+        {
+            var client = await _client;
+
+            var result = await client.SearchAsync<InAppNotificationRecord>(sd => SearchAfter(sd
+                .Size(count)
+                .Sort(ss => ss
+                    .Ascending(p => p.CreatedOn)
+                    .Ascending("id.keyword")
+                )
+                .Query(query => query
+                    .Bool(b => b
+                        .Filter(q => q.Term(tq => tq
+                            .Field("userId.keyword")
+                            .Value(userId)
+                        ))
+                        .MustNot(Expired)
+                    )
+                ), cursor)
+            );
+
+            var nextCursor = result.Hits.Count > 0 ? ToCursor(result.Hits.Last()) : cursor;
+            return (result.Documents, nextCursor);
+        }
+
+        /// <summary>
+        /// Gets a page of the notifications of a user, newest first.
+        /// </summary>
+        /// <param name="userId"></param>
+        /// <param name="cursor">Cursor returned with the previous page, or null for the first page.</param>
+        /// <param name="count"></param>
+        /// <returns>The notifications, and the cursor of the next page if the page is full.</returns>
+        public async Task<(IReadOnlyCollection<InAppNotificationRecord> Records, string? NextCursor)> GetNotificationsPage(string userId, string? cursor, int count)
+        {
+            var client = await _client;
+
+            var result = await client.SearchAsync<InAppNotificationRecord>(sd => SearchAfter(sd
+                .Size(count)
+                .Sort(ss => ss
+                    .Descending(p => p.CreatedOn)
+                    .Descending("id.keyword")
+                )
+                .Query(query => query
+                    .Bool(b => b
+                        .Filter(q => q.Term(tq => tq
+                            .Field("userId.keyword")
+                            .Value(userId)
+                        ))
+                        .MustNot(Expired)
+                    )
+                ), cursor)
+            );
+
+            string? nextCursor = null;
+            if (result.Hits.Count == count)
+            {
+                nextCursor = ToCursor(result.Hits.Last());
+            }
+
+            return (result.Documents, nextCursor);
+        }
+
+        // The cursor is the sort values of the last notification of the previous page: creation date (epoch ms) and id.
+        // Paging on both values doesn't skip or repeat notifications created at the same date.
+        private static SearchDescriptor<InAppNotificationRecord> SearchAfter(SearchDescriptor<InAppNotificationRecord> sd, string? cursor)
+        {
+            if (string.IsNullOrEmpty(cursor))
+            {
+                return sd;
+            }
+
+            var separator = cursor.IndexOf(':');
+            if (separator <= 0 || !long.TryParse(cursor.Substring(0, separator), out var createdOn))
+            {
+                throw new ClientException("Invalid cursor.");
+            }
+            return sd.SearchAfter(createdOn, cursor.Substring(separator + 1));
+        }
+
+        private static string ToCursor(IHit<InAppNotificationRecord> hit)
+        {
+            return string.Join(":", hit.Sorts);
+        }
+
+        private static QueryContainer Expired(QueryContainerDescriptor<InAppNotificationRecord> q)
+        {
+            return q.Bool(b => b
+                .Filter(
+                    f => f.Term(t => t
+                        .Field(p => p.ShouldExpire)
+                        .Value(true)
+                    ),
+                    f => f.DateRange(r => r
+                        .Field(p => p.ExpirationDate)
+                        .LessThan(DateTime.UtcNow)
+                    )
+                )
+            );
+        }
+
         public async Task DeleteNotifications(List<InAppNotificationRecord> expiredNotifs)
         {
             var client = await _client;
@@ -89,5 +196,32 @@ namespace Stormancer.Server.Plugins.Notification
             var client = await _client;
             await client.DeleteAsync<InAppNotificationRecord>(notificationId);
         }
+
+        /// <summary>
+        /// Deletes notifications of a user with a single request.
+        /// </summary>
+        /// <param name="userId">Only the notifications of this user are deleted.</param>
+        /// <param name="notificationIds"></param>
+        /// <returns></returns>
+        public async Task AcknowledgeNotifications(string userId, IEnumerable<string> notificationIds)
+        {
+            var client = await _client;
+            await client.DeleteByQueryAsync<InAppNotificationRecord>(d => d
+                .Query(query => query
+                    .Bool(b => b
+                        .Filter(
+                            q => q.Term(tq => tq
+                                .Field("userId.keyword")
+                                .Value(userId)
+                            ),
+                            q => q.Terms(tq => tq
+                                .Field("id.keyword")
+                                .Terms(notificationIds)
+                            )
+                        )
+                    )
+                )
+            );
+        }
     }
 }
@@ -0,0 +1,55 @@
+// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+using MessagePack;
+using System.Collections.Generic;
+
+namespace Stormancer.Server.Plugins.Notification
+{
+    /// <summary>
+    /// A page of the stored notifications of a user.
+    /// </summary>
+    [MessagePackObject]
+    public class InAppNotificationPage
+    {
+        /// <summary>
+        /// Gets or sets the notifications in the page.
+        /// </summary>
+        [Key(0)]
+        public List<InAppNotification> Notifications { get; set; } = new List<InAppNotification>();
+
+        /// <summary>
+        /// Gets or sets the cursor to request the next page with.
+        /// </summary>
+        /// <remarks>
+        /// Empty on the last history page. Synchronization pages always return the cursor to synchronize from next time.
+        /// Never null, as clients read it as a string.
+        /// </remarks>
+        [Key(1)]
+        public string NextCursor { get; set; } = "";
+
+        /// <summary>
+        /// Gets or sets a <see cref="bool"/> indicating if more notifications match the request.
+        /// </summary>
+        [Key(2)]
+        public bool HasMore { get; set; }
+    }
+}
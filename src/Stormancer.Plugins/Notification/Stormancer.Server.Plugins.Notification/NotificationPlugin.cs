@@ -51,6 +51,7 @@ namespace Stormancer.Server.Plugins.Notification
                 builder.Register<InAppNotificationRepository>();
                 builder.Register<ProxyNotificationChannel>().As<INotificationChannel>().InstancePerDependency();
                 builder.Register<NotificationChannelController>();
+                builder.Register<InAppNotificationController>();
                 builder.Register<InAppNotificationProvider>().As<INotificationProvider>().AsSelf().InstancePerRequest();
                 builder.Register<NotificationLocator>().As<IServiceLocatorProvider>();
             };
@@ -68,6 +69,7 @@ namespace Stormancer.Server.Plugins.Notification
                 if (scene.TemplateMetadata.ContainsKey(METADATA_KEY))
                 {
                     scene.AddController<NotificationChannelController>();
+                    scene.AddController<InAppNotificationController>();
                     // Instantiate InAppNotificationProvider singleton to subscribe to scene events
                     //scene.DependencyResolver.Resolve<InAppNotificationProvider>();
                 }
@@ -22,13 +22,49 @@
 
 #pragma once
 #include "Users/ClientAPI.hpp"
+#include "Users/ConfigurationParameters.hpp"
 #include "stormancer/IPlugin.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 
 namespace Stormancer
 {
 	namespace Notifications
 	{
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Directory where the notifications received by the client are cached between sessions, in one file per user.
+			/// Default is "" (no disk cache).
+			/// </summary>
+			constexpr const char* CacheDirectory = "notifications.cacheDirectory";
+
+			/// <summary>
+			/// Maximum number of notifications kept by the client. The oldest ones are dropped first.
+			/// Default is "500".
+			/// </summary>
+			constexpr const char* MaxNotifications = "notifications.maxNotifications";
+
+			/// <summary>
+			/// Time in milliseconds during which acknowledgements are collected before being sent to the server in a single request.
+			/// Default is "100".
+			/// </summary>
+			constexpr const char* AcknowledgementWindowMs = "notifications.acknowledgementWindowMs";
+
+			/// <summary>
+			/// Prefix of the RetryPolicyOptions keys of acknowledgement requests, for instance "notifications.acknowledge.retry.maxAttempts".
+			/// Acknowledgements still failing after the last attempt are sent again on the next connection.
+			/// </summary>
+			constexpr const char* AcknowledgementRetryPrefix = "notifications.acknowledge";
+		}
+
 		/// <summary>
 		/// Type of acknowledgement for a notification.
 		/// </summary>
@@ -114,6 +150,24 @@ namespace Stormancer
 			MSGPACK_DEFINE(id, type, userId, message, data, createdOn, shouldExpire, expirationDate, dismissalMode, dismissalActions);
 		};
 
+		/// <summary>
+		/// A page of the notifications stored on the server.
+		/// </summary>
+		struct InAppNotificationPage
+		{
+			std::vector<InAppNotification> notifications;
+
+			/// <summary>
+			/// Cursor to pass to <c>NotificationsApi::getHistory()</c> to get the next page. Empty on the last page.
+			/// For synchronization pages, the cursor to synchronize from on the next connection.
+			/// </summary>
+			std::string nextCursor;
+
+			bool hasMore = false;
+
+			MSGPACK_DEFINE(notifications, nextCursor, hasMore);
+		};
+
 		class NotificationsPlugin;
 
 		namespace details
@@ -129,9 +183,21 @@ namespace Stormancer
 				{
 				}
 
-				pplx::task<void> dismissNotification(const std::string& notificationId)
+				pplx::task<void> acknowledge(const std::vector<std::string>& notificationIds)
 				{
-					return rpc->rpc<void, std::string>("inappnotification.acknowledgenotification", notificationId);
+					return rpc->rpc<void, std::vector<std::string>>("inappnotification.acknowledge", notificationIds);
+				}
+
+				// Stored notifications created after the cursor, oldest first.
+				pplx::task<InAppNotificationPage> sync(const std::string& cursor, int count)
+				{
+					return rpc->rpc<InAppNotificationPage>("inappnotification.sync", cursor, count);
+				}
+
+				// Stored notifications, newest first.
+				pplx::task<InAppNotificationPage> getHistory(const std::string& cursor, int count)
+				{
+					return rpc->rpc<InAppNotificationPage>("inappnotification.history", cursor, count);
 				}
 
 				Stormancer::Subscription subscribe(std::function<void(std::vector<InAppNotification>)> callback)
@@ -185,13 +251,34 @@ namespace Stormancer
 		/// <summary>
 		/// Notifications API.
 		/// </summary>
-		class NotificationsApi
+		/// <remarks>
+		/// Notifications are kept ordered by creation date. On connection, the client only retrieves the notifications
+		/// stored since its last synchronization. When <c>ConfigurationKeys::CacheDirectory</c> is set, the notifications are cached on disk for each user.
+		/// </remarks>
+		class NotificationsApi : public std::enable_shared_from_this<NotificationsApi>
 		{
 			friend NotificationsPlugin;
 		public:
-			NotificationsApi(std::shared_ptr<ILogger> logger)
+			NotificationsApi(std::shared_ptr<ILogger> logger, std::shared_ptr<Configuration> config, std::weak_ptr<Users::UsersApi> users)
 				: logger(logger)
+				, users(users)
 			{
+				auto it = config->additionalParameters.find(ConfigurationKeys::CacheDirectory);
+				if (it != config->additionalParameters.end())
+				{
+					cacheDirectory = it->second;
+				}
+
+				maxNotifications = std::max<std::size_t>(readConfigurationParameter(config, ConfigurationKeys::MaxNotifications, maxNotifications), 1);
+				acknowledgementWindow = readConfigurationParameter(config, ConfigurationKeys::AcknowledgementWindowMs, acknowledgementWindow);
+
+				if (auto usersApi = users.lock())
+				{
+					RetryPolicyOptions retryOptions;
+					retryOptions.baseDelay = std::chrono::milliseconds(500);
+					retryOptions.maxAttempts = 3;
+					acknowledgementRetryPolicy = usersApi->createRetryPolicy(ConfigurationKeys::AcknowledgementRetryPrefix, retryOptions);
+				}
 			}
 
 			/// <summary>
@@ -206,7 +293,7 @@ namespace Stormancer
 				auto current = get();
 				if (current.size() > 0)
 				{
-					callback(get());
+					callback(current);
 				}
 				return sub;
 			}
@@ -217,57 +304,127 @@ namespace Stormancer
 			/// <returns></returns>
 			bool available()
 			{
+				std::lock_guard<std::mutex> lg(mutex);
 				return service != nullptr;
 			}
 
+			/// <summary>
+			/// Gets the notifications known by the client, newest first.
+			/// </summary>
+			/// <returns></returns>
 			std::vector<InAppNotification> get()
 			{
+				std::lock_guard<std::mutex> lg(mutex);
 				std::vector<InAppNotification> result;
-				for (auto& notification : notifications)
+				result.reserve(notifications.size());
+				for (auto it = notifications.rbegin(); it != notifications.rend(); ++it)
 				{
-					result.push_back(notification.second);
+					result.push_back(it->second);
 				}
-
-				std::sort(result.begin(), result.end(), [](InAppNotification& first, InAppNotification& second) {
-					return first.createdOn > second.createdOn; //Order descending
-				});
 				return result;
 			}
 
 			/// <summary>
-			/// Acknowledges that a notification was read. The program shall call this function once the user has been presented the notification. 
+			/// Gets a page of the notifications stored on the server for the current user, newest first.
 			/// </summary>
-			/// <param name="notificationId"></param>
-			bool setAsread(const std::string& notificationId)
+			/// <remarks>
+			/// The notifications of the page are added to the ones returned by <c>get()</c>, without raising notification events.
+			/// </remarks>
+			/// <param name="cursor"><c>nextCursor</c> of the previous page, or an empty string to get the first page.</param>
+			/// <param name="count">Maximum number of notifications in the page. The server returns 100 notifications at most.</param>
+			/// <returns></returns>
+			pplx::task<InAppNotificationPage> getHistory(const std::string& cursor = "", int count = 50)
 			{
-				auto it = notifications.find(notificationId);
-				if (it == notifications.end())
+				std::shared_ptr<details::NotificationsService> service;
 				{
-					return false;
+					std::lock_guard<std::mutex> lg(mutex);
+					service = this->service;
+				}
+				if (!service)
+				{
+					STORM_RETURN_TASK_FROM_EXCEPTION(std::runtime_error("Not connected to the notification service"), InAppNotificationPage);
 				}
 
-				if (it->second.dismissalMode == InAppNotificationDismissalType::OnRead)
+				std::weak_ptr<NotificationsApi> wThat = this->shared_from_this();
+				return service->getHistory(cursor, count).then([wThat](InAppNotificationPage page)
 				{
-					if (service == nullptr)
+					if (auto that = wThat.lock())
 					{
-						return false;
+						bool changed = false;
+						{
+							std::lock_guard<std::mutex> lg(that->mutex);
+							for (const auto& notification : page.notifications)
+							{
+								changed |= that->insert(notification);
+							}
+						}
+						if (changed)
+						{
+							that->saveCache();
+						}
 					}
+					return page;
+				});
+			}
 
-					service->dismissNotification(notificationId).then([logger = this->logger, notificationId](pplx::task<void> t)
+			/// <summary>
+			/// Acknowledges that a notification was read. The program shall call this function once the user has been presented the notification. 
+			/// </summary>
+			/// <param name="notificationId"></param>
+			bool setAsread(const std::string& notificationId)
+			{
+				return setAsread(std::vector<std::string>{ notificationId }) == 1;
+			}
+
+			/// <summary>
+			/// Acknowledges that several notifications were read.
+			/// </summary>
+			/// <remarks>
+			/// Acknowledgements are sent to the server in batches. They are kept until the server has received them, and sent again on reconnection if needed.
+			/// </remarks>
+			/// <param name="notificationIds"></param>
+			/// <returns>The number of notifications found.</returns>
+			std::size_t setAsread(const std::vector<std::string>& notificationIds)
+			{
+				std::size_t found = 0;
+				std::vector<std::string> acknowledgements;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					for (const auto& notificationId : notificationIds)
 					{
-						try
+						auto notification = find(notificationId);
+						if (notification == nullptr)
 						{
-							t.get();
+							continue;
 						}
-						catch (std::exception& ex)
+						found++;
+						if (notification->dismissalMode == InAppNotificationDismissalType::OnRead)
 						{
-							logger->log(LogLevel::Error, "notifications", "An error occured while dismissing notification " + notificationId, ex);
+							acknowledgements.push_back(notificationId);
 						}
-
-					});
+					}
 				}
 
-				return true;
+				queueAcknowledgements(acknowledgements);
+				return found;
+			}
+
+			/// <summary>
+			/// Acknowledges that all the notifications known by the client were read.
+			/// </summary>
+			/// <returns>The number of notifications.</returns>
+			std::size_t markAllAsRead()
+			{
+				std::vector<std::string> notificationIds;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					notificationIds.reserve(notificationKeys.size());
+					for (const auto& key : notificationKeys)
+					{
+						notificationIds.push_back(key.first);
+					}
+				}
+				return setAsread(notificationIds);
 			}
 
 			/// <summary>
@@ -278,76 +435,574 @@ namespace Stormancer
 			/// <returns>A task that completes when the operations is complete..</returns>
 			bool dismiss(const std::string& notificationId, const std::string& /*action*/ = "")
 			{
-				auto it = notifications.find(notificationId);
-				if (it == notifications.end())
-				{
-					return false;
-				}
-
-				notifications.erase(notificationId);
+				return dismiss(std::vector<std::string>{ notificationId }) == 1;
+			}
 
-				if (it->second.dismissalMode == InAppNotificationDismissalType::ByUser)
+			/// <summary>
+			/// Dismisses several notifications and definitely remove them.
+			/// </summary>
+			/// <remarks>
+			/// Acknowledgements are sent to the server in batches. They are kept until the server has received them, and sent again on reconnection if needed.
+			/// </remarks>
+			/// <param name="notificationIds">Ids of the notifications to acknowledge.</param>
+			/// <returns>The number of notifications found.</returns>
+			std::size_t dismiss(const std::vector<std::string>& notificationIds)
+			{
+				std::size_t found = 0;
+				std::vector<std::string> acknowledgements;
 				{
-					if (service == nullptr)
+					std::lock_guard<std::mutex> lg(mutex);
+					for (const auto& notificationId : notificationIds)
 					{
-						return false;
-					}
-					service->dismissNotification(notificationId)
-						.then([logger = this->logger, notificationId](pplx::task<void> t)
-					{
-						try
+						auto notification = find(notificationId);
+						if (notification == nullptr)
 						{
-							t.get();
+							continue;
 						}
-						catch (std::exception& ex)
+						found++;
+						if (notification->dismissalMode == InAppNotificationDismissalType::ByUser)
 						{
-							logger->log(LogLevel::Error, "notifications", "An error occured while dismissing notification " + notificationId, ex);
+							acknowledgements.push_back(notificationId);
 						}
-					});
+						erase(notificationId);
+					}
 				}
 
-				return true;
+				if (found > 0)
+				{
+					saveCache();
+				}
+				queueAcknowledgements(acknowledgements);
+				return found;
+			}
+
+			/// <summary>
+			/// Gets the number of acknowledgements not yet received by the server.
+			/// </summary>
+			std::size_t pendingAcknowledgements()
+			{
+				std::lock_guard<std::mutex> lg(mutex);
+				return acknowledgementQueue.size() + acknowledgementsInFlight.size();
 			}
 
 		private:
 
+			// Creation date, then id to tell apart the notifications created at the same date.
+			using NotificationKey = std::pair<int64, std::string>;
+
+			// Caches of other versions are ignored.
+			static constexpr int32 CacheVersion = 2;
+
+			// Format of the disk cache
+			struct CacheFile
+			{
+				int32 version = CacheVersion;
+				std::string syncCursor;
+				std::vector<InAppNotification> notifications;
+				std::vector<std::string> pendingAcknowledgements;
+
+				MSGPACK_DEFINE(version, syncCursor, notifications, pendingAcknowledgements);
+			};
+
+			static constexpr int SyncPageSize = 100;
+			static constexpr std::size_t MaxAcknowledgementBatchSize = 100;
+
 			void Initialize(std::shared_ptr<details::NotificationsService> notificationService)
 			{
-				this->service = notificationService;
+				std::string userId;
+				if (auto usersApi = users.lock())
+				{
+					userId = usersApi->userId();
+				}
+
+				std::shared_ptr<CacheSnapshot> previousUserCache;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					this->service = notificationService;
+					if (userId != currentUserId)
+					{
+						// Changes of the previous user not saved yet
+						if (cacheSaveScheduled)
+						{
+							previousUserCache = takeCacheSnapshot();
+						}
+
+						// The notifications are those of another user.
+						notifications.clear();
+						notificationKeys.clear();
+						acknowledgementQueue.clear();
+						// Acknowledgements of the previous user still in flight are not sent again for this one.
+						acknowledgementsInFlight.clear();
+						acknowledgementIds.clear();
+						syncCursor.clear();
+						currentUserId = userId;
+						loadCache();
+					}
+				}
+				if (previousUserCache)
+				{
+					writeCacheAsync(previousUserCache);
+				}
+
 				using std::placeholders::_1;
-				notificationReceivedByClientSubscription = service->subscribe(std::bind(&NotificationsApi::onNotificationsReceived, this, _1));
+				notificationReceivedByClientSubscription = notificationService->subscribe(std::bind(&NotificationsApi::onNotificationsReceived, this, _1));
+				sync(notificationService);
+				// Acknowledgements that could not be sent during the previous connection
+				sendAcknowledgements();
 			}
 
 			void shutdown()
 			{
 				//Unsubscribe.
 				notificationReceivedByClientSubscription = nullptr;
-				service = nullptr;
+				std::shared_ptr<CacheSnapshot> cache;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					service = nullptr;
+					if (cacheSaveScheduled)
+					{
+						cache = takeCacheSnapshot();
+					}
+				}
+				if (cache)
+				{
+					writeCacheAsync(cache);
+				}
+			}
+
+			// Retrieves the notifications stored since the last synchronization, one page at a time.
+			void sync(std::shared_ptr<details::NotificationsService> notificationService)
+			{
+				std::string cursor;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					cursor = syncCursor;
+				}
+
+				std::weak_ptr<NotificationsApi> wThat = this->shared_from_this();
+				notificationService->sync(cursor, SyncPageSize).then([wThat, notificationService, cursor](pplx::task<InAppNotificationPage> task)
+				{
+					auto that = wThat.lock();
+					if (!that)
+					{
+						return;
+					}
+
+					try
+					{
+						auto page = task.get();
+						that->onNotificationsReceived(page.notifications);
+
+						// Notifications acknowledged on send were stored because they could not be sent. The server deletes them once we confirm we received them.
+						std::vector<std::string> received;
+						for (const auto& notification : page.notifications)
+						{
+							if (notification.dismissalMode == InAppNotificationDismissalType::OnSend)
+							{
+								received.push_back(notification.id);
+							}
+						}
+						that->queueAcknowledgements(received);
+
+						bool next;
+						{
+							std::lock_guard<std::mutex> lg(that->mutex);
+							if (that->service != notificationService)
+							{
+								return;
+							}
+							if (!page.nextCursor.empty())
+							{
+								that->syncCursor = page.nextCursor;
+							}
+							next = page.hasMore && page.nextCursor != cursor;
+						}
+						that->saveCache();
+						if (next)
+						{
+							that->sync(notificationService);
+						}
+					}
+					catch (const std::exception& ex)
+					{
+						that->logger->log(LogLevel::Warn, "notifications", "Failed to synchronize the notifications", ex);
+					}
+				});
 			}
 
 			void onNotificationsReceived(std::vector<InAppNotification> pendingNotifications)
 			{
 				std::vector<InAppNotification> newNotifications;
-				for (auto& notification : pendingNotifications)
 				{
-					if (this->notifications.find(notification.id) == this->notifications.end())
+					std::lock_guard<std::mutex> lg(mutex);
+					for (auto& notification : pendingNotifications)
 					{
-						this->notifications[notification.id] = notification;
-						newNotifications.push_back(notification);
+						if (insert(notification))
+						{
+							newNotifications.push_back(notification);
+						}
 					}
 				}
 
 				if (newNotifications.size() > 0)
 				{
+					saveCache();
 					notificationReceived(newNotifications);
 				}
 			}
 
+			void queueAcknowledgements(const std::vector<std::string>& notificationIds)
+			{
+				if (notificationIds.empty())
+				{
+					return;
+				}
+
+				bool schedule = false;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					for (const auto& notificationId : notificationIds)
+					{
+						if (acknowledgementIds.insert(notificationId).second)
+						{
+							acknowledgementQueue.push_back(notificationId);
+						}
+					}
+					schedule = !acknowledgementScheduled;
+					acknowledgementScheduled = true;
+				}
+				saveCache();
+
+				if (!schedule)
+				{
+					return;
+				}
+
+				// Acknowledgements queued during the window are sent with this one.
+				std::weak_ptr<NotificationsApi> wThat = this->shared_from_this();
+				taskDelay(acknowledgementWindow).then([wThat]()
+				{
+					if (auto that = wThat.lock())
+					{
+						{
+							std::lock_guard<std::mutex> lg(that->mutex);
+							that->acknowledgementScheduled = false;
+						}
+						that->sendAcknowledgements();
+					}
+				});
+			}
+
+			// Sends the queued acknowledgements, one batch at a time.
+			void sendAcknowledgements()
+			{
+				std::shared_ptr<details::NotificationsService> service;
+				std::vector<std::string> batch;
+				std::string userId;
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					if (!this->service || !acknowledgementsInFlight.empty() || acknowledgementQueue.empty())
+					{
+						return;
+					}
+					service = this->service;
+					// std::min takes references: a copy avoids odr-using the constant, which has no definition before C++17.
+					std::size_t maxBatchSize = MaxAcknowledgementBatchSize;
+					auto count = std::min(acknowledgementQueue.size(), maxBatchSize);
+					batch.assign(acknowledgementQueue.begin(), acknowledgementQueue.begin() + count);
+					acknowledgementQueue.erase(acknowledgementQueue.begin(), acknowledgementQueue.begin() + count);
+					acknowledgementsInFlight = batch;
+					userId = currentUserId;
+				}
+
+				std::weak_ptr<NotificationsApi> wThat = this->shared_from_this();
+				acknowledgementRetryPolicy.execute<void>([service, batch](pplx::cancellation_token)
+				{
+					return service->acknowledge(batch);
+				}).then([wThat, batch, userId](pplx::task<void> task)
+				{
+					auto that = wThat.lock();
+					if (!that)
+					{
+						return;
+					}
+
+					bool succeeded = true;
+					try
+					{
+						task.get();
+					}
+					catch (const std::exception& ex)
+					{
+						succeeded = false;
+						that->logger->log(LogLevel::Warn, "notifications", "Failed to acknowledge " + std::to_string(batch.size()) + " notifications. They will be sent again on the next connection.", ex);
+					}
+
+					{
+						std::lock_guard<std::mutex> lg(that->mutex);
+						if (that->currentUserId != userId)
+						{
+							// The batch was cleared with the notifications of its user.
+							return;
+						}
+						if (succeeded)
+						{
+							for (const auto& notificationId : batch)
+							{
+								that->acknowledgementIds.erase(notificationId);
+							}
+						}
+						else
+						{
+							that->acknowledgementQueue.insert(that->acknowledgementQueue.begin(), batch.begin(), batch.end());
+						}
+						that->acknowledgementsInFlight.clear();
+					}
+					that->saveCache();
+
+					if (succeeded)
+					{
+						that->sendAcknowledgements();
+					}
+				});
+			}
+
+			// Requires mutex
+			InAppNotification* find(const std::string& notificationId)
+			{
+				auto it = notificationKeys.find(notificationId);
+				if (it == notificationKeys.end())
+				{
+					return nullptr;
+				}
+				return &notifications.at(NotificationKey(it->second, notificationId));
+			}
+
+			// Requires mutex
+			bool insert(const InAppNotification& notification)
+			{
+				if (!notificationKeys.emplace(notification.id, notification.createdOn).second)
+				{
+					return false;
+				}
+				notifications.emplace(NotificationKey(notification.createdOn, notification.id), notification);
+
+				while (notifications.size() > maxNotifications)
+				{
+					auto oldest = notifications.begin();
+					notificationKeys.erase(oldest->first.second);
+					notifications.erase(oldest);
+				}
+				return true;
+			}
+
+			// Requires mutex
+			void erase(const std::string& notificationId)
+			{
+				auto it = notificationKeys.find(notificationId);
+				if (it != notificationKeys.end())
+				{
+					notifications.erase(NotificationKey(it->second, notificationId));
+					notificationKeys.erase(it);
+				}
+			}
+
+			// Requires mutex
+			std::string cachePath() const
+			{
+				if (cacheDirectory.empty() || currentUserId.empty())
+				{
+					return "";
+				}
+				return cacheDirectory + "/notifications_" + currentUserId + ".bin";
+			}
+
+			// Requires mutex
+			void loadCache()
+			{
+				auto path = cachePath();
+				if (path.empty())
+				{
+					return;
+				}
+
+				std::ifstream file(path, std::ios::binary);
+				if (!file)
+				{
+					return;
+				}
+
+				try
+				{
+					std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+					auto handle = msgpack::unpack(content.data(), content.size());
+					CacheFile cache;
+					handle.get().convert(cache);
+					if (cache.version != CacheVersion)
+					{
+						return;
+					}
+
+					for (const auto& notification : cache.notifications)
+					{
+						insert(notification);
+					}
+					syncCursor = cache.syncCursor;
+					acknowledgementQueue = cache.pendingAcknowledgements;
+					acknowledgementIds.insert(acknowledgementQueue.begin(), acknowledgementQueue.end());
+				}
+				catch (const std::exception& ex)
+				{
+					logger->log(LogLevel::Warn, "notifications", "Failed to read the notifications cache " + path, ex);
+				}
+			}
+
+			// Schedules a write of the disk cache. Changes made until the write are saved with it.
+			void saveCache()
+			{
+				{
+					std::lock_guard<std::mutex> lg(mutex);
+					if (cachePath().empty() || cacheSaveScheduled)
+					{
+						return;
+					}
+					cacheSaveScheduled = true;
+				}
+
+				// The file is written from a thread pool thread, not from the network or game thread that changed the notifications.
+				std::weak_ptr<NotificationsApi> wThat = this->shared_from_this();
+				taskDelay(cacheSaveDelay).then([wThat]()
+				{
+					if (auto that = wThat.lock())
+					{
+						std::shared_ptr<CacheSnapshot> cache;
+						{
+							std::lock_guard<std::mutex> lg(that->mutex);
+							if (!that->cacheSaveScheduled)
+							{
+								// Already saved on shutdown or user switch
+								return;
+							}
+							cache = that->takeCacheSnapshot();
+						}
+						if (cache)
+						{
+							that->writeCache(*cache);
+						}
+					}
+				});
+			}
+
+			struct CacheSnapshot
+			{
+				std::string path;
+				uint64 generation = 0;
+				CacheFile content;
+			};
+
+			// Requires mutex
+			std::shared_ptr<CacheSnapshot> takeCacheSnapshot()
+			{
+				cacheSaveScheduled = false;
+				auto snapshot = std::make_shared<CacheSnapshot>();
+				snapshot->path = cachePath();
+				if (snapshot->path.empty())
+				{
+					return nullptr;
+				}
+				snapshot->generation = ++cacheGeneration;
+				auto& cache = snapshot->content;
+				cache.syncCursor = syncCursor;
+				cache.notifications.reserve(notifications.size());
+				for (const auto& notification : notifications)
+				{
+					cache.notifications.push_back(notification.second);
+				}
+				cache.pendingAcknowledgements = acknowledgementsInFlight;
+				cache.pendingAcknowledgements.insert(cache.pendingAcknowledgements.end(), acknowledgementQueue.begin(), acknowledgementQueue.end());
+				return snapshot;
+			}
+
+			void writeCacheAsync(std::shared_ptr<CacheSnapshot> cache)
+			{
+				auto that = this->shared_from_this();
+				pplx::create_task([that, cache]()
+				{
+					that->writeCache(*cache);
+				});
+			}
+
+			void writeCache(const CacheSnapshot& cache)
+			{
+				// Writes are serialized, and a snapshot older than the last one written is dropped.
+				std::lock_guard<std::mutex> lg(cacheWriteMutex);
+				auto& writtenGeneration = writtenCacheGenerations[cache.path];
+				if (cache.generation <= writtenGeneration)
+				{
+					return;
+				}
+
+				msgpack::sbuffer buffer;
+				msgpack::pack(buffer, cache.content);
+
+				// The cache is written to a temporary file first, so that a failed write doesn't leave a truncated cache.
+				auto tempPath = cache.path + ".tmp";
+				{
+					std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+					if (!file.write(buffer.data(), buffer.size()))
+					{
+						logger->log(LogLevel::Warn, "notifications", "Failed to write the notifications cache " + tempPath);
+						return;
+					}
+				}
+				// rename() doesn't replace an existing file on every platform.
+				if (std::rename(tempPath.c_str(), cache.path.c_str()) != 0)
+				{
+					std::remove(cache.path.c_str());
+					if (std::rename(tempPath.c_str(), cache.path.c_str()) != 0)
+					{
+						logger->log(LogLevel::Warn, "notifications", "Failed to replace the notifications cache " + cache.path);
+						return;
+					}
+				}
+				writtenGeneration = cache.generation;
+			}
+
 			Stormancer::Subscription notificationReceivedByClientSubscription;
-			std::unordered_map<std::string, InAppNotification> notifications;
+
+			std::mutex mutex;
+			// Ordered by creation date
+			std::map<NotificationKey, InAppNotification> notifications;
+			// Creation date by notification id
+			std::unordered_map<std::string, int64> notificationKeys;
+			// Position of the last synchronization in the stored notifications of the current user, returned by the server. Stored notifications are synchronized from there on connection.
+			std::string syncCursor;
+			std::string currentUserId;
+
 			Event< std::vector<InAppNotification>> notificationReceived;
 			std::shared_ptr<details::NotificationsService> service;
 			std::shared_ptr<ILogger> logger;
+			std::weak_ptr<Users::UsersApi> users;
+			std::string cacheDirectory;
+			std::size_t maxNotifications = 500;
+
+			// Ids of the notifications to acknowledge, in order
+			std::vector<std::string> acknowledgementQueue;
+			std::vector<std::string> acknowledgementsInFlight;
+			// Ids of the queued and in flight acknowledgements
+			std::unordered_set<std::string> acknowledgementIds;
+			bool acknowledgementScheduled = false;
+			std::chrono::milliseconds acknowledgementWindow = std::chrono::milliseconds(100);
+			RetryPolicy acknowledgementRetryPolicy;
+
+			// Changes are saved to the disk cache at most once per cacheSaveDelay.
+			std::chrono::milliseconds cacheSaveDelay = std::chrono::milliseconds(1000);
+			bool cacheSaveScheduled = false;
+			// Incremented with each snapshot of the cache
+			uint64 cacheGeneration = 0;
+			std::mutex cacheWriteMutex;
+			// Generation of the last snapshot written, by cache file
+			std::unordered_map<std::string, uint64> writtenCacheGenerations;
 		};
 
 		class NotificationsPlugin : public Stormancer::IPlugin
@@ -379,7 +1034,7 @@ namespace Stormancer
 
 			void registerClientDependencies(Stormancer::ContainerBuilder& builder) override
 			{
-				builder.registerDependency<Stormancer::Notifications::NotificationsApi, Stormancer::ILogger>().as<NotificationsApi>().singleInstance();
+				builder.registerDependency<Stormancer::Notifications::NotificationsApi, Stormancer::ILogger, Stormancer::Configuration, Users::UsersApi>().as<NotificationsApi>().singleInstance();
 			}
 
 			void sceneCreated(std::shared_ptr<Scene> scene) override
@@ -0,0 +1,71 @@
+﻿// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+using MessagePack;
+using System.Collections.Generic;
+
+namespace Stormancer.Server.Plugins.Party.Dto
+{
+    /// <summary>
+    /// A party state update, as it was originally broadcast to the members.
+    /// </summary>
+    [MessagePackObject]
+    public class PartyStateDeltaDto
+    {
+        /// <summary>
+        /// Party state version produced by this update.
+        /// </summary>
+        [Key(0)]
+        public int Version { get; set; }
+
+        /// <summary>
+        /// Client route the update was originally sent on.
+        /// </summary>
+        [Key(1)]
+        public required string Route { get; set; }
+
+        /// <summary>
+        /// Serialized update, without the version number prefix.
+        /// </summary>
+        [Key(2)]
+        public required byte[] Payload { get; set; }
+    }
+
+    /// <summary>
+    /// Answer to a <c>party.getstatedeltas</c> request.
+    /// </summary>
+    [MessagePackObject]
+    public class PartyStateDeltasDto
+    {
+        /// <summary>
+        /// If true, the missing updates are no longer available and the client must request the full party state.
+        /// </summary>
+        [Key(0)]
+        public bool FullStateRequired { get; set; }
+
+        /// <summary>
+        /// Updates to apply, in version order.
+        /// </summary>
+        [Key(1)]
+        public List<PartyStateDeltaDto> Deltas { get; set; } = new List<PartyStateDeltaDto>();
+    }
+}
@@ -0,0 +1,203 @@
+﻿// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+using MessagePack;
+using Stormancer.Server.Plugins.Party.Model;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace Stormancer.Server.Plugins.Party.Dto
+{
+    /// <summary>
+    /// A range of bytes to overwrite in a party member's data.
+    /// </summary>
+    [MessagePackObject]
+    public class PartyUserDataPatchRange
+    {
+        /// <summary>
+        /// Position of the first byte to overwrite.
+        /// </summary>
+        [Key(0)]
+        public int Offset { get; set; }
+
+        /// <summary>
+        /// New content of the range.
+        /// </summary>
+        [Key(1)]
+        public byte[] Bytes { get; set; } = Array.Empty<byte>();
+    }
+
+    /// <summary>
+    /// Binary delta between two versions of a party member's data.
+    /// </summary>
+    /// <remarks>
+    /// The base data is resized to <see cref="NewLength"/>, then each range of <see cref="Ranges"/> is copied over it.
+    /// </remarks>
+    [MessagePackObject]
+    public class PartyUserDataPatch
+    {
+        // Equal runs shorter than this are merged into the surrounding ranges: each range costs a few bytes of framing.
+        private const int MinGap = 8;
+
+        /// <summary>
+        /// Length of the data after the patch is applied.
+        /// </summary>
+        [Key(0)]
+        public int NewLength { get; set; }
+
+        /// <summary>
+        /// Ranges to overwrite, in increasing offset order.
+        /// </summary>
+        [Key(1)]
+        public List<PartyUserDataPatchRange> Ranges { get; set; } = new List<PartyUserDataPatchRange>();
+
+        /// <summary>
+        /// Approximate serialized size of the patch, used to decide whether sending it is worth it.
+        /// </summary>
+        [IgnoreMember]
+        public int EstimatedSize => 8 + Ranges.Sum(r => r.Bytes.Length + 8);
+
+        /// <summary>
+        /// Computes the patch that turns <paramref name="oldData"/> into <paramref name="newData"/>.
+        /// </summary>
+        public static PartyUserDataPatch Compute(byte[] oldData, byte[] newData)
+        {
+            var patch = new PartyUserDataPatch { NewLength = newData.Length };
+            var commonLength = Math.Min(oldData.Length, newData.Length);
+
+            var i = 0;
+            while (i < commonLength)
+            {
+                if (oldData[i] == newData[i])
+                {
+                    i++;
+                    continue;
+                }
+
+                var start = i;
+                var end = i + 1;
+                var equalRun = 0;
+                for (var j = end; j < commonLength && equalRun < MinGap; j++)
+                {
+                    if (oldData[j] == newData[j])
+                    {
+                        equalRun++;
+                    }
+                    else
+                    {
+                        equalRun = 0;
+                        end = j + 1;
+                    }
+                }
+                patch.Ranges.Add(new PartyUserDataPatchRange { Offset = start, Bytes = newData[start..end] });
+                i = end;
+            }
+
+            if (newData.Length > commonLength)
+            {
+                var last = patch.Ranges.LastOrDefault();
+                if (last != null && last.Offset + last.Bytes.Length + MinGap >= commonLength)
+                {
+                    last.Bytes = newData[last.Offset..];
+                }
+                else
+                {
+                    patch.Ranges.Add(new PartyUserDataPatchRange { Offset = commonLength, Bytes = newData[commonLength..] });
+                }
+            }
+
+            return patch;
+        }
+
+        /// <summary>
+        /// Applies the patch to <paramref name="baseData"/>.
+        /// </summary>
+        /// <returns>false if the patch is malformed.</returns>
+        public bool TryApply(byte[] baseData, out byte[] result)
+        {
+            result = Array.Empty<byte>();
+            if (NewLength < 0)
+            {
+                return false;
+            }
+
+            var data = new byte[NewLength];
+            Array.Copy(baseData, data, Math.Min(baseData.Length, NewLength));
+            foreach (var range in Ranges)
+            {
+                if (range.Offset < 0 || range.Bytes == null || range.Offset + range.Bytes.Length > NewLength)
+                {
+                    return false;
+                }
+                Array.Copy(range.Bytes, 0, data, range.Offset, range.Bytes.Length);
+            }
+
+            result = data;
+            return true;
+        }
+
+        /// <summary>
+        /// 64 bits FNV-1a hash of member data, used by clients to prove which version a patch applies to.
+        /// </summary>
+        public static ulong Hash(byte[] data) => Fnv1a.Hash(data);
+    }
+
+    /// <summary>
+    /// Member data update sent as a patch against the data of the previous party state version.
+    /// </summary>
+    /// <remarks>
+    /// Only sent to members who called <c>Party.EnableUserDataPatches</c>. Others receive <see cref="PartyMemberDataUpdate"/>.
+    /// </remarks>
+    [MessagePackObject]
+    public class PartyMemberDataPatch
+    {
+        /// <summary>
+        /// Member data patched route.
+        /// </summary>
+        public const string Route = "party.memberDataPatched";
+
+        /// <summary>
+        /// The user Id.
+        /// </summary>
+        [Key(0)]
+        public string UserId { get; set; } = default!;
+
+        /// <summary>
+        /// Patch to apply to the member's current data.
+        /// </summary>
+        [Key(1)]
+        public PartyUserDataPatch Patch { get; set; } = default!;
+
+        /// <summary>
+        /// Local players associated with the party member.
+        /// </summary>
+        [Key(2)]
+        public IEnumerable<Models.LocalPlayerInfos> LocalPlayers { get; set; } = Enumerable.Empty<Models.LocalPlayerInfos>();
+
+        /// <summary>
+        /// Represents the connection status of the member.
+        /// </summary>
+        [Key(3)]
+        public PartyMemberConnectionStatus ConnectionStatus { get; set; }
+    }
+}
@@ -77,6 +77,28 @@ namespace Stormancer.Server.Plugins.Party
         /// <returns></returns>
         Task UpdatePartyUserData(string userId, byte[] data, List<Models.LocalPlayerInfos> localPlayers, CancellationToken ct);
 
+        /// <summary>
+        /// Updates party user data by applying a patch to the current data.
+        /// </summary>
+        /// <remarks>
+        /// Fails with <c>party.userDataPatchMismatch</c> if the current data does not match <paramref name="baseHash"/>. The caller should then send the full data.
+        /// </remarks>
+        /// <param name="userId"></param>
+        /// <param name="baseHash"><see cref="PartyUserDataPatch.Hash(byte[])"/> of the data the patch was computed from.</param>
+        /// <param name="patch"></param>
+        /// <param name="localPlayers"></param>
+        /// <param name="ct"></param>
+        /// <returns></returns>
+        Task UpdatePartyUserDataPatch(string userId, ulong baseHash, PartyUserDataPatch patch, List<Models.LocalPlayerInfos> localPlayers, CancellationToken ct);
+
+        /// <summary>
+        /// Sends the data updates of other members to a member as patches from now on.
+        /// </summary>
+        /// <param name="userId"></param>
+        /// <param name="ct"></param>
+        /// <returns></returns>
+        Task EnableUserDataPatches(string userId, CancellationToken ct);
+
         /// <summary>
         /// Promotes an user as leader.
         /// </summary>
@@ -120,6 +142,16 @@ namespace Stormancer.Server.Plugins.Party
         /// <returns>Task that completes when the party state has been sent.</returns>
         Task SendPartyStateAsRequestAnswer(RequestContext<IScenePeerClient> ctx);
 
+        /// <summary>
+        /// Send the state updates the caller missed since the version given in <paramref name="ctx"/>, as the answer to the RPC.
+        /// </summary>
+        /// <remarks>
+        /// If the updates are no longer in <see cref="PartyState.UpdateLog"/>, the answer asks the client to request the full state instead.
+        /// </remarks>
+        /// <param name="ctx">Context for a client RPC. Its payload is the last state version known by the client.</param>
+        /// <returns>Task that completes when the updates have been sent.</returns>
+        Task SendStateDeltasAsRequestAnswer(RequestContext<IScenePeerClient> ctx);
+
         /// <summary>
         /// Check whether the given user has the permission to send invitations to the party.
         /// </summary>
@@ -101,6 +101,11 @@ namespace Stormancer.Server.Plugins.Party.Model
         /// </summary>
         public PartyMemberConnectionStatus ConnectionStatus { get; set; }
 
+        /// <summary>
+        /// Gets or sets a value indicating whether the member's client accepts data updates of other members as <see cref="Dto.PartyMemberDataPatch"/>.
+        /// </summary>
+        public bool AcceptsUserDataPatches { get; set; }
+
         /// <summary>
         /// Gets the date the party member was added to the party.
         /// </summary>
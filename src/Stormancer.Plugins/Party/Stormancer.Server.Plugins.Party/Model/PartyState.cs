@@ -90,6 +90,14 @@ namespace Stormancer.Server.Plugins.Party.Model
         /// </remarks>
         public TaskQueue TaskQueue { get; } = new TaskQueue();
 
+        /// <summary>
+        /// Recent state updates, replayed to clients that missed some of them.
+        /// </summary>
+        /// <remarks>
+        /// Like the rest of the state, it must only be accessed from <see cref="TaskQueue"/>.
+        /// </remarks>
+        public PartyUpdateLog UpdateLog { get; } = new PartyUpdateLog();
+
         /// <summary>
         /// The FindGame request that is currently running for this party.
         /// </summary>
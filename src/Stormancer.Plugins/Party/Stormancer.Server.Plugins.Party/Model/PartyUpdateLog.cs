@@ -0,0 +1,117 @@
+﻿// MIT License
+//
+// Copyright (c) 2019 Stormancer
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+using System.Collections.Generic;
+
+namespace Stormancer.Server.Plugins.Party.Model
+{
+    /// <summary>
+    /// A state update notification that was broadcast to the party members.
+    /// </summary>
+    public class PartyUpdateLogEntry
+    {
+        /// <summary>
+        /// Party state version produced by this update.
+        /// </summary>
+        public required int Version { get; init; }
+
+        /// <summary>
+        /// Client route and serialized update payload, per recipient user id.
+        /// </summary>
+        /// <remarks>
+        /// The route may differ between recipients, for instance when some of them receive member data as a patch.
+        /// </remarks>
+        public required Dictionary<string, (string Route, byte[] Payload)> UpdatesPerUser { get; init; }
+    }
+
+    /// <summary>
+    /// Bounded history of the most recent party state updates.
+    /// </summary>
+    /// <remarks>
+    /// Clients that missed one or more updates can replay the missing entries instead of downloading the whole party state.
+    /// Must only be accessed from the party's task queue.
+    /// </remarks>
+    public class PartyUpdateLog
+    {
+        private readonly LinkedList<PartyUpdateLogEntry> _entries = new LinkedList<PartyUpdateLogEntry>();
+
+        /// <summary>
+        /// Maximum number of updates kept in the log.
+        /// </summary>
+        public int Capacity { get; set; } = 64;
+
+        /// <summary>
+        /// Records an update, evicting the oldest entries beyond <see cref="Capacity"/>.
+        /// </summary>
+        /// <param name="entry"></param>
+        public void Add(PartyUpdateLogEntry entry)
+        {
+            _entries.AddLast(entry);
+            while (_entries.Count > Capacity)
+            {
+                _entries.RemoveFirst();
+            }
+        }
+
+        /// <summary>
+        /// Gets the updates a user needs to go from <paramref name="sinceVersion"/> to <paramref name="currentVersion"/>.
+        /// </summary>
+        /// <param name="userId">Id of the user requesting the updates.</param>
+        /// <param name="sinceVersion">Last state version known by the user.</param>
+        /// <param name="currentVersion">Current state version of the party.</param>
+        /// <param name="updates">The updates to replay, in order.</param>
+        /// <returns>false if the log does not contiguously cover the requested range for this user.</returns>
+        public bool TryGetUpdatesSince(string userId, int sinceVersion, int currentVersion, out List<(int Version, string Route, byte[] Payload)> updates)
+        {
+            updates = new List<(int, string, byte[])>();
+            if (sinceVersion > currentVersion)
+            {
+                return false;
+            }
+
+            var expected = sinceVersion + 1;
+            foreach (var entry in _entries)
+            {
+                if (entry.Version <= sinceVersion)
+                {
+                    continue;
+                }
+                if (entry.Version != expected || !entry.UpdatesPerUser.TryGetValue(userId, out var update))
+                {
+                    return false;
+                }
+                updates.Add((entry.Version, update.Route, update.Payload));
+                expected++;
+            }
+
+            return expected == currentVersion + 1;
+        }
+
+        /// <summary>
+        /// Removes all entries from the log.
+        /// </summary>
+        public void Clear()
+        {
+            _entries.Clear();
+        }
+    }
+}
@@ -39,7 +39,7 @@ namespace Stormancer.Server.Plugins.Party
     [Service(Named = true, ServiceType = PartyPlugin.PARTY_SERVICEID)]
     class PartyController : ControllerBase
     {
-        public const string PROTOCOL_VERSION = "2022-06-09.1";
+        public const string PROTOCOL_VERSION = "2026-10-18.2";
 
         private const string NotInPartyError = "party.notInParty";
         private const string UnauthorizedError = "party.unauthorized";
@@ -100,6 +100,32 @@ namespace Stormancer.Server.Plugins.Party
             return _partyService.UpdatePartyUserData(member.UserId, data, localPlayers, ctx.CancellationToken);
         }
 
+        [Api(ApiAccess.Public, ApiType.Rpc)]
+        public Task UpdatePartyUserDataPatch(ulong baseHash, PartyUserDataPatch patch, List<Models.LocalPlayerInfos> localPlayers, RequestContext<IScenePeerClient> ctx)
+        {
+            if (!_partyService.PartyMembers.TryGetValue(ctx.RemotePeer.SessionId, out var member))
+            {
+                throw new ClientException(NotInPartyError);
+            }
+
+            return _partyService.UpdatePartyUserDataPatch(member.UserId, baseHash, patch, localPlayers, ctx.CancellationToken);
+        }
+
+        /// <summary>
+        /// Opts the caller in to receiving member data updates as patches.
+        /// </summary>
+        /// <param name="ctx"></param>
+        [Api(ApiAccess.Public, ApiType.Rpc)]
+        public Task EnableUserDataPatches(RequestContext<IScenePeerClient> ctx)
+        {
+            if (!_partyService.PartyMembers.TryGetValue(ctx.RemotePeer.SessionId, out var member))
+            {
+                throw new ClientException(NotInPartyError);
+            }
+
+            return _partyService.EnableUserDataPatches(member.UserId, ctx.CancellationToken);
+        }
+
         public Task PromoteLeader(RequestContext<IScenePeerClient> ctx)
         {
             if (!_partyService.PartyMembers.TryGetValue(ctx.RemotePeer.SessionId, out var member))
@@ -175,6 +201,18 @@ namespace Stormancer.Server.Plugins.Party
             }
         }
 
+        public async Task GetStateDeltas(RequestContext<IScenePeerClient> ctx)
+        {
+            if (_partyService.PartyMembers.ContainsKey(ctx.RemotePeer.SessionId))
+            {
+                await _partyService.SendStateDeltasAsRequestAnswer(ctx);
+            }
+            else
+            {
+                throw new ClientException(NotInPartyError);
+            }
+        }
+
         public async Task SendInvitation(RequestContext<IScenePeerClient> ctx)
         {
             if (_partyService.PartyMembers.TryGetValue(ctx.RemotePeer.SessionId, out var user))
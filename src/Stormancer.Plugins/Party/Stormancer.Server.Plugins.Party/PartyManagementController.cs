@@ -30,6 +30,7 @@ using Stormancer.Server.Plugins.Queries;
 using Stormancer.Server.Plugins.Users;
 using System.Collections.Generic;
 using System.Linq;
+using System.Text;
 using System.Threading;
 using System.Threading.Tasks;
 
@@ -137,6 +138,43 @@ namespace Stormancer.Server.PartyManagement
 
             return new PartySearchResultDto { Total = result.Total, Hits = result.Hits.Select(d => new PartySearchDocumentDto { Id = d.Id, Source = d.Source?.ToString(Newtonsoft.Json.Formatting.None) ?? "{}" }) };
         }
+
+        /// <summary>
+        /// Search for parties, omitting the content of documents the client already has.
+        /// </summary>
+        /// <param name="jsonQuery"></param>
+        /// <param name="skip"></param>
+        /// <param name="size"></param>
+        /// <param name="knownHashes">Hash of the documents the client already has, by party id, as returned by a previous call.</param>
+        /// <param name="cancellationToken"></param>
+        /// <returns></returns>
+        [Api(ApiAccess.Public, ApiType.Rpc)]
+        public async Task<PartySearchChangesDto> SearchPartiesChanged(string jsonQuery, uint skip, uint size, Dictionary<string, ulong> knownHashes, CancellationToken cancellationToken)
+        {
+            var result = await search.SearchParties(JObject.Parse(jsonQuery), skip, size, cancellationToken);
+
+            return new PartySearchChangesDto
+            {
+                Total = result.Total,
+                Hits = result.Hits.Select(d =>
+                {
+                    var source = d.Source?.ToString(Newtonsoft.Json.Formatting.None) ?? "{}";
+                    var hash = ComputeDocumentHash(source);
+                    var unchanged = knownHashes.TryGetValue(d.Id, out var knownHash) && knownHash == hash;
+                    return new PartySearchDocumentChangeDto { Id = d.Id, Hash = hash, Unchanged = unchanged, Source = unchanged ? string.Empty : source };
+                }).ToList()
+            };
+        }
+
+        /// <summary>
+        /// Computes the hash used to detect search documents the client already has.
+        /// </summary>
+        /// <remarks>
+        /// The value is opaque to clients, who only send it back, so it doesn't need to match any client-side implementation.
+        /// </remarks>
+        /// <param name="source">Json content of the document.</param>
+        /// <returns>64 bits FNV-1a hash of the UTF-8 encoded document.</returns>
+        private static ulong ComputeDocumentHash(string source) => Fnv1a.Hash(Encoding.UTF8.GetBytes(source));
     }
 
     /// <summary>
@@ -158,6 +196,56 @@ namespace Stormancer.Server.PartyManagement
         public string Source { get; set; } = default!;
     }
 
+    /// <summary>
+    /// A party search document, as returned by <see cref="PartyManagementController.SearchPartiesChanged"/>.
+    /// </summary>
+    [MessagePackObject]
+    public class PartySearchDocumentChangeDto
+    {
+        /// <summary>
+        /// Id of the party.
+        /// </summary>
+        [Key(0)]
+        public string Id { get; set; } = default!;
+
+        /// <summary>
+        /// Hash of <see cref="Source"/>, to send back in later searches.
+        /// </summary>
+        [Key(1)]
+        public ulong Hash { get; set; }
+
+        /// <summary>
+        /// True if the client already has this version of the document. <see cref="Source"/> is empty in this case.
+        /// </summary>
+        [Key(2)]
+        public bool Unchanged { get; set; }
+
+        /// <summary>
+        /// Json Data associated with the party.
+        /// </summary>
+        [Key(3)]
+        public string Source { get; set; } = default!;
+    }
+
+    /// <summary>
+    /// A party search result that only contains the documents the client does not already have.
+    /// </summary>
+    [MessagePackObject]
+    public class PartySearchChangesDto
+    {
+        /// <summary>
+        /// Total number of documents returned by the search.
+        /// </summary>
+        [Key(0)]
+        public uint Total { get; set; }
+
+        /// <summary>
+        /// Results in the search result.
+        /// </summary>
+        [Key(1)]
+        public List<PartySearchDocumentChangeDto> Hits { get; set; } = default!;
+    }
+
     /// <summary>
     /// A party search result.
     /// </summary>
@@ -34,7 +34,7 @@ namespace Stormancer.Server.PartyManagement
     //Todo jojo need cleanup if the aren't complete session creation
     class PartyManagementService : IPartyManagementService
     {
-        public const string PROTOCOL_VERSION = "2020-05-20.1";
+        public const string PROTOCOL_VERSION = "2026-10-18.1";
 
         private readonly IServiceLocator _serviceLocator;
         private readonly InvitationCodeService invitationCodes;
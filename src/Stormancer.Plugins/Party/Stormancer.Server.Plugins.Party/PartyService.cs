@@ -38,6 +38,7 @@ using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
+using System.IO;
 using System.Linq;
 using System.Reactive.Linq;
 using System.Reactive.Threading.Tasks;
@@ -106,6 +107,7 @@ namespace Stormancer.Server.Plugins.Party
         private const string GameFinderNameError = "party.badArgument.GameFinderName";
         private const string CannotKickLeaderError = "party.cannotKickLeader";
         private const string SettingsOutdatedError = "party.settingsOutdated";
+        private const string UserDataPatchMismatchError = "party.userDataPatchMismatch";
         private const string GenericJoinError = "party.joinError";
 
         private const string LeaderChangedRoute = "party.leaderChanged";
@@ -833,7 +835,49 @@ namespace Stormancer.Server.Plugins.Party
 
 
 
-        public async Task UpdatePartyUserData(string userId, byte[] data, List<Models.LocalPlayerInfos> localPlayers, CancellationToken ct)
+        public Task UpdatePartyUserData(string userId, byte[] data, List<Models.LocalPlayerInfos> localPlayers, CancellationToken ct)
+        {
+            return UpdatePartyUserDataImpl(userId, _ => data, localPlayers, ct);
+        }
+
+        public Task UpdatePartyUserDataPatch(string userId, ulong baseHash, PartyUserDataPatch patch, List<Models.LocalPlayerInfos> localPlayers, CancellationToken ct)
+        {
+            return UpdatePartyUserDataImpl(userId, partyUser =>
+            {
+                var currentData = partyUser.UserData ?? Array.Empty<byte>();
+                if (PartyUserDataPatch.Hash(currentData) != baseHash)
+                {
+                    throw new ClientException(UserDataPatchMismatchError);
+                }
+                if (!patch.TryApply(currentData, out var data))
+                {
+                    throw new ClientException("party.invalidMemberData");
+                }
+                return data;
+            }, localPlayers, ct);
+        }
+
+        public async Task EnableUserDataPatches(string userId, CancellationToken ct)
+        {
+            await _partyState.TaskQueue.PushWork(() =>
+            {
+                if (ct.IsCancellationRequested)
+                {
+                    return Task.CompletedTask;
+                }
+
+                if (!TryGetMemberByUserId(userId, out var partyUser))
+                {
+                    ThrowNoSuchMemberError(userId);
+                }
+
+                partyUser.AcceptsUserDataPatches = true;
+                return Task.CompletedTask;
+            });
+        }
+
+        // getData is called from the task queue, with the member being updated.
+        private async Task UpdatePartyUserDataImpl(string userId, Func<PartyMember, byte[]> getData, List<Models.LocalPlayerInfos> localPlayers, CancellationToken ct)
         {
             await _partyState.TaskQueue.PushWork(async () =>
             {
@@ -847,6 +891,8 @@ namespace Stormancer.Server.Plugins.Party
                     ThrowNoSuchMemberError(userId);
                 }
 
+                var previousData = partyUser.UserData ?? Array.Empty<byte>();
+                var data = getData(partyUser);
 
 
                 var localPlayerCountChanged = !localPlayers.SequenceEqual(partyUser.LocalPlayers);
@@ -889,11 +935,42 @@ namespace Stormancer.Server.Plugins.Party
                         await TryCancelPendingGameFinder();
                     }
 
-                    await BroadcastStateUpdateRpc(PartyMemberDataUpdate.Route, new PartyMemberDataUpdate { UserId = userId, UserData = partyUser.UserData, LocalPlayers = partyUser.LocalPlayers, ConnectionStatus = partyUser.ConnectionStatus });
+                    await BroadcastMemberDataUpdate(partyUser, previousData);
                 }
             });
         }
 
+        // Members who opted in receive a patch against the data they already have, unless it is not smaller than the data itself.
+        private async Task BroadcastMemberDataUpdate(PartyMember partyUser, byte[] previousData)
+        {
+            var fullUpdate = new PartyMemberDataUpdate { UserId = partyUser.UserId, UserData = partyUser.UserData, LocalPlayers = partyUser.LocalPlayers, ConnectionStatus = partyUser.ConnectionStatus };
+            if (!_partyState.PartyMembers.Values.Any(m => m.AcceptsUserDataPatches))
+            {
+                await BroadcastStateUpdateRpc(PartyMemberDataUpdate.Route, fullUpdate);
+                return;
+            }
+
+            var patch = PartyUserDataPatch.Compute(previousData, partyUser.UserData);
+            if (patch.EstimatedSize >= partyUser.UserData.Length)
+            {
+                await BroadcastStateUpdateRpc(PartyMemberDataUpdate.Route, fullUpdate);
+                return;
+            }
+
+            var patchUpdate = new PartyMemberDataPatch { UserId = partyUser.UserId, Patch = patch, LocalPlayers = partyUser.LocalPlayers, ConnectionStatus = partyUser.ConnectionStatus };
+            var updates = new Dictionary<PartyMember, (string, byte[])>();
+            foreach (var member in _partyState.PartyMembers.Values)
+            {
+                if (member.Peer != null)
+                {
+                    updates[member] = member.AcceptsUserDataPatches
+                        ? (PartyMemberDataPatch.Route, SerializeStateUpdate(member, patchUpdate))
+                        : (PartyMemberDataUpdate.Route, SerializeStateUpdate(member, fullUpdate));
+                }
+            }
+            await BroadcastSerializedStateUpdateRpc(updates);
+        }
+
         public async Task PromoteLeader(string playerToPromote, CancellationToken ct)
         {
             await _partyState.TaskQueue.PushWork(async () =>
@@ -1069,10 +1146,38 @@ namespace Stormancer.Server.Plugins.Party
         /// <param name="route">RPC route on which the data will be sent.</param>
         /// <param name="dataPerMember">The data to send to each member. In this overload, the data is member-specific.</param>
         /// <returns>Task that completes when every member has received the data, or when <c>_clientRpcTimeout</c> has been reached.</returns>
-        private async Task BroadcastStateUpdateRpc<T>(string route, Dictionary<PartyMember, T> dataPerMember)
+        private Task BroadcastStateUpdateRpc<T>(string route, Dictionary<PartyMember, T> dataPerMember)
+        {
+            return BroadcastSerializedStateUpdateRpc(dataPerMember
+                .Where(kvp => kvp.Key.Peer != null)
+                .ToDictionary(kvp => kvp.Key, kvp => (route, SerializeStateUpdate(kvp.Key, kvp.Value))));
+        }
+
+        private static byte[] SerializeStateUpdate<T>(PartyMember recipient, T value)
+        {
+            using var stream = new MemoryStream();
+            recipient.Peer!.Serializer().Serialize(value, stream);
+            return stream.ToArray();
+        }
+
+        /// <summary>
+        /// Sends a state update that was already serialized for each member, possibly on a different route per member.
+        /// </summary>
+        /// <remarks>
+        /// The same bytes are recorded in <see cref="PartyState.UpdateLog"/>, to be replayed later by <see cref="SendStateDeltasAsRequestAnswer(RequestContext{IScenePeerClient})"/>.
+        /// </remarks>
+        /// <param name="updatesPerMember">Route and serialized payload, per member.</param>
+        /// <returns>Task that completes when every member has received the data, or when <c>_clientRpcTimeout</c> has been reached.</returns>
+        private async Task BroadcastSerializedStateUpdateRpc(Dictionary<PartyMember, (string Route, byte[] Payload)> updatesPerMember)
         {
             _partyState.VersionNumber++;
 
+            _partyState.UpdateLog.Add(new PartyUpdateLogEntry
+            {
+                Version = _partyState.VersionNumber,
+                UpdatesPerUser = updatesPerMember.ToDictionary(kvp => kvp.Key.UserId, kvp => kvp.Value)
+            });
+
             if (_partyState.PartyMembers.IsEmpty)
             {
                 return;
@@ -1084,19 +1189,20 @@ namespace Stormancer.Server.Plugins.Party
 
                 var rpc = _scene.DependencyResolver.Resolve<RpcService>();
                 await Task.WhenAll(
-                        dataPerMember.Where(kvp => kvp.Key.Peer != null).Select(kvp =>
+                        updatesPerMember.Select(kvp =>
                         {
                             try
                             {
                                 if (kvp.Key.Peer != null)
                                 {
+                                    var (route, payload) = kvp.Value;
                                     return rpc.Rpc(
                                         route,
                                         kvp.Key.Peer,
                                         s =>
                                         {
                                             kvp.Key.Peer.Serializer().Serialize(_partyState.VersionNumber, s);
-                                            kvp.Key.Peer.Serializer().Serialize(kvp.Value, s);
+                                            s.Write(payload, 0, payload.Length);
                                         },
                                         PacketPriority.MEDIUM_PRIORITY,
                                         cts.Token
@@ -1125,7 +1231,7 @@ namespace Stormancer.Server.Plugins.Party
                                 return Task.CompletedTask;
                             }
 
-                        }) // dataPerMember.Select()
+                        }) // updatesPerMember.Select()
                     ); // Task.WhenAll()
 
             } // using cts
@@ -1215,6 +1321,36 @@ namespace Stormancer.Server.Plugins.Party
             });
         }
 
+        public async Task SendStateDeltasAsRequestAnswer(RequestContext<IScenePeerClient> ctx)
+        {
+            var sinceVersion = ctx.ReadObject<int>();
+            await _partyState.TaskQueue.PushWork(async () =>
+            {
+                if (ctx.CancellationToken.IsCancellationRequested)
+                {
+                    throw new TaskCanceledException();
+                }
+
+                if (!_partyState.PartyMembers.TryGetValue(ctx.RemotePeer.SessionId, out var member))
+                {
+                    ThrowNoSuchMemberError(ctx.RemotePeer.SessionId);
+                    return;
+                }
+
+                var dto = new PartyStateDeltasDto();
+                if (_partyState.UpdateLog.TryGetUpdatesSince(member.UserId, sinceVersion, _partyState.VersionNumber, out var updates))
+                {
+                    dto.Deltas = updates.Select(u => new PartyStateDeltaDto { Version = u.Version, Route = u.Route, Payload = u.Payload }).ToList();
+                }
+                else
+                {
+                    dto.FullStateRequired = true;
+                }
+
+                await ctx.SendValue(dto);
+            });
+        }
+
         private async Task<PartyStateDto> MakePartyStateDto(PartyMember recipient, IEnumerable<IPartyEventHandler> handlers)
         {
             var dto = new PartyStateDto
@@ -42,6 +42,7 @@ namespace Stormancer.Server.Plugins.PartyMerging
 
                 builder.Register<MergingPartyService>().As<IMergingPartyService>().InstancePerRequest();
                 builder.Register<MergingRequestPartyState>().InstancePerScene();
+                builder.Register<MergerStatusBroadcaster>().InstancePerScene();
                 builder.Register<PartyEventHandler>().As<IPartyEventHandler>();
 
             };
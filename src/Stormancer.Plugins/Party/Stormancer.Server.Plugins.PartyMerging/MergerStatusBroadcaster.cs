@@ -0,0 +1,208 @@
+﻿using Newtonsoft.Json.Linq;
+using Stormancer.Core;
+using Stormancer.Diagnostics;
+using Stormancer.Server.Plugins.Party;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Stormancer.Server.Plugins.PartyMerging
+{
+    /// <summary>
+    /// Pushes merger status updates to the party members subscribed to them.
+    /// </summary>
+    /// <remarks>
+    /// The party scene subscribes to a merger when its first member subscribes to it, and unsubscribes when the last one does.
+    /// The merger then pushes its status to the party scene when it changes, see <see cref="PartyMergingService.PushStatusAsync"/>.
+    /// Only the top level fields of the status that changed since the last push are sent to members, except to new subscribers which receive the full status.
+    /// The status is sent as a serialized msgpack map, so that clients can apply it on top of the previous status without knowing the details type in advance.
+    /// </remarks>
+    internal class MergerStatusBroadcaster
+    {
+        /// <summary>
+        /// Route used to push merger status updates to clients.
+        /// </summary>
+        public const string MERGER_STATUS_ROUTE = "partyMerging.mergerStatus";
+
+        private class MergerSubscription
+        {
+            public HashSet<SessionId> Subscribers { get; } = new HashSet<SessionId>();
+            public JObject? LastStatus { get; set; }
+        }
+
+        private readonly object _syncRoot = new object();
+        private readonly Dictionary<string, MergerSubscription> _subscriptions = new Dictionary<string, MergerSubscription>();
+        private readonly ISceneHost _scene;
+        private readonly ISerializer _serializer;
+        private readonly ILogger _logger;
+
+        public MergerStatusBroadcaster(ISceneHost scene, ISerializer serializer, ILogger logger)
+        {
+            _scene = scene;
+            _serializer = serializer;
+            _logger = logger;
+        }
+
+        /// <summary>
+        /// Subscribes a peer to the status of a merger, and sends it the current status.
+        /// </summary>
+        /// <param name="partyMergerId"></param>
+        /// <param name="sessionId"></param>
+        /// <param name="partyId">Id of the party the scene hosts.</param>
+        /// <param name="proxy"></param>
+        /// <param name="cancellationToken"></param>
+        /// <returns></returns>
+        public async Task Subscribe(string partyMergerId, SessionId sessionId, string partyId, PartyMergerProxy proxy, CancellationToken cancellationToken)
+        {
+            JObject? status;
+            bool subscribeToMerger;
+            lock (_syncRoot)
+            {
+                subscribeToMerger = !_subscriptions.TryGetValue(partyMergerId, out var subscription);
+                if (subscription == null)
+                {
+                    subscription = new MergerSubscription();
+                    _subscriptions.Add(partyMergerId, subscription);
+                }
+                subscription.Subscribers.Add(sessionId);
+                status = subscription.LastStatus;
+            }
+
+            if (subscribeToMerger)
+            {
+                try
+                {
+                    status = await proxy.SubscribeStatus(partyMergerId, partyId, cancellationToken);
+                }
+                catch
+                {
+                    await Unsubscribe(partyMergerId, sessionId, partyId, proxy);
+                    throw;
+                }
+
+                lock (_syncRoot)
+                {
+                    if (!_subscriptions.TryGetValue(partyMergerId, out var subscription))
+                    {
+                        return;
+                    }
+                    // A push may have been received while the subscription request was in flight.
+                    subscription.LastStatus ??= status;
+                    status = subscription.LastStatus;
+                }
+            }
+
+            if (status != null)
+            {
+                await SendAsync(new[] { sessionId }, partyMergerId, true, Serialize(status));
+            }
+        }
+
+        /// <summary>
+        /// Unsubscribes a peer from status updates of a merger.
+        /// </summary>
+        /// <param name="partyMergerId"></param>
+        /// <param name="sessionId"></param>
+        /// <param name="partyId">Id of the party the scene hosts.</param>
+        /// <param name="proxy"></param>
+        /// <returns></returns>
+        public Task Unsubscribe(string partyMergerId, SessionId sessionId, string partyId, PartyMergerProxy proxy)
+        {
+            lock (_syncRoot)
+            {
+                if (!_subscriptions.TryGetValue(partyMergerId, out var subscription) || !subscription.Subscribers.Remove(sessionId) || subscription.Subscribers.Count > 0)
+                {
+                    return Task.CompletedTask;
+                }
+                _subscriptions.Remove(partyMergerId);
+            }
+            return UnsubscribeFromMerger(partyMergerId, partyId, proxy);
+        }
+
+        /// <summary>
+        /// Forwards a status pushed by a merger to the subscribed members.
+        /// </summary>
+        /// <param name="partyMergerId"></param>
+        /// <param name="status"></param>
+        /// <param name="party"></param>
+        /// <returns>False if no member is subscribed to the merger anymore, in which case the merger stops pushing to this party.</returns>
+        public async Task<bool> OnStatusPushed(string partyMergerId, JObject status, IPartyService party)
+        {
+            SessionId[] fullRecipients;
+            SessionId[] diffRecipients;
+            JObject diff;
+            lock (_syncRoot)
+            {
+                if (!_subscriptions.TryGetValue(partyMergerId, out var subscription))
+                {
+                    return false;
+                }
+
+                // Members who left the party without unsubscribing.
+                subscription.Subscribers.RemoveWhere(sessionId => !party.PartyMembers.ContainsKey(sessionId));
+                if (subscription.Subscribers.Count == 0)
+                {
+                    _subscriptions.Remove(partyMergerId);
+                    return false;
+                }
+
+                var previous = subscription.LastStatus;
+                diff = new JObject();
+                foreach (var property in status.Properties())
+                {
+                    if (previous == null || !JToken.DeepEquals(previous[property.Name], property.Value))
+                    {
+                        diff.Add(property.Name, property.Value.DeepClone());
+                    }
+                }
+                subscription.LastStatus = status;
+
+                fullRecipients = previous == null ? subscription.Subscribers.ToArray() : Array.Empty<SessionId>();
+                diffRecipients = previous != null && diff.Count > 0 ? subscription.Subscribers.ToArray() : Array.Empty<SessionId>();
+            }
+
+            if (fullRecipients.Length > 0)
+            {
+                await SendAsync(fullRecipients, partyMergerId, true, Serialize(status));
+            }
+            if (diffRecipients.Length > 0)
+            {
+                await SendAsync(diffRecipients, partyMergerId, false, Serialize(diff));
+            }
+            return true;
+        }
+
+        private async Task UnsubscribeFromMerger(string partyMergerId, string partyId, PartyMergerProxy proxy)
+        {
+            try
+            {
+                await proxy.UnsubscribeStatus(partyMergerId, partyId, CancellationToken.None);
+            }
+            catch (Exception ex)
+            {
+                // The merger also unsubscribes the party the next time it pushes a status.
+                _logger.Log(LogLevel.Debug, "partyMerging", $"Failed to unsubscribe from the status of merger '{partyMergerId}'.", ex);
+            }
+        }
+
+        private byte[] Serialize(JObject data)
+        {
+            using var stream = new MemoryStream();
+            _serializer.Serialize(data, stream);
+            return stream.ToArray();
+        }
+
+        private Task SendAsync(IEnumerable<SessionId> sessionIds, string partyMergerId, bool isFullStatus, byte[] data)
+        {
+            return _scene.Send(new MatchArrayFilter(sessionIds), MERGER_STATUS_ROUTE, s =>
+            {
+                _serializer.Serialize(partyMergerId, s);
+                _serializer.Serialize(isFullStatus, s);
+                _serializer.Serialize(data, s);
+            }, PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
+        }
+    }
+}
@@ -51,6 +51,27 @@ namespace Stormancer.Server.Plugins.PartyMerging
         {
             return _service.GetStatusAsync(fromAdmin);
         }
+
+        /// <summary>
+        /// Subscribes a party scene to status changes of the merger, pushed with <see cref="PartyMergingController.PushMergerStatus"/>.
+        /// </summary>
+        /// <param name="partyId"></param>
+        /// <returns>The current status of the merger.</returns>
+        [S2SApi]
+        public Task<JObject> SubscribeStatus(string partyId)
+        {
+            return _service.SubscribeStatus(partyId);
+        }
+
+        /// <summary>
+        /// Stops pushing status changes to a party scene.
+        /// </summary>
+        /// <param name="partyId"></param>
+        [S2SApi]
+        public void UnsubscribeStatus(string partyId)
+        {
+            _service.UnsubscribeStatus(partyId);
+        }
     }
 
    
@@ -80,19 +101,22 @@ namespace Stormancer.Server.Plugins.PartyMerging
     /// <summary>
     /// Controller providing party merging APIs  to clients on parties.
     /// </summary>
+    [Service(Named = true, ServiceType = PartyPlugin.PARTY_SERVICEID)]
     internal class PartyMergingController : ControllerBase
     {
         private readonly IPartyService _party;
         private readonly PartyMergerProxy _proxy;
         private readonly IMergingPartyService _service;
+        private readonly MergerStatusBroadcaster _statusBroadcaster;
 
 
-        public PartyMergingController(IMergingPartyService service, IPartyService party, PartyMergerProxy proxy)
+        public PartyMergingController(IMergingPartyService service, IPartyService party, PartyMergerProxy proxy, MergerStatusBroadcaster statusBroadcaster)
         {
 
             _service = service;
             _party = party;
             _proxy = proxy;
+            _statusBroadcaster = statusBroadcaster;
         }
 
         [Api(ApiAccess.Public, ApiType.Rpc)]
@@ -102,6 +126,48 @@ namespace Stormancer.Server.Plugins.PartyMerging
             return new GetPartyMergerStatusResponse { MaxAge = 1, Data = result };
         }
 
+        /// <summary>
+        /// Subscribes the calling party member to status updates of a merger, pushed on the route "partyMerging.mergerStatus".
+        /// </summary>
+        /// <remarks>
+        /// The first update contains the full status, the next ones only the fields that changed.
+        /// A member can be subscribed to several mergers at the same time.
+        /// </remarks>
+        /// <param name="partyMergerId"></param>
+        /// <param name="request"></param>
+        [Api(ApiAccess.Public, ApiType.Rpc)]
+        public Task SubscribeMergerStatus(string partyMergerId, RequestContext<IScenePeerClient> request)
+        {
+            if (!_party.PartyMembers.ContainsKey(request.RemotePeer.SessionId))
+            {
+                throw new ClientException("notAuthorized?reason=notMember");
+            }
+            return _statusBroadcaster.Subscribe(partyMergerId, request.RemotePeer.SessionId, _party.PartyId, _proxy, request.CancellationToken);
+        }
+
+        /// <summary>
+        /// Stops pushing status updates of a merger to the calling party member.
+        /// </summary>
+        /// <param name="partyMergerId"></param>
+        /// <param name="request"></param>
+        [Api(ApiAccess.Public, ApiType.Rpc)]
+        public Task UnsubscribeMergerStatus(string partyMergerId, RequestContext<IScenePeerClient> request)
+        {
+            return _statusBroadcaster.Unsubscribe(partyMergerId, request.RemotePeer.SessionId, _party.PartyId, _proxy);
+        }
+
+        /// <summary>
+        /// Receives a status change pushed by a merger the party is subscribed to.
+        /// </summary>
+        /// <param name="partyMergerId"></param>
+        /// <param name="status"></param>
+        /// <returns>False if no member of the party is subscribed to the merger anymore.</returns>
+        [S2SApi]
+        public Task<bool> PushMergerStatus(string partyMergerId, JObject status)
+        {
+            return _statusBroadcaster.OnStatusPushed(partyMergerId, status, _party);
+        }
+
         [Api(ApiAccess.Public, ApiType.Rpc)]
         public void Start(string partyMergerId, RequestContext<IScenePeerClient> request)
         {
@@ -48,6 +48,33 @@ namespace Stormancer.Server.Plugins.PartyMerging
         }
     }
 
+    /// <summary>
+    /// Configuration section of the party merging plugin.
+    /// </summary>
+    /// <remarks>
+    /// The section is saved in the configuration under the key "partyMerging".
+    /// </remarks>
+    public class PartyMergingConfigurationSection
+    {
+        /// <summary>
+        /// Path of the section in the configuration.
+        /// </summary>
+        public const string SECTION_PATH = "partyMerging";
+
+        /// <summary>
+        /// Default value of <see cref="StatusPushIntervalSeconds"/>.
+        /// </summary>
+        public const double DEFAULT_STATUS_PUSH_INTERVAL_SECONDS = 1;
+
+        /// <summary>
+        /// Minimum interval between two status pushes from a merger to the subscribed parties, in seconds.
+        /// </summary>
+        /// <remarks>
+        /// Defaults to 1. The status is checked after each merging pass, so values lower than the merging interval (1 second) have no effect.
+        /// </remarks>
+        public double? StatusPushIntervalSeconds { get; set; }
+    }
+
     internal class PartyMergingConfigurationRepository
     {
         public void AddPartyMerger(string id, Action<PartyMergingConfiguration> configurator)
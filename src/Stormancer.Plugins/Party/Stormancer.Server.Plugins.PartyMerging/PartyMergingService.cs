@@ -3,6 +3,7 @@ using Newtonsoft.Json.Linq;
 using Stormancer.Core;
 using Stormancer.Diagnostics;
 using Stormancer.Server.Plugins.Analytics;
+using Stormancer.Server.Plugins.Configuration;
 using Stormancer.Server.Plugins.Models;
 using Stormancer.Server.Plugins.Party;
 using Stormancer.Server.Plugins.Utilities.Extensions;
@@ -26,6 +27,16 @@ namespace Stormancer.Server.Plugins.PartyMerging
         public int LastPlayersCount { get; set; }
         public int LastPartiesCount { get; set; }
 
+        /// <summary>
+        /// Ids of the parties subscribed to status updates of the merger.
+        /// </summary>
+        public HashSet<string> StatusSubscribers { get; } = new HashSet<string>();
+
+        /// <summary>
+        /// Last status pushed to <see cref="StatusSubscribers"/>.
+        /// </summary>
+        public JObject? LastPushedStatus { get; set; }
+
         public AnalyticsAccumulator<TimeSpan, double> AverageTimeInMerger { get; set; } = new AnalyticsAccumulator<TimeSpan, double>(256, (span) => 
         {
 
@@ -50,6 +61,7 @@ namespace Stormancer.Server.Plugins.PartyMerging
             {
                 using var timer = new PeriodicTimer(TimeSpan.FromSeconds(1));
                 var lastAnalytics = DateTime.UtcNow;
+                var lastStatusPush = DateTime.MinValue;
                 while (!ct.IsCancellationRequested)
                 {
                     await timer.WaitForNextTickAsync(ct);
@@ -61,6 +73,14 @@ namespace Stormancer.Server.Plugins.PartyMerging
                         var merger = scope.Resolve<PartyMergingService>();
                         await merger.Merge(cts.Token);
 
+                        var section = scope.Resolve<IConfiguration>().GetValue<PartyMergingConfigurationSection>(PartyMergingConfigurationSection.SECTION_PATH);
+                        var pushInterval = TimeSpan.FromSeconds(section?.StatusPushIntervalSeconds ?? PartyMergingConfigurationSection.DEFAULT_STATUS_PUSH_INTERVAL_SECONDS);
+                        if (DateTime.UtcNow >= lastStatusPush + pushInterval)
+                        {
+                            lastStatusPush = DateTime.UtcNow;
+                            await merger.PushStatusAsync(cts.Token);
+                        }
+
                         if (DateTime.UtcNow > lastAnalytics + TimeSpan.FromMinutes(1))
                         {
                             lastAnalytics = DateTime.UtcNow;
@@ -167,17 +187,21 @@ namespace Stormancer.Server.Plugins.PartyMerging
         private readonly PartyMergingState _state;
         private readonly IPartyMergingAlgorithm _algorithm;
         private readonly PartyProxy _parties;
+        private readonly PartyMergingProxy _partyMerging;
         private readonly IPartyManagementService _partyManagement;
+        private readonly ILogger _logger;
 
         public string MergerId => PartyMergingConstants.TryGetMergerId(_scene, out var mergerId) ? mergerId : "unknown";
 
-        public PartyMergingService(ISceneHost scene, PartyMergingState state, IPartyMergingAlgorithm algorithm, PartyProxy parties, IPartyManagementService partyManagement)
+        public PartyMergingService(ISceneHost scene, PartyMergingState state, IPartyMergingAlgorithm algorithm, PartyProxy parties, PartyMergingProxy partyMerging, IPartyManagementService partyManagement, ILogger logger)
         {
             _scene = scene;
             _state = state;
             _algorithm = algorithm;
             _parties = parties;
+            _partyMerging = partyMerging;
             _partyManagement = partyManagement;
+            _logger = logger;
         }
 
         public async Task<string?> StartMergeParty(string partyId, CancellationToken cancellationToken)
@@ -362,6 +386,84 @@ namespace Stormancer.Server.Plugins.PartyMerging
             return json;
         }
 
+        /// <summary>
+        /// Subscribes a party scene to status updates of the merger.
+        /// </summary>
+        /// <param name="partyId"></param>
+        /// <returns>The current status of the merger.</returns>
+        public Task<JObject> SubscribeStatus(string partyId)
+        {
+            lock (_state._syncRoot)
+            {
+                _state.StatusSubscribers.Add(partyId);
+            }
+            return GetStatusAsync(false);
+        }
+
+        /// <summary>
+        /// Stops pushing status updates to a party scene.
+        /// </summary>
+        /// <param name="partyId"></param>
+        public void UnsubscribeStatus(string partyId)
+        {
+            lock (_state._syncRoot)
+            {
+                _state.StatusSubscribers.Remove(partyId);
+            }
+        }
+
+        /// <summary>
+        /// Pushes the status of the merger to the subscribed party scenes if it changed since the last push.
+        /// </summary>
+        /// <remarks>
+        /// A party scene is unsubscribed when the push fails, or when it reports that none of its members is subscribed anymore.
+        /// </remarks>
+        /// <param name="cancellationToken"></param>
+        /// <returns></returns>
+        public async Task PushStatusAsync(CancellationToken cancellationToken)
+        {
+            string[] subscribers;
+            lock (_state._syncRoot)
+            {
+                if (_state.StatusSubscribers.Count == 0)
+                {
+                    _state.LastPushedStatus = null;
+                    return;
+                }
+                subscribers = _state.StatusSubscribers.ToArray();
+            }
+
+            var status = await GetStatusAsync(false);
+            lock (_state._syncRoot)
+            {
+                if (_state.LastPushedStatus != null && JToken.DeepEquals(_state.LastPushedStatus, status))
+                {
+                    return;
+                }
+                _state.LastPushedStatus = status;
+            }
+
+            var mergerId = MergerId;
+            await Task.WhenAll(subscribers.Select(async partyId =>
+            {
+                bool stillSubscribed;
+                try
+                {
+                    stillSubscribed = await _partyMerging.PushMergerStatus(partyId, mergerId, status, cancellationToken);
+                }
+                catch (Exception ex) when (!cancellationToken.IsCancellationRequested)
+                {
+                    _logger.Log(LogLevel.Debug, "partyMerger", $"Failed to push the status of merger '{mergerId}' to party '{partyId}', unsubscribing it.", ex);
+                    stillSubscribed = false;
+                }
+
+                if (!stillSubscribed)
+                {
+                    UnsubscribeStatus(partyId);
+                }
+            }));
+        }
+
         public MergerAnalytics GetAnalytics()
         {
             return new MergerAnalytics { AverageTimeInMerger = _state.AverageTimeInMerger.Result, LastPlayerCount = _state.LastPlayersCount, LastPartyCount = _state.LastPartiesCount, Custom =  _algorithm.GetAnalytics() };
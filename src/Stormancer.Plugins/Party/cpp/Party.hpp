@@ -24,6 +24,7 @@
 
 #include "gamefinder/GameFinder.hpp"
 #include "Users/ClientAPI.hpp"
+#include "Users/ConfigurationParameters.hpp"
 #include "Users/Users.hpp"
 
 #include "stormancer/IClient.h"
@@ -38,17 +39,56 @@
 #include "stormancer/Utilities/TaskUtilities.h"
 #include "stormancer/cpprestsdk/cpprest/json.h"
 
+#include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <chrono>
+#include <memory>
 #include <stdio.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Stormancer
 {
 	namespace Party
 	{
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the Party plugin behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// When "true", player data updates are sent and received as binary patches against the previous data, when the server supports it.
+			/// Full data is sent instead whenever a patch would not be smaller, or when the server rejects it.
+			/// Default is "false".
+			/// </summary>
+			constexpr const char* UserDataPatches = "party.userDataPatches.enabled";
+
+			/// <summary>
+			/// Window in milliseconds during which successive party settings updates, and successive player data updates, are merged into a single request.
+			/// Only the last value written during the window is sent, and the tasks of all merged calls complete with that request.
+			/// Settings changes are merged field by field, so fields changed by earlier calls of the window are kept.
+			/// Default is "0" (every update is sent immediately).
+			/// </summary>
+			constexpr const char* WriteCoalescingWindowMs = "party.writeCoalescing.windowMs";
+
+			/// <summary>
+			/// How long, in milliseconds, a page returned by a PartySearch is served from the client cache before being requested again.
+			/// Default is "2000".
+			/// </summary>
+			constexpr const char* SearchCacheTtlMs = "party.search.cacheTtlMs";
+
+			/// <summary>
+			/// Prefix of the retry policy keys used when the party state must be synchronized again (see RetryPolicyOptions), for instance "party.stateSync.retry.maxDelayMs".
+			/// Defaults: 200ms base delay, 10s max delay, unlimited attempts, circuit breaker opening for 5s after 5 consecutive failures.
+			/// </summary>
+			constexpr const char* StateSyncRetryPrefix = "party.stateSync";
+		}
+
 		struct PartyUserDto;
 		struct PartySettings;
+		struct PartyStateSnapshot;
 		struct PartyInvitation;
 		struct PartyCreationOptions;
 		struct PartyGameFinderFailure;
@@ -383,6 +423,37 @@ namespace Stormancer
 			MSGPACK_DEFINE(partyId, leaderUserId, friends, metadata);
 		};
 
+		/// <summary>
+		/// Advertised parties returned by a single platform.
+		/// </summary>
+		struct AdvertisedPartiesResult
+		{
+			/// <summary>
+			/// Name of the platform, as returned by <c>IPlatformSupportProvider::getPlatformName()</c>.
+			/// </summary>
+			std::string platform;
+
+			/// <summary>
+			/// Parties advertised by the platform. Empty if it failed.
+			/// </summary>
+			std::vector<AdvertisedParty> parties;
+
+			/// <summary>
+			/// Error message if the platform failed, did not answer in time or the request was cancelled, empty otherwise.
+			/// </summary>
+			std::string error;
+
+			/// <summary>
+			/// true if the platform did not answer in time.
+			/// </summary>
+			bool timedOut = false;
+
+			/// <summary>
+			/// true if the request was cancelled by the caller before the platform answered.
+			/// </summary>
+			bool cancelled = false;
+		};
+
 		struct PartyDocument
 		{
 			std::string id;
@@ -399,6 +470,73 @@ namespace Stormancer
 			MSGPACK_DEFINE(total, hits)
 		};
 
+		/// <summary>
+		/// A page of results of a <c>PartySearch</c>.
+		/// </summary>
+		struct PartySearchPage
+		{
+			/// <summary>
+			/// Index of the first hit of this page in the whole result set.
+			/// </summary>
+			Stormancer::uint32 skip = 0;
+
+			/// <summary>
+			/// Total number of parties matching the query.
+			/// </summary>
+			Stormancer::uint32 total = 0;
+
+			std::vector<PartyDocument> hits;
+
+			/// <summary>
+			/// True if this page was served from the client cache without contacting the server.
+			/// </summary>
+			bool fromCache = false;
+		};
+
+		/// <summary>
+		/// Paginated party search bound to a query, created by <c>PartyApi::createPartySearch()</c>.
+		/// </summary>
+		/// <remarks>
+		/// Pages are cached by query for a short time (see <c>ConfigurationKeys::SearchCacheTtlMs</c>), and shared between searches with the same query.
+		/// When a cached page expires, only the documents that changed since it was fetched are downloaded again.
+		/// </remarks>
+		class PartySearch
+		{
+		public:
+
+			virtual ~PartySearch() = default;
+
+			virtual const std::string& query() const = 0;
+
+			virtual Stormancer::uint32 pageSize() const = 0;
+
+			/// <summary>
+			/// Get a page of results, from the cache if it is recent enough.
+			/// </summary>
+			/// <param name="pageIndex">Index of the page, starting at 0.</param>
+			/// <param name="ct">Cancellation token.</param>
+			virtual pplx::task<PartySearchPage> getPage(Stormancer::uint32 pageIndex, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
+			/// <summary>
+			/// Get an up-to-date page of results, ignoring the cache age. Only changed documents are downloaded.
+			/// </summary>
+			/// <param name="pageIndex">Index of the page, starting at 0.</param>
+			/// <param name="ct">Cancellation token.</param>
+			virtual pplx::task<PartySearchPage> refreshPage(Stormancer::uint32 pageIndex, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
+			/// <summary>
+			/// Deliver pages in order as they arrive, until <c>maxResults</c> hits or the end of the results.
+			/// </summary>
+			/// <remarks>
+			/// The next page is requested before <c>onPage</c> is called for the current one.
+			/// </remarks>
+			/// <param name="maxResults">Maximum number of hits to deliver.</param>
+			/// <param name="onPage">Called once per page, in page order.</param>
+			/// <param name="ct">Cancellation token.</param>
+			/// <returns>A task that completes when the last page has been delivered.</returns>
+			virtual pplx::task<void> streamPages(Stormancer::uint32 maxResults, std::function<void(const PartySearchPage&)> onPage, pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+		};
+
 
 
 		class PartyApi
@@ -536,6 +674,16 @@ namespace Stormancer
 			/// <exception cref="std::exception">If you are not in a party.</exception>
 			virtual PartySettings getPartySettings() const = 0;
 
+			/// <summary>
+			/// Get an immutable snapshot of the current party state.
+			/// </summary>
+			/// <remarks>
+			/// Unlike <c>getPartyMembers()</c> and <c>getPartySettings()</c>, this method doesn't copy the party state nor take a lock,
+			/// which makes it suitable for polling every frame.
+			/// </remarks>
+			/// <returns>The current snapshot, or nullptr if you are not in a party.</returns>
+			virtual std::shared_ptr<const PartyStateSnapshot> getPartyStateSnapshot() const = 0;
+
 			/// <summary>
 			/// Get the partyId of the current party.
 			/// </summary>
@@ -696,6 +844,18 @@ namespace Stormancer
 			/// <returns>A list of advertised parties.</returns>
 			virtual pplx::task<std::vector<AdvertisedParty>> getAdvertisedParties(pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
 
+			/// <summary>
+			/// Get advertised parties, platform by platform as they are received.
+			/// </summary>
+			/// <remarks>
+			/// Unlike <c>getAdvertisedParties()</c>, a slow or failing platform doesn't delay or fail the results of the others.
+			/// </remarks>
+			/// <param name="onResult">Called once per platform, on the main dispatcher, as soon as the platform answered, failed, reached the timeout or ct was cancelled.</param>
+			/// <param name="platformTimeout">How long to wait for each platform. The request of a platform is cancelled when it is reached.</param>
+			/// <param name="ct">Cancellation token.</param>
+			/// <returns>A task that completes when <c>onResult</c> has been called for every platform, canceled if ct was cancelled.</returns>
+			virtual pplx::task<void> streamAdvertisedParties(std::function<void(const AdvertisedPartiesResult&)> onResult, std::chrono::milliseconds platformTimeout = std::chrono::milliseconds(5000), pplx::cancellation_token ct = pplx::cancellation_token::none()) = 0;
+
 			/// <summary>
 			/// Get the PartyApi's DependencyScope.
 			/// </summary>
@@ -840,6 +1000,13 @@ namespace Stormancer
 			virtual Subscription subscribeOnPartyError(std::function<void(const PartyError&)> callback) = 0;
 
 			virtual pplx::task<SearchResult> searchParties(const std::string& jsonQuery, Stormancer::uint32 skip, Stormancer::uint32 size, pplx::cancellation_token cancellationToken) = 0;
+
+			/// <summary>
+			/// Create a paginated, cached search for parties matching a query.
+			/// </summary>
+			/// <param name="jsonQuery">Json query, in the same format as for <c>searchParties()</c>.</param>
+			/// <param name="pageSize">Number of hits per page.</param>
+			virtual std::shared_ptr<PartySearch> createPartySearch(const std::string& jsonQuery, Stormancer::uint32 pageSize = 20) = 0;
 		};
 
 		/// <summary>
@@ -1057,6 +1224,41 @@ namespace Stormancer
 			MSGPACK_DEFINE(reason);
 		};
 
+		/// <summary>
+		/// Immutable view of the state of a party at a given version.
+		/// </summary>
+		/// <remarks>
+		/// A new snapshot is published each time the party state changes. Snapshots are never modified once published,
+		/// so they can be kept and read from any thread without synchronization.
+		/// Members that did not change share their storage with the previous snapshot, so publishing a change only copies what changed.
+		/// </remarks>
+		struct PartyStateSnapshot
+		{
+			PartySettings settings;
+			std::string leaderId;
+			std::vector<std::shared_ptr<const PartyUserDto>> members;
+
+			/// <summary>
+			/// Version of the party state this snapshot was built from.
+			/// </summary>
+			int version = 0;
+
+			/// <summary>
+			/// Position of each member in members, by user id. Shared between snapshots as long as the member list doesn't change.
+			/// </summary>
+			std::shared_ptr<const std::unordered_map<std::string, std::size_t>> memberIndex = std::make_shared<const std::unordered_map<std::string, std::size_t>>();
+
+			/// <summary>
+			/// Find a member by user id.
+			/// </summary>
+			/// <returns>A pointer to the member in this snapshot, or nullptr if userId is not a member of the party.</returns>
+			const PartyUserDto* findMember(const std::string& userId) const
+			{
+				auto it = memberIndex->find(userId);
+				return it != memberIndex->end() ? members[it->second].get() : nullptr;
+			}
+		};
+
 		/// <summary>
 		/// This event is triggered when the state of one or more party members changes.
 		/// </summary>
@@ -1614,7 +1816,55 @@ namespace Stormancer
 				std::vector<PartyUserDto>	members;
 				int							version = 0;
 
+				// userId => position in members. Not serialized: call reindexMembers() after deserializing.
+				std::unordered_map<std::string, std::size_t> memberIndex;
+
 				MSGPACK_DEFINE(settings, leaderId, members, version);
+
+				void reindexMembers(std::size_t from = 0)
+				{
+					if (from == 0)
+					{
+						memberIndex.clear();
+						memberIndex.reserve(members.size());
+					}
+					for (std::size_t i = from; i < members.size(); ++i)
+					{
+						memberIndex[members[i].userId] = i;
+					}
+				}
+
+				PartyUserDto* findMember(const std::string& userId)
+				{
+					auto it = memberIndex.find(userId);
+					return it != memberIndex.end() ? &members[it->second] : nullptr;
+				}
+
+				void addMember(PartyUserDto member)
+				{
+					if (auto existing = findMember(member.userId))
+					{
+						*existing = std::move(member);
+						return;
+					}
+					memberIndex[member.userId] = members.size();
+					members.push_back(std::move(member));
+				}
+
+				// Removes the member while preserving the order of the others. Returns false if userId is not a member.
+				bool removeMember(const std::string& userId)
+				{
+					auto it = memberIndex.find(userId);
+					if (it == memberIndex.end())
+					{
+						return false;
+					}
+					auto position = it->second;
+					memberIndex.erase(it);
+					members.erase(members.begin() + position);
+					reindexMembers(position);
+					return true;
+				}
 			};
 
 			struct MemberStatusUpdateRequest
@@ -1657,6 +1907,166 @@ namespace Stormancer
 				MSGPACK_DEFINE(userId, reason);
 			};
 
+			struct UserDataPatchRange
+			{
+				int					offset = 0;
+				std::vector<byte>	bytes;
+
+				MSGPACK_DEFINE(offset, bytes);
+			};
+
+			// Binary delta between two versions of player data: resize to newLength, then copy each range over the data.
+			struct UserDataPatch
+			{
+				int								newLength = 0;
+				std::vector<UserDataPatchRange>	ranges;
+
+				MSGPACK_DEFINE(newLength, ranges);
+
+				std::size_t estimatedSize() const
+				{
+					std::size_t size = 8;
+					for (const auto& range : ranges)
+					{
+						size += range.bytes.size() + 8;
+					}
+					return size;
+				}
+
+				static UserDataPatch compute(const std::vector<byte>& oldData, const std::vector<byte>& newData)
+				{
+					// Equal runs shorter than this are merged into the surrounding ranges: each range costs a few bytes of framing.
+					const std::size_t minGap = 8;
+
+					UserDataPatch patch;
+					patch.newLength = static_cast<int>(newData.size());
+					auto commonLength = std::min(oldData.size(), newData.size());
+
+					std::size_t i = 0;
+					while (i < commonLength)
+					{
+						if (oldData[i] == newData[i])
+						{
+							++i;
+							continue;
+						}
+
+						auto start = i;
+						auto end = i + 1;
+						std::size_t equalRun = 0;
+						for (auto j = end; j < commonLength && equalRun < minGap; ++j)
+						{
+							if (oldData[j] == newData[j])
+							{
+								++equalRun;
+							}
+							else
+							{
+								equalRun = 0;
+								end = j + 1;
+							}
+						}
+						patch.ranges.push_back(UserDataPatchRange{ static_cast<int>(start), std::vector<byte>(newData.begin() + start, newData.begin() + end) });
+						i = end;
+					}
+
+					if (newData.size() > commonLength)
+					{
+						if (!patch.ranges.empty() && patch.ranges.back().offset + patch.ranges.back().bytes.size() + minGap >= commonLength)
+						{
+							auto& last = patch.ranges.back();
+							last.bytes.assign(newData.begin() + last.offset, newData.end());
+						}
+						else
+						{
+							patch.ranges.push_back(UserDataPatchRange{ static_cast<int>(commonLength), std::vector<byte>(newData.begin() + commonLength, newData.end()) });
+						}
+					}
+
+					return patch;
+				}
+
+				// Returns false if the patch is malformed.
+				bool tryApply(const std::vector<byte>& baseData, std::vector<byte>& result) const
+				{
+					if (newLength < 0)
+					{
+						return false;
+					}
+
+					std::vector<byte> data(baseData.begin(), baseData.begin() + std::min(baseData.size(), static_cast<std::size_t>(newLength)));
+					data.resize(newLength);
+					for (const auto& range : ranges)
+					{
+						if (range.offset < 0 || range.offset + range.bytes.size() > data.size())
+						{
+							return false;
+						}
+						std::copy(range.bytes.begin(), range.bytes.end(), data.begin() + range.offset);
+					}
+
+					result = std::move(data);
+					return true;
+				}
+
+				// 64 bits FNV-1a, must match the server's PartyUserDataPatch.Hash
+				static uint64_t hash(const std::vector<byte>& data)
+				{
+					uint64_t hash = 14695981039346656037ULL;
+					for (auto b : data)
+					{
+						hash ^= b;
+						hash *= 1099511628211ULL;
+					}
+					return hash;
+				}
+			};
+
+			struct PartyUserDataPatch
+			{
+				std::string userId;
+				UserDataPatch patch;
+				std::vector<LocalPlayerInfos> localPlayers;
+
+				MSGPACK_DEFINE(userId, patch, localPlayers);
+			};
+
+			struct PartySearchDocumentChange
+			{
+				std::string	id;
+				uint64_t	hash = 0;
+				bool		unchanged = false;
+				std::string	content;
+
+				MSGPACK_DEFINE(id, hash, unchanged, content);
+			};
+
+			struct PartySearchChanges
+			{
+				Stormancer::uint32						total = 0;
+				std::vector<PartySearchDocumentChange>	hits;
+
+				MSGPACK_DEFINE(total, hits);
+			};
+
+			// A state update replayed by the server, as it was originally sent on route.
+			struct PartyStateDelta
+			{
+				int					version = 0;
+				std::string			route;
+				std::vector<byte>	payload;
+
+				MSGPACK_DEFINE(version, route, payload);
+			};
+
+			struct PartyStateDeltas
+			{
+				bool							fullStateRequired = false;
+				std::vector<PartyStateDelta>	deltas;
+
+				MSGPACK_DEFINE(fullStateRequired, deltas);
+			};
+
 			inline bool tryParseVersion(const char* version, int& outVersionNumber)
 			{
 				int year = 0, month = 0, day = 0, revision = 0;
@@ -1686,6 +2096,92 @@ namespace Stormancer
 				return versionInt;
 			}
 
+			// Merges the values written during a time window, and sends only the last one. Sends are serialized, in write order.
+			template<typename T>
+			class WriteCoalescer : public std::enable_shared_from_this<WriteCoalescer<T>>
+			{
+			public:
+				using Sender = std::function<pplx::task<void>(const T&)>;
+
+				WriteCoalescer(std::chrono::milliseconds window, std::shared_ptr<IActionDispatcher> dispatcher, Sender sender)
+					: _window(window)
+					, _dispatcher(dispatcher)
+					, _sender(sender)
+				{
+				}
+
+				// The returned task completes with the request that carries value, or the value of a later write that replaced it.
+				pplx::task<void> write(T value)
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+
+					_pending = std::move(value);
+					pplx::task_completion_event<void> tce;
+					_waiters.push_back(tce);
+					if (!_flushScheduled)
+					{
+						_flushScheduled = true;
+						std::weak_ptr<WriteCoalescer<T>> wThat = this->shared_from_this();
+						taskDelay(_window).then([wThat]
+						{
+							if (auto that = wThat.lock())
+							{
+								that->flush();
+							}
+						}, pplx::task_options(_dispatcher));
+					}
+					return pplx::create_task(tce, pplx::task_options(_dispatcher));
+				}
+
+			private:
+
+				void flush()
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+
+					auto value = std::make_shared<T>(std::move(_pending));
+					auto waiters = std::make_shared<std::vector<pplx::task_completion_event<void>>>(std::move(_waiters));
+					_pending = T();
+					_waiters.clear();
+					_flushScheduled = false;
+
+					auto sender = _sender;
+					_inFlight = _inFlight.then([sender, value](pplx::task<void> previous)
+					{
+						try { previous.get(); }
+						catch (...) {}
+						return sender(*value);
+					}, pplx::task_options(_dispatcher)).then([waiters](pplx::task<void> task)
+					{
+						try
+						{
+							task.get();
+							for (auto& tce : *waiters)
+							{
+								tce.set();
+							}
+						}
+						catch (...)
+						{
+							for (auto& tce : *waiters)
+							{
+								tce.set_exception(std::current_exception());
+							}
+						}
+					}, pplx::task_options(_dispatcher));
+				}
+
+				std::chrono::milliseconds _window;
+				std::shared_ptr<IActionDispatcher> _dispatcher;
+				Sender _sender;
+
+				std::mutex _mutex;
+				T _pending;
+				std::vector<pplx::task_completion_event<void>> _waiters;
+				bool _flushScheduled = false;
+				pplx::task<void> _inFlight = pplx::task_from_result();
+			};
+
 			class PartyService : public std::enable_shared_from_this<PartyService>
 			{
 			public:
@@ -1697,9 +2193,11 @@ namespace Stormancer
 				// Protocol versions between client and server are not obligated to match.
 				static constexpr const char* METADATA_KEY = "stormancer.party";
 				static constexpr const char* REVISION_METADATA_KEY = "stormancer.party.revision";
-				static constexpr const char* PROTOCOL_VERSION = "2022-06-09.1";
+				static constexpr const char* PROTOCOL_VERSION = "2026-10-18.2";
 
 				static constexpr const char* IS_JOINABLE_VERSION = "2019-12-13.1";
+				static constexpr const char* INCREMENTAL_SYNC_VERSION = "2026-10-18.1";
+				static constexpr const char* USER_DATA_PATCHES_VERSION = "2026-10-18.2";
 				static constexpr const char* NEW_INVITATIONS_VERSION = "2019-11-22.1";
 
 				static int getProtocolVersionInt()
@@ -1726,6 +2224,14 @@ namespace Stormancer
 						// Older versions are not in the correct format
 						_serverProtocolVersion = 201910231;
 					}
+
+					auto config = _scene.lock()->dependencyResolver().resolve<Configuration>();
+					auto it = config->additionalParameters.find(ConfigurationKeys::UserDataPatches);
+					_userDataPatchesEnabled = it != config->additionalParameters.end() && it->second == "true" && _serverProtocolVersion >= parseVersion(USER_DATA_PATCHES_VERSION);
+
+					_writeCoalescingWindow = readConfigurationParameter(config, ConfigurationKeys::WriteCoalescingWindowMs, _writeCoalescingWindow);
+
+					_stateSyncRetryPolicy = _users->createRetryPolicy(ConfigurationKeys::StateSyncRetryPrefix);
 				}
 
 				~PartyService()
@@ -1755,11 +2261,65 @@ namespace Stormancer
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 
-					static const int isJoinableProtocolVersion = parseVersion(IS_JOINABLE_VERSION);
-					if (newPartySettings.isJoinable == false && _serverProtocolVersion < isJoinableProtocolVersion)
-					{
-						_logger->log(LogLevel::Warn, "PartyService::updatePartySettings", "The server does not support joinability restriction ; 'isJoinable' will have no effect. Please update your server-side Party plugin.");
-					}
+					// Callers build newPartySettings from getPartySettings(), which does not include the writes the server has not applied yet.
+					// Only the fields changed from it are applied on top of these writes, so that a later call doesn't revert an earlier one.
+					auto current = settings();
+					auto merged = _writtenSettings ? *_writtenSettings : current;
+					mergeChangedSettings(current, newPartySettings, merged);
+					_writtenSettings = std::make_shared<const PartySettings>(merged);
+					auto generation = ++_writtenSettingsGeneration;
+
+					auto task = _settingsWriter ? _settingsWriter->write(merged) : sendPartySettings(merged);
+
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					return task.then([wThat, generation](pplx::task<void> task)
+					{
+						if (auto that = wThat.lock())
+						{
+							std::lock_guard<std::recursive_mutex> lg(that->_stateMutex);
+							// Once the last write completed, the settings of the server are up to date again.
+							if (that->_writtenSettingsGeneration == generation)
+							{
+								that->_writtenSettings = nullptr;
+							}
+						}
+						task.get();
+					}, pplx::task_options(_dispatcher));
+				}
+
+				static void mergeChangedSettings(const PartySettings& base, const PartySettings& update, PartySettings& target)
+				{
+					if (update.gameFinderName != base.gameFinderName)
+					{
+						target.gameFinderName = update.gameFinderName;
+					}
+					if (update.customData != base.customData)
+					{
+						target.customData = update.customData;
+					}
+					if (update.onlyLeaderCanInvite != base.onlyLeaderCanInvite)
+					{
+						target.onlyLeaderCanInvite = update.onlyLeaderCanInvite;
+					}
+					if (update.isJoinable != base.isJoinable)
+					{
+						target.isJoinable = update.isJoinable;
+					}
+					if (update.indexedDocument != base.indexedDocument)
+					{
+						target.indexedDocument = update.indexedDocument;
+					}
+				}
+
+				pplx::task<void> sendPartySettings(const PartySettings& newPartySettings)
+				{
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+
+					static const int isJoinableProtocolVersion = parseVersion(IS_JOINABLE_VERSION);
+					if (newPartySettings.isJoinable == false && _serverProtocolVersion < isJoinableProtocolVersion)
+					{
+						_logger->log(LogLevel::Warn, "PartyService::updatePartySettings", "The server does not support joinability restriction ; 'isJoinable' will have no effect. Please update your server-side Party plugin.");
+					}
 
 					// Apply settings locally immediately. If the update RPC fails, we will re-sync the party state.
 					/*PartySettingsInternal update = PartySettingsInternal::fromPartySettings(newPartySettings);
@@ -1797,8 +2357,8 @@ namespace Stormancer
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 
-					bool statusHasChanged = std::any_of(_state.members.begin(), _state.members.end(),
-						[newStatus, this](const auto& member) { return member.userId == _myUserId && member.partyUserStatus != newStatus; });
+					auto localMember = _state.findMember(_myUserId);
+					bool statusHasChanged = localMember && localMember->partyUserStatus != newStatus;
 
 					if (!statusHasChanged)
 					{
@@ -1825,9 +2385,50 @@ namespace Stormancer
 					update.userData = data;
 					update.localPlayers = localPlayers;
 					update.userId = _myUserId;
+
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 					applyUserDataUpdate(update);
+					_pendingUserDataWrites++;
+
+					auto task = _playerDataWriter
+						? _playerDataWriter->write(std::make_pair(std::move(data), std::move(localPlayers)))
+						: sendPlayerDataUpdate(update.userData, update.localPlayers);
+
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					return task.then([wThat](pplx::task<void> task)
+					{
+						if (auto that = wThat.lock())
+						{
+							std::lock_guard<std::recursive_mutex> lg(that->_stateMutex);
+							that->_pendingUserDataWrites--;
+						}
+						task.get();
+					}, pplx::task_options(_dispatcher));
+				}
+
+				pplx::task<void> sendPlayerDataUpdate(const std::vector<byte>& data, const std::vector<LocalPlayerInfos>& localPlayers)
+				{
+					if (!_userDataPatchesEnabled)
+					{
+						return syncStateOnError(_rpcService->rpc<void>("Party.UpdatePartyUserData2", data, localPlayers));
+					}
 
-					return syncStateOnError(_rpcService->rpc<void>("Party.UpdatePartyUserData2", data, localPlayers));
+					// Patches are computed against the last data acknowledged by the server, so updates must not overlap.
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					_userDataUpdate = _userDataUpdate.then([wThat, data, localPlayers](pplx::task<void> previous)
+					{
+						try { previous.get(); }
+						catch (...) {}
+
+						auto that = wThat.lock();
+						if (!that)
+						{
+							throw ObjectDeletedException("PartyService");
+						}
+						return that->sendPlayerData(data, localPlayers);
+					}, pplx::task_options(_dispatcher));
+					return syncStateOnError(_userDataUpdate);
 				}
 
 				///
@@ -1954,20 +2555,32 @@ namespace Stormancer
 
 				std::vector<PartyUserDto> members() const
 				{
-					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
-					return _state.members;
+					auto current = snapshot();
+					std::vector<PartyUserDto> result;
+					result.reserve(current->members.size());
+					for (const auto& member : current->members)
+					{
+						result.push_back(*member);
+					}
+					return result;
 				}
 
 				PartySettings settings() const
 				{
-					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
-					return _state.settings;
+					return snapshot()->settings;
 				}
 
 				std::string leaderId() const
 				{
-					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
-					return _state.leaderId;
+					return snapshot()->leaderId;
+				}
+
+				/// <summary>
+				/// Latest published party state. Never null.
+				/// </summary>
+				std::shared_ptr<const PartyStateSnapshot> snapshot() const
+				{
+					return std::atomic_load(&_snapshot);
 				}
 
 				void initialize()
@@ -1975,6 +2588,26 @@ namespace Stormancer
 					std::weak_ptr<PartyService> wThat = this->shared_from_this();
 					auto scene = _scene.lock();
 
+					if (_writeCoalescingWindow.count() > 0)
+					{
+						_settingsWriter = std::make_shared<WriteCoalescer<PartySettings>>(_writeCoalescingWindow, _dispatcher, [wThat](const PartySettings& settings)
+						{
+							if (auto that = wThat.lock())
+							{
+								return that->sendPartySettings(settings);
+							}
+							return pplx::task_from_exception<void>(ObjectDeletedException("PartyService"));
+						});
+						_playerDataWriter = std::make_shared<WriteCoalescer<std::pair<std::vector<byte>, std::vector<LocalPlayerInfos>>>>(_writeCoalescingWindow, _dispatcher, [wThat](const std::pair<std::vector<byte>, std::vector<LocalPlayerInfos>>& update)
+						{
+							if (auto that = wThat.lock())
+							{
+								return that->sendPlayerDataUpdate(update.first, update.second);
+							}
+							return pplx::task_from_exception<void>(ObjectDeletedException("PartyService"));
+						});
+					}
+
 					auto rpcService = scene->dependencyResolver().resolve<RpcService>();
 
 					rpcService->addProcedure("party.getPartyStateResponse", [wThat](RpcRequestContext_ptr ctx)
@@ -2004,6 +2637,15 @@ namespace Stormancer
 						return pplx::task_from_result();
 					});
 
+					rpcService->addProcedure("party.memberDataPatched", [wThat](RpcRequestContext_ptr ctx)
+					{
+						if (auto that = wThat.lock())
+						{
+							return that->handleUserDataPatchMessage(ctx);
+						}
+						return pplx::task_from_result();
+					});
+
 					rpcService->addProcedure("party.memberStatusUpdated", [wThat](RpcRequestContext_ptr ctx)
 					{
 						if (auto that = wThat.lock())
@@ -2097,6 +2739,115 @@ namespace Stormancer
 				}
 			private:
 
+				pplx::task<void> sendPlayerData(const std::vector<byte>& data, const std::vector<LocalPlayerInfos>& localPlayers)
+				{
+					std::vector<byte> base;
+					bool hasBase;
+					{
+						std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+						base = _ackedUserData;
+						hasBase = _hasAckedUserData;
+					}
+
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					if (hasBase)
+					{
+						auto patch = UserDataPatch::compute(base, data);
+						if (patch.estimatedSize() < data.size())
+						{
+							return _rpcService->rpc<void>("Party.UpdatePartyUserDataPatch", UserDataPatch::hash(base), patch, localPlayers)
+								.then([wThat, data, localPlayers](pplx::task<void> task)
+							{
+								auto that = wThat.lock();
+								if (!that)
+								{
+									throw ObjectDeletedException("PartyService");
+								}
+								try
+								{
+									task.get();
+									that->setAckedUserData(data);
+									return pplx::task_from_result();
+								}
+								catch (const std::exception& ex)
+								{
+									if (strcmp(ex.what(), "party.userDataPatchMismatch") != 0)
+									{
+										throw;
+									}
+									that->_logger->log(LogLevel::Debug, "PartyService::sendPlayerData", "Player data out of sync with the server ; sending full data");
+								}
+								return that->sendFullPlayerData(data, localPlayers);
+							});
+						}
+					}
+					return sendFullPlayerData(data, localPlayers);
+				}
+
+				pplx::task<void> sendFullPlayerData(const std::vector<byte>& data, const std::vector<LocalPlayerInfos>& localPlayers)
+				{
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					return _rpcService->rpc<void>("Party.UpdatePartyUserData2", data, localPlayers).then([wThat, data]
+					{
+						if (auto that = wThat.lock())
+						{
+							that->setAckedUserData(data);
+						}
+					});
+				}
+
+				void setAckedUserData(const std::vector<byte>& data)
+				{
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+					_ackedUserData = data;
+					_hasAckedUserData = true;
+				}
+
+				// Publishes a new snapshot of _state after it has been replaced as a whole. Must be called with _stateMutex held, before firing the corresponding events.
+				void publishState()
+				{
+					auto snapshot = std::make_shared<PartyStateSnapshot>();
+					snapshot->settings = _state.settings;
+					snapshot->leaderId = _state.leaderId;
+					snapshot->version = _state.version;
+					snapshot->members.reserve(_state.members.size());
+					for (const auto& member : _state.members)
+					{
+						snapshot->members.push_back(std::make_shared<const PartyUserDto>(member));
+					}
+					snapshot->memberIndex = std::make_shared<const std::unordered_map<std::string, std::size_t>>(_state.memberIndex);
+					std::atomic_store(&_snapshot, std::shared_ptr<const PartyStateSnapshot>(std::move(snapshot)));
+				}
+
+				// Publishes a new snapshot of _state after an incremental change. Only the members in changedMembers are copied,
+				// the others are shared with the previous snapshot. The member index is rebuilt only when membershipChanged is true.
+				// Must be called with _stateMutex held, before firing the corresponding events.
+				void publishStateChanges(const std::unordered_set<std::string>& changedMembers = {}, bool membershipChanged = false)
+				{
+					auto previous = std::atomic_load(&_snapshot);
+					auto snapshot = std::make_shared<PartyStateSnapshot>();
+					snapshot->settings = _state.settings;
+					snapshot->leaderId = _state.leaderId;
+					snapshot->version = _state.version;
+					snapshot->members.reserve(_state.members.size());
+					for (const auto& member : _state.members)
+					{
+						auto it = previous->memberIndex->find(member.userId);
+						if (it != previous->memberIndex->end() && changedMembers.find(member.userId) == changedMembers.end())
+						{
+							snapshot->members.push_back(previous->members[it->second]);
+						}
+						else
+						{
+							snapshot->members.push_back(std::make_shared<const PartyUserDto>(member));
+						}
+					}
+					snapshot->memberIndex = membershipChanged
+						? std::make_shared<const std::unordered_map<std::string, std::size_t>>(_state.memberIndex)
+						: previous->memberIndex;
+					std::atomic_store(&_snapshot, std::shared_ptr<const PartyStateSnapshot>(std::move(snapshot)));
+				}
+
 				pplx::task<void> syncStateOnError(pplx::task<void> task)
 				{
 					std::weak_ptr<PartyService> wThat = this->shared_from_this();
@@ -2218,49 +2969,174 @@ namespace Stormancer
 				pplx::task<void> getPartyStateImpl()
 				{
 					static const int originalGetPartyStateVersion = parseVersion("2019-08-30.1");
+					static const int incrementalSyncVersion = parseVersion(INCREMENTAL_SYNC_VERSION);
 					if (_serverProtocolVersion == originalGetPartyStateVersion)
 					{
 						return _rpcService->rpc("party.getpartystate");
 					}
-					else
+
+					int knownVersion;
 					{
-						std::weak_ptr<PartyService> wThat = this->shared_from_this();
-						return _rpcService->rpc<PartyState>("party.getpartystate2").then([wThat](PartyState state)
+						std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+						knownVersion = _state.version;
+					}
+
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					if (_serverProtocolVersion >= incrementalSyncVersion && knownVersion > 0)
+					{
+						// Ask only for the updates we missed ; fall back to the full state if the server no longer has them.
+						return _rpcService->rpc<PartyStateDeltas>("party.getstatedeltas", knownVersion).then([wThat](pplx::task<PartyStateDeltas> task)
 						{
-							if (auto that = wThat.lock())
+							auto that = wThat.lock();
+							if (!that)
+							{
+								throw ObjectDeletedException("PartyService");
+							}
+
+							try
+							{
+								if (that->applyStateDeltas(task.get()))
+								{
+									return pplx::task_from_result();
+								}
+							}
+							catch (const std::exception& ex)
 							{
-								that->applyPartyStateResponse(state);
+								that->_logger->log(LogLevel::Debug, "PartyService::getPartyStateImpl", "Incremental sync failed, requesting the full party state", ex);
 							}
+							return that->getFullPartyState();
 						});
 					}
+
+					return getFullPartyState();
+				}
+
+				pplx::task<void> getFullPartyState()
+				{
+					std::weak_ptr<PartyService> wThat = this->shared_from_this();
+					return _rpcService->rpc<PartyState>("party.getpartystate2").then([wThat](PartyState state)
+					{
+						if (auto that = wThat.lock())
+						{
+							that->applyPartyStateResponse(state);
+						}
+					});
+				}
+
+				// Returns false if the deltas cannot bring the local state up to date, in which case nothing is applied past the first gap.
+				bool applyStateDeltas(const PartyStateDeltas& response)
+				{
+					if (response.fullStateRequired)
+					{
+						return false;
+					}
+
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+
+					for (const auto& delta : response.deltas)
+					{
+						if (delta.version <= _state.version)
+						{
+							// Already received through the regular notification route while the request was in flight
+							continue;
+						}
+						if (delta.version != _state.version + 1)
+						{
+							return false;
+						}
+						// Set the version before applying, so that the snapshot published by the update carries the version it corresponds to.
+						auto previousVersion = _state.version;
+						_state.version = delta.version;
+						if (!applyStateDelta(delta))
+						{
+							_state.version = previousVersion;
+							return false;
+						}
+						if (std::atomic_load(&_snapshot)->version != _state.version)
+						{
+							// The update didn't change the state (for instance a status that was already set), publish the new version anyway.
+							publishStateChanges();
+						}
+					}
+
+					_logger->log(LogLevel::Trace, "PartyService::applyStateDeltas", "Applied " + std::to_string(response.deltas.size()) + " state deltas, version = " + std::to_string(_state.version));
+					return true;
+				}
+
+				bool applyStateDelta(const PartyStateDelta& delta)
+				{
+					Serializer serializer;
+					ibytestream stream(delta.payload.data(), delta.payload.size());
+
+					if (delta.route == "party.settingsUpdated")
+					{
+						applySettingsUpdate(serializer.deserializeOne<PartySettingsInternal>(stream));
+					}
+					else if (delta.route == "party.memberDataUpdated")
+					{
+						auto update = serializer.deserializeOne<PartyUserData>(stream);
+						if (!isOwnUserDataWritePending(update.userId))
+						{
+							applyUserDataUpdate(update);
+						}
+					}
+					else if (delta.route == "party.memberDataPatched")
+					{
+						applyUserDataPatch(serializer.deserializeOne<PartyUserDataPatch>(stream));
+					}
+					else if (delta.route == "party.memberStatusUpdated")
+					{
+						applyMemberStatusUpdate(serializer.deserializeOne<BatchStatusUpdate>(stream));
+					}
+					else if (delta.route == "party.memberConnected")
+					{
+						applyMemberConnected(serializer.deserializeOne<PartyUserDto>(stream));
+					}
+					else if (delta.route == "party.memberDisconnected")
+					{
+						applyMemberDisconnection(serializer.deserializeOne<MemberDisconnection>(stream));
+					}
+					else if (delta.route == "party.leaderChanged")
+					{
+						applyLeaderChange(serializer.deserializeOne<std::string>(stream));
+					}
+					else
+					{
+						_logger->log(LogLevel::Warn, "PartyService::applyStateDelta", "Unknown state update route " + delta.route);
+						return false;
+					}
+					return true;
 				}
 
 				pplx::task<void> syncPartyStateTaskWithRetries()
 				{
 					std::weak_ptr<PartyService> wThat = this->shared_from_this();
-					return getPartyStateImpl().then([wThat](pplx::task<void> task)
+					return _stateSyncRetryPolicy.execute<void>([wThat](pplx::cancellation_token)
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							return pplx::task_from_exception<void>(ObjectDeletedException("PartyService"));
+						}
+						return that->getPartyStateImpl();
+					}, [wThat](const std::exception& ex)
+					{
+						if (auto that = wThat.lock())
+						{
+							that->_logger->log(LogLevel::Error, "PartyService::syncPartyStateTaskWithRetries", "An error occurred during syncPartyState, retrying", ex);
+							return true;
+						}
+						return false;
+					}).then([](pplx::task<void> task)
 					{
 						try
 						{
 							task.get();
 						}
-						catch (const std::exception& ex)
+						catch (...)
 						{
-							if (auto that = wThat.lock())
-							{
-								that->_logger->log(LogLevel::Error, "PartyService::syncPartyStateTaskWithRetries", "An error occurred during syncPartyState, retrying", ex);
-								return taskDelay(std::chrono::milliseconds(200))
-									.then([wThat]
-								{
-									if (auto that = wThat.lock())
-									{
-										return that->syncPartyStateTaskWithRetries();
-									}
-									return pplx::task_from_result();
-								});
-							}
+							// The party was left, or the configured max attempts were reached. The next state update will trigger a new sync.
 						}
-						return pplx::task_from_result();
 					});
 				}
 
@@ -2341,27 +3217,6 @@ namespace Stormancer
 					return pplx::task_from_result();
 				}
 
-				static const PartyUserDto* findMember(const std::vector<PartyUserDto>& users, const std::string& userId)
-				{
-					auto it = std::find_if(users.begin(), users.end(), [&userId](const PartyUserDto& dto) { return dto.userId == userId; });
-					if (it != users.end())
-					{
-						return &(*it);
-					}
-					else
-					{
-						return nullptr;
-					}
-				}
-
-				static std::unordered_map<std::string, PartyUserDto> makeMemberMap(const std::vector<PartyUserDto>& users)
-				{
-					std::unordered_map<std::string, PartyUserDto> map;
-					map.reserve(users.size());
-					std::transform(users.begin(), users.end(), std::inserter(map, map.end()), [](PartyUserDto user) { return std::make_pair(user.userId, std::move(user)); });
-					return map;
-				}
-
 				void applyPartyStateResponse(PartyState state)
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
@@ -2370,7 +3225,7 @@ namespace Stormancer
 
 					// Compare the up-to-date member list with the one we currently have, and generate MemberUpdate events where appropriate
 					MembersUpdate updates;
-					auto previousMembers = makeMemberMap(_state.members);
+					std::vector<bool> stillPresent(_state.members.size(), false);
 
 					for (auto& newMember : state.members)
 					{
@@ -2378,12 +3233,14 @@ namespace Stormancer
 						{
 							newMember.isLeader = true;
 						}
-						if (previousMembers.count(newMember.userId) == 0)
+						auto previous = _state.memberIndex.find(newMember.userId);
+						if (previous == _state.memberIndex.end())
 						{
 							updates.updatedMembers.emplace_back(newMember, MembersUpdate::Joined);
 							continue;
 						}
-						const auto& oldMember = previousMembers[newMember.userId];
+						stillPresent[previous->second] = true;
+						const auto& oldMember = _state.members[previous->second];
 						MembersUpdate::MemberUpdate update;
 						if (oldMember.isLeader != newMember.isLeader)
 						{
@@ -2397,19 +3254,33 @@ namespace Stormancer
 						{
 							update.changes.set(MembersUpdate::DataUpdated);
 						}
-						previousMembers.erase(newMember.userId);
 						if (update.changes.any())
 						{
 							update.member = newMember;
 							updates.updatedMembers.push_back(std::move(update));
 						}
 					}
-					for (const auto& memberWhoLeft : previousMembers)
+					for (std::size_t i = 0; i < _state.members.size(); ++i)
 					{
-						updates.updatedMembers.emplace_back(memberWhoLeft.second, MembersUpdate::Left);
+						if (!stillPresent[i])
+						{
+							updates.updatedMembers.emplace_back(_state.members[i], MembersUpdate::Left);
+						}
 					}
 
 					_state = std::move(state);
+					_state.reindexMembers();
+					publishState();
+
+					if (_userDataPatchesEnabled && !_hasAckedUserData)
+					{
+						if (auto localMember = _state.findMember(_myUserId))
+						{
+							_ackedUserData = localMember->userData;
+							_hasAckedUserData = true;
+							enableUserDataPatches();
+						}
+					}
 					updateGameFinder();
 
 					_partyStateReceived.set();
@@ -2421,45 +3292,110 @@ namespace Stormancer
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 
-					if (_state.settings.settingsVersionNumber != update.settingsVersionNumber)
+					if (_state.settings.settingsVersionNumber != update.settingsVersionNumber)
+					{
+						_state.settings = update;
+						publishStateChanges();
+						updateGameFinder();
+						this->UpdatedPartySettings(_state.settings);
+					}
+				}
+
+				pplx::task<void> handleSettingsUpdateMessage(RpcRequestContext_ptr ctx)
+				{
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+
+					if (checkVersionNumber(ctx))
+					{
+						_logger->log(LogLevel::Trace, "PartyService::handleSettingsUpdate", "Received settings update, version = " + std::to_string(_state.version));
+						applySettingsUpdate(ctx->readObject<PartySettingsInternal>());
+					}
+
+					return pplx::task_from_result();
+				}
+
+				void applyUserDataUpdate(const PartyUserData& update)
+				{
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+
+					auto member = _state.findMember(update.userId);
+
+					if (member)
+					{
+
+						member->userData = update.userData;
+						member->localPlayers = update.localPlayers;
+						publishStateChanges({ update.userId });
+						MembersUpdate updates;
+						updates.updatedMembers.emplace_back(*member, MembersUpdate::DataUpdated);
+						PartyMembersUpdated(updates);
+
+					}
+				}
+
+
+				void applyUserDataPatch(const PartyUserDataPatch& message)
+				{
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+
+					if (isOwnUserDataWritePending(message.userId))
 					{
-						_state.settings = update;
-						updateGameFinder();
-						this->UpdatedPartySettings(_state.settings);
+						return;
+					}
+
+					auto member = _state.findMember(message.userId);
+					if (!member)
+					{
+						return;
+					}
+
+					PartyUserData update;
+					update.userId = message.userId;
+					update.localPlayers = message.localPlayers;
+					if (!message.patch.tryApply(member->userData, update.userData))
+					{
+						_logger->log(LogLevel::Warn, "PartyService::applyUserDataPatch", "Invalid player data patch for " + message.userId + " ; requesting the full party state");
+						syncPartyState();
+						return;
 					}
+					applyUserDataUpdate(update);
 				}
 
-				pplx::task<void> handleSettingsUpdateMessage(RpcRequestContext_ptr ctx)
+				pplx::task<void> handleUserDataPatchMessage(RpcRequestContext_ptr ctx)
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 
 					if (checkVersionNumber(ctx))
 					{
-						_logger->log(LogLevel::Trace, "PartyService::handleSettingsUpdate", "Received settings update, version = " + std::to_string(_state.version));
-						applySettingsUpdate(ctx->readObject<PartySettingsInternal>());
+						_logger->log(LogLevel::Trace, "PartyService::handleUserDataPatch", "Received user data patch, version = " + std::to_string(_state.version));
+						applyUserDataPatch(ctx->readObject<PartyUserDataPatch>());
 					}
 
 					return pplx::task_from_result();
 				}
 
-				void applyUserDataUpdate(const PartyUserData& update)
+				void enableUserDataPatches()
 				{
-					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
-
-					auto member = std::find_if(_state.members.begin(), _state.members.end(), [&update](const PartyUserDto& user) { return update.userId == user.userId; });
-
-					if (member != _state.members.end())
+					auto logger = _logger;
+					_rpcService->rpc<void>("Party.EnableUserDataPatches").then([logger](pplx::task<void> task)
 					{
-
-						member->userData = update.userData;
-						member->localPlayers = update.localPlayers;
-						MembersUpdate updates;
-						updates.updatedMembers.emplace_back(*member, MembersUpdate::DataUpdated);
-						PartyMembersUpdated(updates);
-
-					}
+						try
+						{
+							task.get();
+						}
+						catch (const std::exception& ex)
+						{
+							logger->log(LogLevel::Warn, "PartyService::enableUserDataPatches", "Could not enable player data patches", ex);
+						}
+					});
 				}
 
+				// The local player data already holds the latest value written. Updates of our own data received while writes are pending
+				// carry older values, and applying them would make the next updatePlayerData() call start from stale data.
+				bool isOwnUserDataWritePending(const std::string& userId) const
+				{
+					return _pendingUserDataWrites > 0 && userId == _myUserId;
+				}
 
 				pplx::task<void> handleUserDataUpdateMessage(RpcRequestContext_ptr ctx)
 				{
@@ -2468,7 +3404,11 @@ namespace Stormancer
 					if (checkVersionNumber(ctx))
 					{
 						_logger->log(LogLevel::Trace, "PartyService::handleUserDataUpdate", "Received user data update, version = " + std::to_string(_state.version));
-						applyUserDataUpdate(ctx->readObject<PartyUserData>());
+						auto update = ctx->readObject<PartyUserData>();
+						if (!isOwnUserDataWritePending(update.userId))
+						{
+							applyUserDataUpdate(update);
+						}
 					}
 
 					return pplx::task_from_result();
@@ -2478,22 +3418,25 @@ namespace Stormancer
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 
+					// Single pass over the batch: each entry is an index lookup, and all changes are reported in one event.
 					MembersUpdate membersUpdate;
-					bool updated = false;
+					membersUpdate.updatedMembers.reserve(updates.memberStatus.size());
+					std::unordered_set<std::string> changedMembers;
 					for (const auto& update : updates.memberStatus)
 					{
-						auto member = std::find_if(_state.members.begin(), _state.members.end(), [&update](const PartyUserDto& user) { return update.userId == user.userId; });
+						auto member = _state.findMember(update.userId);
 
-						if (member != _state.members.end())
+						if (member && member->partyUserStatus != update.status)
 						{
-							updated = updated || (member->partyUserStatus != update.status);
 							member->partyUserStatus = update.status;
 							membersUpdate.updatedMembers.emplace_back(*member, MembersUpdate::StatusUpdated);
+							changedMembers.insert(update.userId);
 						}
 					}
 
-					if (updated)
+					if (!membersUpdate.updatedMembers.empty())
 					{
+						publishStateChanges(changedMembers);
 						PartyMembersUpdated(membersUpdate);
 					}
 				}
@@ -2521,21 +3464,56 @@ namespace Stormancer
 						auto member = ctx->readObject<PartyUserDto>();
 						_logger->log(LogLevel::Trace, "PartyService::handleMemberConnected", "New party member: Id=" + member.userId + ", version = " + std::to_string(_state.version));
 
-						_state.members.push_back(member);
+						applyMemberConnected(member);
+					}
+
+					return pplx::task_from_result();
+				}
+
+				void applyMemberConnected(const PartyUserDto& member)
+				{
+					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
+
+					if (auto existing = _state.findMember(member.userId))
+					{
+						// Already a member (for instance a reconnection, or a replayed update we already received): report what changed instead of a second Joined.
+						MembersUpdate::MemberUpdate memberUpdate;
+						if (existing->partyUserStatus != member.partyUserStatus)
+						{
+							memberUpdate.changes.set(MembersUpdate::StatusUpdated);
+						}
+						if (existing->userData != member.userData)
+						{
+							memberUpdate.changes.set(MembersUpdate::DataUpdated);
+						}
+						if (memberUpdate.changes.none())
+						{
+							return;
+						}
+						auto isLeader = existing->isLeader;
+						*existing = member;
+						existing->isLeader = isLeader;
+						publishStateChanges({ member.userId });
+						memberUpdate.member = *existing;
 						MembersUpdate update;
-						update.updatedMembers.emplace_back(member, MembersUpdate::Joined);
+						update.updatedMembers.push_back(std::move(memberUpdate));
 						PartyMembersUpdated(update);
+						return;
 					}
 
-					return pplx::task_from_result();
+					_state.addMember(member);
+					publishStateChanges({ member.userId }, true);
+					MembersUpdate update;
+					update.updatedMembers.emplace_back(member, MembersUpdate::Joined);
+					PartyMembersUpdated(update);
 				}
 
 				void applyMemberDisconnection(const MemberDisconnection& message)
 				{
 					std::lock_guard<std::recursive_mutex> lg(_stateMutex);
 
-					auto member = std::find_if(_state.members.begin(), _state.members.end(), [&message](const PartyUserDto& user) { return message.userId == user.userId; });
-					if (member != _state.members.end())
+					auto member = _state.findMember(message.userId);
+					if (member)
 					{
 						MembersUpdate update;
 						MembersUpdate::MemberUpdate memberUpdate(*member, MembersUpdate::Left);
@@ -2544,7 +3522,8 @@ namespace Stormancer
 							memberUpdate.changes.set(MembersUpdate::Kicked);
 						}
 						update.updatedMembers.push_back(memberUpdate);
-						_state.members.erase(member);
+						_state.removeMember(message.userId);
+						publishStateChanges({}, true);
 						PartyMembersUpdated(update);
 					}
 				}
@@ -2570,9 +3549,11 @@ namespace Stormancer
 
 					if (_state.leaderId != newLeaderId)
 					{
+						auto previousLeaderId = std::move(_state.leaderId);
 						_state.leaderId = newLeaderId;
 						MembersUpdate update;
-						updateLeader(update);
+						updateLeader(previousLeaderId, update);
+						publishStateChanges();
 						PartyMembersUpdated(update);
 					}
 				}
@@ -2591,18 +3572,17 @@ namespace Stormancer
 					return pplx::task_from_result();
 				}
 
-				void updateLeader(MembersUpdate& update)
+				void updateLeader(const std::string& previousLeaderId, MembersUpdate& update)
 				{
-					const std::string& newLeaderId = _state.leaderId;
-					auto currentLeader = std::find_if(_state.members.begin(), _state.members.end(), [](const PartyUserDto& user) { return user.isLeader; });
-					if (currentLeader != _state.members.end())
+					auto currentLeader = _state.findMember(previousLeaderId);
+					if (currentLeader && currentLeader->isLeader)
 					{
 						currentLeader->isLeader = false;
 						update.updatedMembers.emplace_back(*currentLeader, MembersUpdate::DemotedFromLeader);
 					}
 
-					auto newLeader = std::find_if(_state.members.begin(), _state.members.end(), [&newLeaderId](const PartyUserDto& user) { return newLeaderId == user.userId; });
-					if (newLeader != _state.members.end())
+					auto newLeader = _state.findMember(_state.leaderId);
+					if (newLeader)
 					{
 						newLeader->isLeader = true;
 						update.updatedMembers.emplace_back(*newLeader, MembersUpdate::PromotedToLeader);
@@ -2664,6 +3644,8 @@ namespace Stormancer
 				}
 
 				PartyState _state;
+				// Immutable copy of _state for lock-free readers. Accessed with std::atomic_load/std::atomic_store.
+				std::shared_ptr<const PartyStateSnapshot> _snapshot = std::make_shared<const PartyStateSnapshot>();
 				std::string _currentGameFinder;
 				std::weak_ptr<Scene> _scene;
 				std::shared_ptr<ILogger> _logger;
@@ -2683,6 +3665,22 @@ namespace Stormancer
 				pplx::task_completion_event<void> _partyStateReceived;
 				pplx::task<void> _stateSyncRequest = pplx::task_from_result();
 				int _serverProtocolVersion = 0;
+				bool _userDataPatchesEnabled = false;
+				// Last player data acknowledged by the server, base of the next patch
+				std::vector<byte> _ackedUserData;
+				bool _hasAckedUserData = false;
+				// Serializes player data updates when patches are enabled
+				pplx::task<void> _userDataUpdate = pplx::task_from_result();
+				std::chrono::milliseconds _writeCoalescingWindow{ 0 };
+				RetryPolicy _stateSyncRetryPolicy;
+				// Only set when _writeCoalescingWindow is not 0
+				std::shared_ptr<WriteCoalescer<PartySettings>> _settingsWriter;
+				std::shared_ptr<WriteCoalescer<std::pair<std::vector<byte>, std::vector<LocalPlayerInfos>>>> _playerDataWriter;
+				// Settings as they will be once the pending updatePartySettings() writes are applied by the server. Null when none is pending.
+				std::shared_ptr<const PartySettings> _writtenSettings;
+				uint64_t _writtenSettingsGeneration = 0;
+				// Number of updatePlayerData() writes not completed yet
+				int _pendingUserDataWrites = 0;
 
 				std::unordered_map<std::string, InvitationRequest> _pendingStormancerInvitations;
 				mutable std::recursive_mutex _invitationsMutex;
@@ -2742,6 +3740,11 @@ namespace Stormancer
 					return _partyScene->id();
 				}
 
+				std::shared_ptr<const PartyStateSnapshot> snapshot() const
+				{
+					return _partyService->snapshot();
+				}
+
 				std::shared_ptr<PartyService> partyService() const
 				{
 					return _partyService;
@@ -2780,9 +3783,10 @@ namespace Stormancer
 			public:
 
 				static constexpr const char* METADATA_KEY = "stormancer.partymanagement";
-				static constexpr const char* PROTOCOL_VERSION = "2020-05-20.1";
+				static constexpr const char* PROTOCOL_VERSION = "2026-10-18.1";
 
 				static constexpr const char* IS_JOINABLE_VERSION = "2019-12-13.1";
+				static constexpr const char* SEARCH_CHANGES_VERSION = "2026-10-18.1";
 
 				PartyManagementService(std::shared_ptr<Scene> scene)
 					: _scene(scene)
@@ -2826,6 +3830,31 @@ namespace Stormancer
 					auto rpc = _scene.lock()->dependencyResolver().resolve<RpcService>();
 					return rpc->rpc<SearchResult>("PartyManagement.SearchParties", cancellationToken, jsonQuery, skip, size);
 				}
+
+				// Hits whose hash is in knownHashes come back with unchanged = true and no content.
+				pplx::task<PartySearchChanges> searchPartiesChanged(const std::string& jsonQuery, Stormancer::uint32 skip, Stormancer::uint32 size, const std::unordered_map<std::string, uint64_t>& knownHashes, pplx::cancellation_token cancellationToken)
+				{
+					static const int searchChangesVersion = parseVersion(SEARCH_CHANGES_VERSION);
+					auto rpc = _scene.lock()->dependencyResolver().resolve<RpcService>();
+					if (_serverProtocolVersion >= searchChangesVersion)
+					{
+						return rpc->rpc<PartySearchChanges>("PartyManagement.SearchPartiesChanged", cancellationToken, jsonQuery, skip, size, knownHashes);
+					}
+
+					return searchParties(jsonQuery, skip, size, cancellationToken).then([](SearchResult result)
+					{
+						PartySearchChanges changes;
+						changes.total = result.total;
+						for (auto& hit : result.hits)
+						{
+							PartySearchDocumentChange change;
+							change.id = std::move(hit.id);
+							change.content = std::move(hit.content);
+							changes.hits.push_back(std::move(change));
+						}
+						return changes;
+					});
+				}
 			private:
 
 				std::weak_ptr<Scene> _scene;
@@ -2833,6 +3862,243 @@ namespace Stormancer
 				int _serverProtocolVersion = 0;
 			};
 
+			// Search pages by query and position, shared by all the PartySearch objects of a Party_Impl.
+			class PartySearchCache
+			{
+			public:
+
+				struct Entry
+				{
+					PartySearchPage page;
+					std::unordered_map<std::string, uint64_t> hashes;
+					std::chrono::steady_clock::time_point fetchedOn;
+				};
+
+				PartySearchCache(std::chrono::milliseconds ttl, std::size_t maxEntries = 128)
+					: _ttl(ttl)
+					, _maxEntries(maxEntries)
+				{
+				}
+
+				static std::string key(const std::string& jsonQuery, Stormancer::uint32 skip, Stormancer::uint32 size)
+				{
+					return std::to_string(skip) + ":" + std::to_string(size) + ":" + jsonQuery;
+				}
+
+				// Returns the entry even if it expired, so that its hashes can be used for an incremental refresh.
+				bool tryGet(const std::string& key, Entry& entry, bool& fresh) const
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					auto it = _entries.find(key);
+					if (it == _entries.end())
+					{
+						return false;
+					}
+					entry = it->second;
+					fresh = std::chrono::steady_clock::now() - entry.fetchedOn < _ttl;
+					return true;
+				}
+
+				void set(const std::string& key, Entry entry)
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					_entries[key] = std::move(entry);
+					while (_entries.size() > _maxEntries)
+					{
+						auto oldest = std::min_element(_entries.begin(), _entries.end(), [](const std::pair<const std::string, Entry>& a, const std::pair<const std::string, Entry>& b)
+						{
+							return a.second.fetchedOn < b.second.fetchedOn;
+						});
+						_entries.erase(oldest);
+					}
+				}
+
+				void clear()
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					_entries.clear();
+				}
+
+			private:
+
+				std::chrono::milliseconds _ttl;
+				std::size_t _maxEntries;
+				mutable std::mutex _mutex;
+				std::unordered_map<std::string, Entry> _entries;
+			};
+
+			class PartySearch_Impl : public PartySearch, public std::enable_shared_from_this<PartySearch_Impl>
+			{
+			public:
+
+				using Fetcher = std::function<pplx::task<PartySearchChanges>(const std::string&, Stormancer::uint32, Stormancer::uint32, const std::unordered_map<std::string, uint64_t>&, pplx::cancellation_token)>;
+
+				PartySearch_Impl(std::string jsonQuery, Stormancer::uint32 pageSize, std::shared_ptr<PartySearchCache> cache, Fetcher fetch, std::shared_ptr<IActionDispatcher> dispatcher)
+					: _query(std::move(jsonQuery))
+					, _pageSize(pageSize)
+					, _cache(cache)
+					, _fetch(fetch)
+					, _dispatcher(dispatcher)
+				{
+				}
+
+				const std::string& query() const override
+				{
+					return _query;
+				}
+
+				Stormancer::uint32 pageSize() const override
+				{
+					return _pageSize;
+				}
+
+				pplx::task<PartySearchPage> getPage(Stormancer::uint32 pageIndex, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					return getPageImpl(pageIndex, false, ct);
+				}
+
+				pplx::task<PartySearchPage> refreshPage(Stormancer::uint32 pageIndex, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					return getPageImpl(pageIndex, true, ct);
+				}
+
+				pplx::task<void> streamPages(Stormancer::uint32 maxResults, std::function<void(const PartySearchPage&)> onPage, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					return streamFrom(getPage(0, ct), 0, maxResults, onPage, ct);
+				}
+
+			private:
+
+				pplx::task<void> streamFrom(pplx::task<PartySearchPage> current, Stormancer::uint32 pageIndex, Stormancer::uint32 maxResults, std::function<void(const PartySearchPage&)> onPage, pplx::cancellation_token ct)
+				{
+					std::weak_ptr<PartySearch_Impl> wThat = this->shared_from_this();
+					return current.then([wThat, pageIndex, maxResults, onPage, ct](PartySearchPage page)
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							throw ObjectDeletedException("PartySearch");
+						}
+
+						auto end = std::min(page.total, maxResults);
+						bool hasMore = !page.hits.empty() && page.skip + page.hits.size() < end;
+						// Request the next page before handing this one to the caller
+						auto next = hasMore ? that->getPage(pageIndex + 1, ct) : pplx::task_from_result(PartySearchPage{});
+
+						if (page.skip + page.hits.size() > maxResults)
+						{
+							page.hits.resize(maxResults > page.skip ? maxResults - page.skip : 0);
+						}
+						onPage(page);
+
+						if (hasMore)
+						{
+							return that->streamFrom(next, pageIndex + 1, maxResults, onPage, ct);
+						}
+						return pplx::task_from_result();
+					}, pplx::task_options(_dispatcher));
+				}
+
+				pplx::task<PartySearchPage> getPageImpl(Stormancer::uint32 pageIndex, bool forceRefresh, pplx::cancellation_token ct)
+				{
+					auto skip = pageIndex * _pageSize;
+					auto key = PartySearchCache::key(_query, skip, _pageSize);
+
+					auto previous = std::make_shared<PartySearchCache::Entry>();
+					bool fresh = false;
+					bool hasPrevious = _cache->tryGet(key, *previous, fresh);
+					if (hasPrevious && fresh && !forceRefresh)
+					{
+						auto page = previous->page;
+						page.fromCache = true;
+						return pplx::task_from_result(page, pplx::task_options(_dispatcher));
+					}
+
+					std::unordered_map<std::string, uint64_t> knownHashes;
+					if (hasPrevious)
+					{
+						knownHashes = previous->hashes;
+					}
+
+					auto cache = _cache;
+					auto fetch = _fetch;
+					auto query = _query;
+					auto size = _pageSize;
+					return _fetch(_query, skip, _pageSize, knownHashes, ct).then([cache, key, previous, fetch, query, skip, size, ct](PartySearchChanges changes)
+					{
+						std::unordered_map<std::string, const PartyDocument*> previousHits;
+						for (const auto& hit : previous->page.hits)
+						{
+							previousHits[hit.id] = &hit;
+						}
+
+						PartySearchCache::Entry entry;
+						entry.page.skip = skip;
+						entry.page.total = changes.total;
+						entry.fetchedOn = std::chrono::steady_clock::now();
+						for (auto& change : changes.hits)
+						{
+							PartyDocument document;
+							document.id = change.id;
+							if (change.unchanged)
+							{
+								auto it = previousHits.find(change.id);
+								if (it == previousHits.end())
+								{
+									// Should not happen: our cache and the hashes we sent are out of sync. Fetch everything.
+									return fetch(query, skip, size, {}, ct).then([cache, key, skip](PartySearchChanges changes)
+									{
+										return storeFullPage(cache, key, skip, changes);
+									});
+								}
+								document.content = it->second->content;
+							}
+							else
+							{
+								document.content = std::move(change.content);
+							}
+							if (change.hash != 0)
+							{
+								entry.hashes[change.id] = change.hash;
+							}
+							entry.page.hits.push_back(std::move(document));
+						}
+
+						auto page = entry.page;
+						cache->set(key, std::move(entry));
+						return pplx::task_from_result(page);
+					});
+				}
+
+				static PartySearchPage storeFullPage(std::shared_ptr<PartySearchCache> cache, const std::string& key, Stormancer::uint32 skip, PartySearchChanges& changes)
+				{
+					PartySearchCache::Entry entry;
+					entry.page.skip = skip;
+					entry.page.total = changes.total;
+					entry.fetchedOn = std::chrono::steady_clock::now();
+					for (auto& change : changes.hits)
+					{
+						if (change.hash != 0)
+						{
+							entry.hashes[change.id] = change.hash;
+						}
+						PartyDocument document;
+						document.id = std::move(change.id);
+						document.content = std::move(change.content);
+						entry.page.hits.push_back(std::move(document));
+					}
+					auto page = entry.page;
+					cache->set(key, std::move(entry));
+					return page;
+				}
+
+				std::string _query;
+				Stormancer::uint32 _pageSize;
+				std::shared_ptr<PartySearchCache> _cache;
+				Fetcher _fetch;
+				std::shared_ptr<IActionDispatcher> _dispatcher;
+			};
+
 			// Disable deprecation warnings on implementations of deprecated methods
 			STORM_WARNINGS_PUSH;
 			STORM_MSVC_WARNING(disable: 4996);
@@ -2855,6 +4121,9 @@ namespace Stormancer
 					, _scope(client->dependencyResolver().beginLifetimeScope("party"))
 					, _wClient(client) // _wClient is a weak_ptr so no cycle here
 				{
+					auto config = client->dependencyResolver().resolve<Configuration>();
+					auto searchCacheTtl = readConfigurationParameter(config, ConfigurationKeys::SearchCacheTtlMs, std::chrono::milliseconds(2000));
+					_searchCache = std::make_shared<PartySearchCache>(searchCacheTtl);
 				}
 
 				const DependencyScope& dependencyScope() const override
@@ -3262,19 +4531,13 @@ namespace Stormancer
 						return false;
 					}
 
-					auto myId = users->userId();
-					auto members = party->members();
-					auto it = std::find_if(members.begin(), members.end(), [&myId](const PartyUserDto& user)
-					{
-						return user.userId == myId;
-					});
-
-					if (it != members.end())
+					auto snapshot = party->snapshot();
+					auto member = snapshot->findMember(users->userId());
+					if (member)
 					{
-
 						if (localMember)
 						{
-							*localMember = *it;
+							*localMember = *member;
 						}
 						return true;
 					}
@@ -3296,6 +4559,17 @@ namespace Stormancer
 					return party->settings();
 				}
 
+				std::shared_ptr<const PartyStateSnapshot> getPartyStateSnapshot() const override
+				{
+					auto party = tryGetParty();
+					if (!party)
+					{
+						return nullptr;
+					}
+
+					return party->snapshot();
+				}
+
 				PartyId getPartyId() const override
 				{
 					auto party = tryGetParty();
@@ -3377,6 +4651,25 @@ namespace Stormancer
 					});
 				}
 
+				std::shared_ptr<PartySearch> createPartySearch(const std::string& jsonQuery, Stormancer::uint32 pageSize = 20) override
+				{
+					auto wThat = STORM_WEAK_FROM_THIS();
+					auto fetch = [wThat](const std::string& query, Stormancer::uint32 skip, Stormancer::uint32 size, const std::unordered_map<std::string, uint64_t>& knownHashes, pplx::cancellation_token ct)
+					{
+						auto that = wThat.lock();
+						if (!that)
+						{
+							return pplx::task_from_exception<PartySearchChanges>(ObjectDeletedException("PartyApi"));
+						}
+						return that->getPartyManagementService(ct)
+							.then([query, skip, size, knownHashes, ct](std::shared_ptr<PartyManagementService> service)
+						{
+							return service->searchPartiesChanged(query, skip, size, knownHashes, ct);
+						});
+					};
+					return std::make_shared<PartySearch_Impl>(jsonQuery, pageSize, _searchCache, fetch, _dispatcher);
+				}
+
 				pplx::task<void> cancelInvitationCode(pplx::cancellation_token ct = pplx::cancellation_token::none()) override
 				{
 					auto party = tryGetParty();
@@ -3635,6 +4928,89 @@ namespace Stormancer
 					return pplx::when_all(tasks.begin(), tasks.end(), _dispatcher);
 				}
 
+				pplx::task<void> streamAdvertisedParties(std::function<void(const AdvertisedPartiesResult&)> onResult, std::chrono::milliseconds platformTimeout = std::chrono::milliseconds(5000), pplx::cancellation_token ct = pplx::cancellation_token::none()) override
+				{
+					std::vector<std::shared_ptr<Platform::IPlatformSupportProvider>> providers;
+					try
+					{
+						providers = platformProviders();
+					}
+					catch (const std::exception& ex)
+					{
+						return pplx::task_from_exception<void>(ex);
+					}
+
+					std::vector<pplx::task<void>> tasks;
+					for (auto& provider : providers)
+					{
+						auto platform = provider->getPlatformName();
+						auto deadline = timeout(platformTimeout, ct);
+						pplx::task_completion_event<AdvertisedPartiesResult> tce;
+
+						// Whichever comes first between the deadline and the provider response sets the result.
+						// The deadline is cancelled both by the timeout and by ct, ct tells them apart.
+						auto registration = deadline.register_callback([tce, platform, ct]()
+						{
+							AdvertisedPartiesResult result;
+							result.platform = platform;
+							if (ct.is_canceled())
+							{
+								result.error = "Cancelled";
+								result.cancelled = true;
+							}
+							else
+							{
+								result.error = "Timeout";
+								result.timedOut = true;
+							}
+							tce.set(result);
+						});
+
+						pplx::task<std::vector<AdvertisedParty>> task;
+						try
+						{
+							task = provider->getAdvertisedParties(deadline);
+						}
+						catch (...)
+						{
+							task = pplx::task_from_exception<std::vector<AdvertisedParty>>(std::current_exception());
+						}
+
+						task.then([tce, platform, deadline, registration, logger = _logger](pplx::task<std::vector<AdvertisedParty>> task)
+						{
+							deadline.deregister_callback(registration);
+							AdvertisedPartiesResult result;
+							result.platform = platform;
+							try
+							{
+								result.parties = task.get();
+							}
+							catch (const std::exception& ex)
+							{
+								if (!deadline.is_canceled())
+								{
+									logger->log(LogLevel::Error, "Party", "An IPartyAdvertiser failed", ex);
+								}
+								result.error = ex.what();
+							}
+							tce.set(result);
+						});
+
+						tasks.push_back(pplx::create_task(tce).then([onResult](AdvertisedPartiesResult result)
+						{
+							onResult(result);
+						}, _dispatcher));
+					}
+
+					return pplx::when_all(tasks.begin(), tasks.end()).then([ct]()
+					{
+						if (ct.is_canceled())
+						{
+							throw pplx::task_canceled();
+						}
+					});
+				}
+
 				Subscription subscribeOnSentInvitationsListUpdated(std::function<void(std::vector<std::string>)> callback) override
 				{
 					return _onSentInvitationsUpdated.subscribe(callback);
@@ -4505,6 +5881,7 @@ namespace Stormancer
 				pplx::task<void> _platformPartyMembersUpdateTask = pplx::task_from_result();
 				std::function<pplx::task<bool>(JoinPartyFromSystemArgs)> _joinPartyFromSystemHandler;
 				std::weak_ptr<IClient> _wClient;
+				std::shared_ptr<PartySearchCache> _searchCache;
 				// These subscriptions are separated from the main one because when want to be able to unsub when the user does.
 				std::vector<Subscription> _joinPartyFromSystemSubs;
 			};
@@ -98,8 +98,8 @@ namespace Stormancer
 		template<typename TDetails>
 		struct PartyMergerBaseStatus
 		{
-			int partiesCount;
-			int playersCount;
+			int partiesCount = 0;
+			int playersCount = 0;
 			std::string algorithm;
 			TDetails details;
 			MSGPACK_DEFINE_MAP(partiesCount,playersCount,algorithm,details)
@@ -127,6 +127,24 @@ namespace Stormancer
 
 		namespace details
 		{
+			/// <summary>
+			/// Merger status pushed by the party scene to subscribed members.
+			/// </summary>
+			struct MergerStatusUpdate
+			{
+				std::string mergerId;
+
+				/// <summary>
+				/// If false, data only contains the top level fields that changed since the previous update.
+				/// </summary>
+				bool isFullStatus = false;
+
+				/// <summary>
+				/// Status serialized as a msgpack map.
+				/// </summary>
+				std::vector<byte> data;
+			};
+
 			class PartyMergingService : public std::enable_shared_from_this<PartyMergingService>
 			{
 			public:
@@ -158,6 +176,37 @@ namespace Stormancer
 					return rpc->rpc<PartyMergerStatusResponse<TDetails>>("PartyMerging.GetMergerStatus", partyMerger);
 				}
 
+				// Subscriptions are reference counted per merger: every call sends the subscription request so that the caller receives the full status,
+				// but the server subscription is only cancelled when the last subscription to the merger is released.
+				// Each call must be matched by a call to unsubscribeMergerStatus, even if the request fails.
+				pplx::task<void> subscribeMergerStatus(const std::string& partyMerger)
+				{
+					{
+						std::lock_guard<std::mutex> lg(_statusSubscriptionsMutex);
+						++_statusSubscriptions[partyMerger];
+					}
+					auto rpc = _rpc.lock();
+					if (!rpc)
+					{
+						return pplx::task_from_exception<void>(ObjectDeletedException("RpcService"));
+					}
+					return rpc->rpc("PartyMerging.SubscribeMergerStatus", partyMerger);
+				}
+
+				pplx::task<void> unsubscribeMergerStatus(const std::string& partyMerger)
+				{
+					if (!releaseMergerStatusSubscription(partyMerger))
+					{
+						return pplx::task_from_result();
+					}
+					auto rpc = _rpc.lock();
+					if (!rpc)
+					{
+						return pplx::task_from_result();
+					}
+					return rpc->rpc("PartyMerging.UnsubscribeMergerStatus", partyMerger);
+				}
+
 				void initialize(std::shared_ptr<Stormancer::Scene> scene)
 				{
 					std::weak_ptr<PartyMergingService> wThat = this->shared_from_this();
@@ -172,9 +221,23 @@ namespace Stormancer
 							that->raiseConnectionTokenReceived(connectionToken);
 						}
 					});
+
+					scene->addRoute("partyMerging.mergerStatus", [wThat](Packetisp_ptr packet) {
+						if (auto that = wThat.lock())
+						{
+							Serializer serializer;
+							MergerStatusUpdate update;
+							update.mergerId = serializer.deserializeOne<std::string>(packet->stream);
+							update.isFullStatus = serializer.deserializeOne<bool>(packet->stream);
+							update.data = serializer.deserializeOne<std::vector<byte>>(packet->stream);
+
+							that->onMergerStatusUpdated(update);
+						}
+					});
 				}
 
 				Stormancer::Event<std::string> onPartyConnectionTokenReceived;
+				Stormancer::Event<MergerStatusUpdate> onMergerStatusUpdated;
 			private:
 
 				void raiseConnectionTokenReceived(std::string connectionToken)
@@ -182,12 +245,135 @@ namespace Stormancer
 					onPartyConnectionTokenReceived(connectionToken);
 				}
 
+				// Returns true if this was the last subscription to the merger.
+				bool releaseMergerStatusSubscription(const std::string& partyMerger)
+				{
+					std::lock_guard<std::mutex> lg(_statusSubscriptionsMutex);
+					auto it = _statusSubscriptions.find(partyMerger);
+					if (it == _statusSubscriptions.end())
+					{
+						return false;
+					}
+					if (--it->second > 0)
+					{
+						return false;
+					}
+					_statusSubscriptions.erase(it);
+					return true;
+				}
+
 				std::weak_ptr<RpcService> _rpc;
+				std::mutex _statusSubscriptionsMutex;
+				std::unordered_map<std::string, int> _statusSubscriptions;
 			};
 		}
 
 		class PartyMergingPlugin;
 
+		/// <summary>
+		/// Status of a merger, kept up to date by the party scene.
+		/// </summary>
+		/// <remarks>
+		/// The server pushes only the fields that changed, so keeping a subscription open is cheaper than polling getMergerStatus.
+		/// The subscription is cancelled when the object is destroyed. Several subscriptions to the same or to different mergers can be open at the same time.
+		/// </remarks>
+		/// <typeparam name="TDetails">custom detailed merger status data provided by the merging algorithm.</typeparam>
+		template<typename TDetails = EmptyMergingStatusDetails>
+		class PartyMergerStatusSubscription : public std::enable_shared_from_this<PartyMergerStatusSubscription<TDetails>>
+		{
+			friend class PartyMergingApi;
+		public:
+
+			using Status = PartyMergerBaseStatus<TDetails>;
+
+			PartyMergerStatusSubscription(std::string mergerId, std::weak_ptr<details::PartyMergingService> service)
+				: _mergerId(std::move(mergerId))
+				, _service(service)
+			{
+			}
+
+			~PartyMergerStatusSubscription()
+			{
+				_updateSubscription.reset();
+				if (auto service = _service.lock())
+				{
+					service->unsubscribeMergerStatus(_mergerId).then([](pplx::task<void> t)
+					{
+						try
+						{
+							t.get();
+						}
+						catch (...)
+						{
+							// The party scene may already be disconnected.
+						}
+					});
+				}
+			}
+
+			const std::string& mergerId() const
+			{
+				return _mergerId;
+			}
+
+			/// <summary>
+			/// Gets the last status received from the server, or nullptr if none was received yet.
+			/// </summary>
+			/// <remarks>
+			/// Lock free, can be called from any thread, for instance every frame.
+			/// </remarks>
+			std::shared_ptr<const Status> latest() const
+			{
+				return std::atomic_load(&_latest);
+			}
+
+			/// <summary>
+			/// Fired when a new status is received.
+			/// </summary>
+			Stormancer::Event<std::shared_ptr<const Status>> onStatusUpdated;
+
+		private:
+
+			void initialize()
+			{
+				auto service = _service.lock();
+				if (!service)
+				{
+					throw ObjectDeletedException("PartyMergingService");
+				}
+
+				std::weak_ptr<PartyMergerStatusSubscription<TDetails>> wThis = this->shared_from_this();
+				_updateSubscription = service->onMergerStatusUpdated.subscribe([wThis](const details::MergerStatusUpdate& update)
+				{
+					if (auto that = wThis.lock())
+					{
+						if (update.mergerId == that->_mergerId)
+						{
+							that->apply(update);
+						}
+					}
+				});
+			}
+
+			void apply(const details::MergerStatusUpdate& update)
+			{
+				auto current = std::atomic_load(&_latest);
+				// Partial updates are unpacked on top of a copy of the current status: MSGPACK_DEFINE_MAP leaves the fields missing from the map untouched.
+				auto next = (update.isFullStatus || !current) ? std::make_shared<Status>() : std::make_shared<Status>(*current);
+
+				msgpack::object_handle handle = msgpack::unpack(reinterpret_cast<const char*>(update.data.data()), update.data.size());
+				handle.get().convert(*next);
+
+				std::shared_ptr<const Status> status = std::move(next);
+				std::atomic_store(&_latest, status);
+				onStatusUpdated(status);
+			}
+
+			std::string _mergerId;
+			std::weak_ptr<details::PartyMergingService> _service;
+			std::shared_ptr<const Status> _latest;
+			Stormancer::Subscription _updateSubscription;
+		};
 
 		/// <summary>
 		/// Interacts with the party merging plugin. Party merging matchmaker enable different parties to be merged together according to custom rules and algorithms.
@@ -257,6 +443,34 @@ namespace Stormancer
 				}
 			}
 
+			/// <summary>
+			/// Subscribes to status updates of a merger, pushed by the server.
+			/// </summary>
+			/// <remarks>
+			/// Prefer this method to polling getMergerStatus when the status is displayed continuously.
+			/// </remarks>
+			/// <param name="mergerId"></param>
+			/// <returns>A subscription object. Destroy it to unsubscribe.</returns>
+			template<typename TDetails = EmptyMergingStatusDetails>
+			pplx::task<std::shared_ptr<PartyMergerStatusSubscription<TDetails>>> subscribeMergerStatus(std::string mergerId)
+			{
+				try
+				{
+					auto service = _partyApi.lock()->getPartyScene()->dependencyResolver().resolve<details::PartyMergingService>();
+					auto subscription = std::make_shared<PartyMergerStatusSubscription<TDetails>>(mergerId, service);
+					// Listen before subscribing, the first status may be pushed before the rpc response.
+					subscription->initialize();
+					return service->subscribeMergerStatus(mergerId).then([subscription]()
+					{
+						return subscription;
+					});
+				}
+				catch (const std::exception& ex)
+				{
+					return pplx::task_from_exception<std::shared_ptr<PartyMergerStatusSubscription<TDetails>>>(ex);
+				}
+			}
+
 
 			Stormancer::Event<std::string> onPartyConnectionTokenReceived;
 			Stormancer::Event<std::string> onMergePartyError;
@@ -1,11 +1,17 @@
 #pragma once
+#include "Users/ConfigurationParameters.hpp"
+#include "stormancer/Configuration.h"
 #include "stormancer/IPlugin.h"
 #include "stormancer/Scene.h"
 #include "stormancer/RPC/RpcService.h"
 #include "stormancer/Exceptions.h"
 #include "stormancer/Tasks.h"
 
+#include <algorithm>
+#include <deque>
 #include <functional>
+#include <map>
+#include <mutex>
 
 namespace Stormancer
 {
@@ -13,6 +19,30 @@ namespace Stormancer
 	{
 		class CommandLogPlugin;
 
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the command log behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Number of log entries above which the log is compacted, if a snapshot provider is set.
+			/// Default is "1024".
+			/// </summary>
+			constexpr const char* MaxLogEntries = "commandLog.maxEntries";
+
+			/// <summary>
+			/// Maximum number of commands sent to the server and waiting for its response. Further commands are sent when one completes.
+			/// Default is "8".
+			/// </summary>
+			constexpr const char* MaxInFlightCommands = "commandLog.maxInFlightCommands";
+
+			/// <summary>
+			/// Maximum number of log entries received ahead of a missing entry, buffered until the missing entries are received.
+			/// Default is "4096".
+			/// </summary>
+			constexpr const char* MaxPendingEntries = "commandLog.maxPendingEntries";
+		}
+
 		struct LogEntry
 		{
 			int id;
@@ -21,16 +51,54 @@ namespace Stormancer
 
 			MSGPACK_DEFINE(id, type, content)
 		};
+
+		/// <summary>
+		/// State of the application after applying the log entries up to <c>id</c>.
+		/// </summary>
+		struct LogSnapshot
+		{
+			/// <summary>
+			/// Id of the last entry included in the snapshot. 0 if there is no snapshot.
+			/// </summary>
+			int id = 0;
+			std::vector<byte> content;
+
+			MSGPACK_DEFINE(id, content)
+		};
+
 		struct SyncRequest
 		{
 			std::vector<LogEntry> logEntries;
-			MSGPACK_DEFINE(logEntries);
+
+			/// <summary>
+			/// Optional snapshot to start from, when the log entries before it are not sent.
+			/// </summary>
+			LogSnapshot snapshot;
+
+			MSGPACK_DEFINE(logEntries, snapshot);
+		};
+
+		/// <summary>
+		/// Range of log entry ids, bounds included.
+		/// </summary>
+		struct LogRange
+		{
+			int first;
+			int last;
+
+			MSGPACK_DEFINE(first, last)
 		};
 
 		struct SyncResponse
 		{
 			int lastLogId;
-			MSGPACK_DEFINE(lastLogId);
+
+			/// <summary>
+			/// Entries missing after lastLogId, before entries received out of order and buffered by the client.
+			/// </summary>
+			std::vector<LogRange> missingRanges;
+
+			MSGPACK_DEFINE(lastLogId, missingRanges);
 		};
 
 		struct CommandReceivedEvent
@@ -38,49 +106,231 @@ namespace Stormancer
 			bool accepted = true;
 			std::weak_ptr<Scene> scene;
 			LogEntry entry;
+
+			/// <summary>
+			/// The entry is a snapshot of the log up to <c>entry.id</c>, and replaces the state built from the previous entries.
+			/// </summary>
+			/// <remarks>
+			/// Snapshots can't be rejected.
+			/// </remarks>
+			bool isSnapshot = false;
 		};
 
 		namespace details
 		{
+			/// <summary>
+			/// Log entries received ahead of a missing entry, kept until the missing entries are received.
+			/// </summary>
+			/// <remarks>
+			/// Not thread safe.
+			/// </remarks>
+			class LogReorderBuffer
+			{
+			public:
+
+				LogReorderBuffer(std::size_t maxEntries = 4096)
+					: _maxEntries(maxEntries)
+				{
+				}
+
+				/// <summary>
+				/// Buffers the entries following <c>lastLogId</c>, then removes the entries contiguous with it from the buffer.
+				/// </summary>
+				/// <remarks>
+				/// Beyond the maximum number of entries kept after a gap, those with the highest ids are dropped. The server sends them again, as they are after the last id acknowledged.
+				/// Entries contiguous with <c>lastLogId</c> are always returned, even when a batch is larger than the buffer.
+				/// </remarks>
+				/// <returns>The entries following <c>lastLogId</c> without gap, in order.</returns>
+				std::vector<LogEntry> add(std::vector<LogEntry>& entries, int lastLogId)
+				{
+					for (auto& logEntry : entries)
+					{
+						if (logEntry.id > lastLogId)
+						{
+							_entries.emplace(logEntry.id, std::move(logEntry));
+						}
+					}
+
+					std::vector<LogEntry> contiguous;
+					auto expectedId = lastLogId + 1;
+					auto it = _entries.begin();
+					while (it != _entries.end() && it->first == expectedId)
+					{
+						contiguous.push_back(std::move(it->second));
+						it = _entries.erase(it);
+						expectedId++;
+					}
+
+					while (_entries.size() > _maxEntries)
+					{
+						_entries.erase(std::prev(_entries.end()));
+					}
+					return contiguous;
+				}
+
+				/// <summary>
+				/// Drops the entries up to <c>id</c> included, for instance when they are replaced by a snapshot.
+				/// </summary>
+				void discardUpTo(int id)
+				{
+					_entries.erase(_entries.begin(), _entries.upper_bound(id));
+				}
+
+				/// <summary>
+				/// Gets the ranges of entries missing between <c>lastLogId</c> and the entries buffered, so that the server only sends them.
+				/// </summary>
+				std::vector<LogRange> missingRanges(int lastLogId) const
+				{
+					std::vector<LogRange> ranges;
+					auto expectedId = lastLogId + 1;
+					for (auto& kvp : _entries)
+					{
+						if (kvp.first > expectedId)
+						{
+							LogRange range;
+							range.first = expectedId;
+							range.last = kvp.first - 1;
+							ranges.push_back(range);
+						}
+						expectedId = kvp.first + 1;
+					}
+					return ranges;
+				}
+
+				std::size_t size() const
+				{
+					return _entries.size();
+				}
+
+			private:
+
+				// By id
+				std::map<int, LogEntry> _entries;
+				std::size_t _maxEntries;
+			};
+
 			class CommandLogService : public std::enable_shared_from_this<CommandLogService>
 			{
 				friend class CommandLogPlugin;
 			public:
-				CommandLogService(std::shared_ptr<Scene> scene, std::shared_ptr<RpcService> rpc)
+				CommandLogService(std::shared_ptr<Scene> scene, std::shared_ptr<RpcService> rpc, std::shared_ptr<Configuration> config)
 				{
 					this->wRpc = rpc;
 					this->wScene = scene;
+					_maxLogEntries = std::max<std::size_t>(readConfigurationParameter(config, ConfigurationKeys::MaxLogEntries, _maxLogEntries), 1);
+					_maxInFlightCommands = std::max<std::size_t>(readConfigurationParameter(config, ConfigurationKeys::MaxInFlightCommands, _maxInFlightCommands), 1);
+					_pendingEntries = LogReorderBuffer(std::max<std::size_t>(readConfigurationParameter(config, ConfigurationKeys::MaxPendingEntries, 4096), 1));
 				}
 
+				/// <summary>
+				/// Subscribes to the log. The latest snapshot and the entries that follow it are replayed first.
+				/// </summary>
 				void subscribeOnCommandReceived(::std::function<void(CommandReceivedEvent&)> callback)
 				{
-					std::lock_guard<std::mutex> guard(_mutex);
-					for (auto entry : _logEntries)
+					// Entries received during the replay are delivered after it.
+					std::lock_guard<std::recursive_mutex> deliveryGuard(_deliveryMutex);
+
+					LogSnapshot snapshot;
+					std::vector<LogEntry> entries;
+					{
+						std::lock_guard<std::mutex> guard(_mutex);
+						snapshot = _snapshot;
+						entries.assign(_logEntries.begin(), _logEntries.end());
+
+						//We are supposed to only subscribe once.
+						//By storing the subscription in the service, we will automatically destroy it with the scene.
+						_apiSubscription = onCommandReceived.subscribe(callback);
+					}
+
+					if (snapshot.id != 0)
+					{
+						CommandReceivedEvent evt;
+						evt.entry.id = snapshot.id;
+						evt.entry.content = snapshot.content;
+						evt.isSnapshot = true;
+						evt.scene = wScene;
+						callback(evt);
+					}
+					for (auto& entry : entries)
 					{
 						CommandReceivedEvent evt;
 						evt.entry = entry;
 						evt.scene = wScene;
 
 						callback(evt);
+					}
+				}
+
+				/// <summary>
+				/// Sets the function providing a snapshot of the application state after a log entry.
+				/// </summary>
+				/// <remarks>
+				/// When the log exceeds <c>ConfigurationKeys::MaxLogEntries</c>, the provider is called after the entries are delivered and the log is compacted.
+				/// Without a provider, the log is never compacted.
+				/// </remarks>
+				void setSnapshotProvider(std::function<std::vector<byte>(int lastLogId)> provider)
+				{
+					std::lock_guard<std::mutex> guard(_mutex);
+					_snapshotProvider = provider;
+				}
 
+				/// <summary>
+				/// Replaces the log entries up to <c>id</c> by a snapshot.
+				/// </summary>
+				/// <returns>false if the snapshot is older than the current one, or ahead of the log.</returns>
+				bool compact(int id, std::vector<byte> content)
+				{
+					std::lock_guard<std::mutex> guard(_mutex);
+					if (id <= _snapshot.id || id > getLastLogEntry())
+					{
+						return false;
 					}
 
-					//We are supposed to only subscribe once.
-					//By storing the subscription in the service, we will automatically destroy it with the scene.
-					_apiSubscription = onCommandReceived.subscribe(callback);
+					while (!_logEntries.empty() && _logEntries.front().id <= id)
+					{
+						_logEntries.pop_front();
+					}
+					_snapshot.id = id;
+					_snapshot.content = std::move(content);
+					return true;
 				}
 
+				/// <summary>
+				/// Sends a command to the server.
+				/// </summary>
+				/// <remarks>
+				/// Commands are sent in order, without waiting for the response to the previous ones, up to <c>ConfigurationKeys::MaxInFlightCommands</c>.
+				/// </remarks>
 				pplx::task<bool> addCommandToLog(std::string type, std::vector<byte> data)
 				{
-					if (auto rpc = wRpc.lock())
+					if (wRpc.expired())
 					{
-						return rpc->rpc<bool>("Replication.AddCommand", type, data, getLastLogEntry());
+						return pplx::task_from_exception<bool>(ObjectDeletedException("RpcService"));
 					}
-					else
+
+					auto command = std::make_shared<PendingCommand>();
+					command->type = std::move(type);
+					command->data = std::move(data);
+
+					bool sendNow = false;
 					{
-						return pplx::task_from_exception<bool>(ObjectDeletedException("RpcService"));
+						std::lock_guard<std::mutex> guard(_mutex);
+						if (_commandsInFlight < _maxInFlightCommands)
+						{
+							_commandsInFlight++;
+							sendNow = true;
+						}
+						else
+						{
+							_queuedCommands.push_back(command);
+						}
 					}
 
+					if (sendNow)
+					{
+						send(command);
+					}
+					return pplx::create_task(command->tce);
 				}
 
 
@@ -109,56 +359,203 @@ namespace Stormancer
 					}
 				}
 			private:
+
+				struct PendingCommand
+				{
+					std::string type;
+					std::vector<byte> data;
+					pplx::task_completion_event<bool> tce;
+				};
+
+				void send(std::shared_ptr<PendingCommand> command)
+				{
+					auto rpc = wRpc.lock();
+					if (!rpc)
+					{
+						command->tce.set_exception(ObjectDeletedException("RpcService"));
+						onCommandCompleted();
+						return;
+					}
+
+					int lastLogId;
+					{
+						std::lock_guard<std::mutex> guard(_mutex);
+						lastLogId = getLastLogEntry();
+					}
+
+					std::weak_ptr<CommandLogService> wThat = this->shared_from_this();
+					rpc->rpc<bool>("Replication.AddCommand", command->type, command->data, lastLogId).then([wThat, command](pplx::task<bool> task)
+					{
+						try
+						{
+							command->tce.set(task.get());
+						}
+						catch (...)
+						{
+							command->tce.set_exception(std::current_exception());
+						}
+
+						if (auto that = wThat.lock())
+						{
+							that->onCommandCompleted();
+						}
+					});
+				}
+
+				void onCommandCompleted()
+				{
+					std::shared_ptr<PendingCommand> next;
+					{
+						std::lock_guard<std::mutex> guard(_mutex);
+						if (_queuedCommands.empty())
+						{
+							_commandsInFlight--;
+						}
+						else
+						{
+							next = _queuedCommands.front();
+							_queuedCommands.pop_front();
+						}
+					}
+					if (next)
+					{
+						send(next);
+					}
+				}
+
 				SyncResponse syncMessageReceived(SyncRequest& request)
 				{
-					std::lock_guard<std::mutex> guard(_mutex);
+					// Deliveries happen outside _mutex, so that commands can be added and the log read meanwhile.
+					// _deliveryMutex keeps them ordered across sync requests.
+					std::lock_guard<std::recursive_mutex> deliveryGuard(_deliveryMutex);
 
-					for (auto& logEntry : request.logEntries)
+					bool snapshotReceived = false;
+					LogSnapshot snapshot;
+					std::vector<LogEntry> batch;
 					{
-						if (logEntry.id == getLastLogEntry() + 1)
+						std::lock_guard<std::mutex> guard(_mutex);
+						if (request.snapshot.id > getLastLogEntry())
 						{
+							// Late joiner: start from the snapshot instead of the whole log.
+							_logEntries.clear();
+							_snapshot = request.snapshot;
+							_pendingEntries.discardUpTo(_snapshot.id);
+							snapshotReceived = true;
+							snapshot = _snapshot;
+						}
 
+						batch = _pendingEntries.add(request.logEntries, getLastLogEntry());
+					}
 
-							CommandReceivedEvent evt;
-							evt.entry = logEntry;
-							evt.scene = wScene;
-							onCommandReceived(evt);
+					if (snapshotReceived)
+					{
+						CommandReceivedEvent evt;
+						evt.entry.id = snapshot.id;
+						evt.entry.content = snapshot.content;
+						evt.isSnapshot = true;
+						evt.scene = wScene;
+						onCommandReceived(evt);
+					}
 
-							if (evt.accepted)
-							{
-								_logEntries.push_back(logEntry);
-							}
+					std::size_t accepted = 0;
+					for (; accepted < batch.size(); accepted++)
+					{
+						CommandReceivedEvent evt;
+						evt.entry = batch[accepted];
+						evt.scene = wScene;
+						onCommandReceived(evt);
+
+						if (!evt.accepted)
+						{
+							// The following entries are not contiguous anymore: the server sends them again after the rejected one.
+							break;
 						}
 					}
 
+					{
+						std::lock_guard<std::mutex> guard(_mutex);
+						for (std::size_t i = 0; i < accepted; i++)
+						{
+							_logEntries.push_back(std::move(batch[i]));
+						}
+					}
+
+					// The application state matches the last entry delivered while _deliveryMutex is held.
+					compactIfNeeded();
 
+					std::lock_guard<std::mutex> guard(_mutex);
 					SyncResponse response;
 					response.lastLogId = getLastLogEntry();
+					response.missingRanges = _pendingEntries.missingRanges(response.lastLogId);
 					return response;
 				}
 
+				// Requires _deliveryMutex
+				void compactIfNeeded()
+				{
+					std::function<std::vector<byte>(int)> provider;
+					int lastLogId;
+					{
+						std::lock_guard<std::mutex> guard(_mutex);
+						if (_logEntries.size() <= _maxLogEntries || !_snapshotProvider)
+						{
+							return;
+						}
+						provider = _snapshotProvider;
+						lastLogId = getLastLogEntry();
+					}
+
+					std::vector<byte> content;
+					try
+					{
+						content = provider(lastLogId);
+					}
+					catch (const std::exception&)
+					{
+						// Retried with the next entries.
+						return;
+					}
+					compact(lastLogId, std::move(content));
+				}
+
 				/// <summary>
-				/// gets the id of the last log entrie. 0 means that the log is empty.
+				/// gets the id of the last log entrie, or of the snapshot if no entry follows it. 0 means that the log is empty.
 				/// </summary>
+				/// <remarks>
+				/// Requires _mutex.
+				/// </remarks>
 				/// <returns></returns>
 				int getLastLogEntry()
 				{
-					auto count = _logEntries.size();
-					if (count != 0)
+					if (!_logEntries.empty())
 					{
-						return _logEntries[count - 1].id;
+						return _logEntries.back().id;
 					}
 					else
 					{
-						return 0;
+						return _snapshot.id;
 					}
 
 				}
+
 				Event<CommandReceivedEvent&> onCommandReceived;
-				std::vector<LogEntry> _logEntries;
+				// Entries after _snapshot
+				std::deque<LogEntry> _logEntries;
+				LogSnapshot _snapshot;
+				std::function<std::vector<byte>(int)> _snapshotProvider;
+				std::size_t _maxLogEntries = 1024;
+				// Entries received out of order
+				LogReorderBuffer _pendingEntries;
+
+				std::size_t _maxInFlightCommands = 8;
+				std::size_t _commandsInFlight = 0;
+				std::deque<std::shared_ptr<PendingCommand>> _queuedCommands;
+
 				std::weak_ptr<RpcService> wRpc;
 				std::weak_ptr<Scene> wScene;
 				std::mutex _mutex;
+				// Serializes the deliveries to the application. Taken before _mutex.
+				std::recursive_mutex _deliveryMutex;
 				Subscription _apiSubscription;
 			};
 		}
@@ -178,6 +575,33 @@ namespace Stormancer
 				return _onCommandReceived.subscribe(callback);
 			}
 
+			/// <summary>
+			/// Sets the function providing a snapshot of the application state for a scene after a log entry, used to compact the log.
+			/// </summary>
+			/// <remarks>
+			/// Applies to the scenes connected afterwards.
+			/// </remarks>
+			void setSnapshotProvider(std::function<std::vector<byte>(const std::string& sceneId, int lastLogId)> provider)
+			{
+				_snapshotProvider = provider;
+			}
+
+			/// <summary>
+			/// Replaces the log entries of a scene up to <c>id</c> by a snapshot of the application state.
+			/// </summary>
+			bool compact(const std::string& sceneId, int id, const std::vector<byte>& snapshot)
+			{
+				auto it = _connectedScenes.find(sceneId);
+				if (it != _connectedScenes.end())
+				{
+					if (auto scene = it->second.lock())
+					{
+						return scene->dependencyResolver().resolve<details::CommandLogService>()->compact(id, snapshot);
+					}
+				}
+				return false;
+			}
+
 			template<typename T>
 			pplx::task<bool> addCommandToLog(const std::string& sceneId, const std::string& type, const T& data)
 			{
@@ -209,6 +633,12 @@ namespace Stormancer
 			void onConnected(std::shared_ptr<Scene> scene, std::shared_ptr<details::CommandLogService> service)
 			{
 				_connectedScenes.emplace(scene->id(), scene);
+				if (_snapshotProvider)
+				{
+					auto provider = _snapshotProvider;
+					auto sceneId = scene->id();
+					service->setSnapshotProvider([provider, sceneId](int lastLogId) { return provider(sceneId, lastLogId); });
+				}
 				service->subscribeOnCommandReceived([this](CommandReceivedEvent& evt) { onCommandReceived(evt); });
 			}
 			void onDisconnected(std::shared_ptr<Scene> scene)
@@ -224,6 +654,7 @@ namespace Stormancer
 			/// <param name="scene"></param>
 			std::unordered_map<std::string, std::weak_ptr<Scene>> _connectedScenes;
 			std::shared_ptr<Serializer> _serializer;
+			std::function<std::vector<byte>(const std::string&, int)> _snapshotProvider;
 
 		};
 		class CommandLogPlugin : public IPlugin
@@ -251,7 +682,7 @@ namespace Stormancer
 
 				if (supportsCommandLogs(scene))
 				{
-					sceneBuilder.registerDependency<details::CommandLogService, Scene, RpcService>().singleInstance();
+					sceneBuilder.registerDependency<details::CommandLogService, Scene, RpcService, Configuration>().singleInstance();
 				}
 			}
 
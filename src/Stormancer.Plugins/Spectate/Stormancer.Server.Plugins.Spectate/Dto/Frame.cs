@@ -44,11 +44,49 @@ namespace Stormancer.Server.Plugins.Spectate
         public byte[] data { get; set; }
     }
 
+    /// <summary>
+    /// A frame uploaded with the Spectate.UploadFrames route.
+    /// </summary>
+    [MessagePackObject]
+    public class EncodedFrameDto : FrameDataDto
+    {
+        /// <summary>
+        /// Codec of the frame data, chosen by the game server. 0 if the data is not encoded.
+        /// </summary>
+        /// <remarks>
+        /// The data is relayed and stored as is, spectators decode it.
+        /// </remarks>
+        [Key(3)]
+        public byte Encoding { get; set; }
+    }
+
+    /// <summary>
+    /// A batch of frames uploaded with the Spectate.UploadFrames route.
+    /// </summary>
+    [MessagePackObject]
+    public class FrameBatchDto
+    {
+        /// <summary>
+        /// Sequence number of the batch, starting at 1 for each uploading session.
+        /// </summary>
+        [Key(0)]
+        public ulong Sequence { get; set; }
+
+        [Key(1)]
+        public List<EncodedFrameDto> Frames { get; set; } = new List<EncodedFrameDto>();
+    }
+
     [MessagePackObject]
     public class Frame : FrameDataDto
     {
         [Key(3)]
         public SessionId Origin { get; set; }
+
+        /// <summary>
+        /// Codec of the frame data. 0 if the data is not encoded.
+        /// </summary>
+        [Key(4)]
+        public byte Encoding { get; set; }
     }
 
     [MessagePackObject]
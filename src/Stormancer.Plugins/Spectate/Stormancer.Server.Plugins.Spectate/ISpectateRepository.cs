@@ -38,6 +38,20 @@ namespace Stormancer.Server.Plugins.Spectate
 
         MatchArrayFilter GetSubscribers();
 
+        /// <summary>
+        /// Records the sequence number of a batch uploaded by a session.
+        /// </summary>
+        /// <remarks>
+        /// Only the batch following the last one accepted is accepted, so that frames are stored in the order they were sent.
+        /// </remarks>
+        /// <param name="sessionId">Session uploading the batch.</param>
+        /// <param name="sequence">Sequence number of the batch.</param>
+        /// <param name="acknowledged">The sequence number of the last batch accepted from the session.</param>
+        /// <returns>false if the batch is not the next one.</returns>
+        bool TryAcceptBatch(SessionId sessionId, ulong sequence, out ulong acknowledged);
+
+        void RemoveUploader(SessionId sessionId);
+
         FrameList? LastFrame { get; }
     }
 }
@@ -31,9 +31,19 @@ namespace Stormancer.Server.Plugins.Spectate
     {
         Task SendFrames(IEnumerable<Frame> frames);
 
+        /// <summary>
+        /// Stores and broadcasts a batch of frames uploaded by a game server, then acknowledges it.
+        /// </summary>
+        /// <remarks>
+        /// Batches already received are only acknowledged again.
+        /// </remarks>
+        Task UploadFrames(IScenePeerClient peer, FrameBatchDto batch);
+
         Task<IEnumerable<FrameList>> GetFrames(ulong startTime, ulong endTime);
 
         ulong SubscribeToFrames(RequestContext<IScenePeerClient> request);
         void Unsubscribe(SessionId sessionId);
+
+        void RemoveUploader(SessionId sessionId);
     }
 }
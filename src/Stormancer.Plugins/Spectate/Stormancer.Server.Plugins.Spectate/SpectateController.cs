@@ -44,6 +44,7 @@ namespace Stormancer.Server.Plugins.Spectate
         protected override Task OnDisconnected(DisconnectedArgs args)
         {
             _spectateService.Unsubscribe(args.Peer.SessionId);
+            _spectateService.RemoveUploader(args.Peer.SessionId);
 
             return Task.CompletedTask;
         }
@@ -65,6 +66,15 @@ namespace Stormancer.Server.Plugins.Spectate
             return _spectateService.SendFrames(frames.Select(f => new Frame { Type = f.Type, Time = f.Time, data = f.data, Origin = sessionId }));
         }
 
+        /// <summary>
+        /// Uploads a batch of frames. The batch is acknowledged on the Spectate.FramesAck route.
+        /// </summary>
+        [Api(ApiAccess.Public, ApiType.FireForget)]
+        public Task UploadFrames(FrameBatchDto batch, Packet<IScenePeerClient> packet)
+        {
+            return _spectateService.UploadFrames(packet.Connection, batch);
+        }
+
         [Api(ApiAccess.Public, ApiType.Rpc)]
         public Task<IEnumerable<FrameList>> GetFrames(ulong startTime, ulong endTime)
         {
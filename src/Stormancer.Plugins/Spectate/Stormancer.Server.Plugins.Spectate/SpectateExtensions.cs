@@ -30,6 +30,7 @@ namespace Stormancer
         public static void AddSpectate(this ISceneHost scene)
         {
             scene.TemplateMetadata[SpectatePlugin.METADATA_KEY] = "enabled";
+            scene.TemplateMetadata[SpectatePlugin.UPLOAD_METADATA_KEY] = "1";
         }
     }
 }
@@ -29,6 +29,11 @@ namespace Stormancer.Server.Plugins.Spectate
     {
         public const string METADATA_KEY = "stormancer.spectate";
 
+        /// <summary>
+        /// Tells clients that the scene supports the Spectate.UploadFrames route.
+        /// </summary>
+        public const string UPLOAD_METADATA_KEY = "stormancer.spectate.upload";
+
         public void Build(HostPluginBuildContext ctx)
         {
             ctx.HostDependenciesRegistration += (IDependencyBuilder builder) =>
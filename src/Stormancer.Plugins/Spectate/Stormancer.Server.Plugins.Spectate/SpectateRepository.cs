@@ -166,6 +166,35 @@ namespace Stormancer.Server.Plugins.Spectate
             }
         }
         
+        // Sequence number of the last batch accepted, by uploading session.
+        private readonly Dictionary<SessionId, ulong> _uploadSequences = new Dictionary<SessionId, ulong>();
+
+        public bool TryAcceptBatch(SessionId sessionId, ulong sequence, out ulong acknowledged)
+        {
+            lock (_uploadSequences)
+            {
+                _uploadSequences.TryGetValue(sessionId, out var last);
+                if (sequence != last + 1)
+                {
+                    // Batches are sent in order on a reliable ordered channel: a duplicate or a gap is a client error.
+                    acknowledged = last;
+                    return false;
+                }
+
+                _uploadSequences[sessionId] = sequence;
+                acknowledged = sequence;
+                return true;
+            }
+        }
+
+        public void RemoveUploader(SessionId sessionId)
+        {
+            lock (_uploadSequences)
+            {
+                _uploadSequences.Remove(sessionId);
+            }
+        }
+
         private MatchArrayFilter? _filter;
         public MatchArrayFilter GetSubscribers()
         {
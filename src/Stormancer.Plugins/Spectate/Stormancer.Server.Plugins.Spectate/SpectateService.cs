@@ -28,6 +28,7 @@ using Stormancer.Server.Plugins.Utilities;
 using System.Buffers;
 using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
 
@@ -35,6 +36,8 @@ namespace Stormancer.Server.Plugins.Spectate
 {
     internal class SpectateService : ISpectateService
     {
+        private const string ACK_ROUTE = "Spectate.FramesAck";
+
         private readonly ISpectateRepository _spectateRepository;
         public readonly IUserSessions _userSessions;
         private readonly ISerializer _serializer;
@@ -52,11 +55,23 @@ namespace Stormancer.Server.Plugins.Spectate
 
         public Task SendFrames(IEnumerable<Frame> frames)
         {
+            frames = frames.ToList();
             BroadcastFrames(frames);
             _spectateRepository.AddFrames(frames);
             return Task.CompletedTask;
         }
 
+        public async Task UploadFrames(IScenePeerClient peer, FrameBatchDto batch)
+        {
+            var sessionId = peer.SessionId;
+            if (_spectateRepository.TryAcceptBatch(sessionId, batch.Sequence, out var acknowledged))
+            {
+                await SendFrames(batch.Frames.Select(f => new Frame { Type = f.Type, Time = f.Time, data = f.data, Encoding = f.Encoding, Origin = sessionId }));
+            }
+
+            // Acknowledgements are cumulative: a lost one is covered by the next.
+            await scene.Send(new MatchPeerFilter(peer), ACK_ROUTE, s => _serializer.Serialize(acknowledged, s), PacketPriority.MEDIUM_PRIORITY, PacketReliability.RELIABLE);
+        }
 
         public Task<IEnumerable<FrameList>> GetFrames(ulong startTime, ulong endTime)
         {
@@ -98,5 +113,10 @@ namespace Stormancer.Server.Plugins.Spectate
             _spectateRepository.UnsubscribeFromFrames(sessionId);
         }
 
+        public void RemoveUploader(SessionId sessionId)
+        {
+            _spectateRepository.RemoveUploader(sessionId);
+        }
+
     }
 }
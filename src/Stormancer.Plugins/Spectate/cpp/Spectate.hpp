@@ -2,8 +2,10 @@
 
 #include "GameFinder/GameFinder.hpp"
 #include "Users/ClientAPI.hpp"
+#include "Users/ConfigurationParameters.hpp"
 #include "Users/Users.hpp"
 
+#include "stormancer/Configuration.h"
 #include "stormancer/IClient.h"
 #include "stormancer/IPlugin.h"
 #include "stormancer/ITokenHandler.h"
@@ -16,9 +18,17 @@
 #include "stormancer/Utilities/TaskUtilities.h"
 #include "stormancer/Utilities/Macros.h"
 #include "stormancer/cpprestsdk/cpprest/asyncrt_utils.h"
+#include <algorithm>
 #include <bitset>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -26,6 +36,30 @@ namespace Stormancer
 {
 	namespace Spectate
 	{
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the Spectate plugin behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Size above which a batch of uploaded frames is sent, in bytes.
+			/// Default is "16384".
+			/// </summary>
+			constexpr const char* MaxBatchBytes = "spectate.upload.maxBatchBytes";
+
+			/// <summary>
+			/// Maximum time frames wait for a batch to fill up before being sent, in milliseconds.
+			/// Default is "50".
+			/// </summary>
+			constexpr const char* MaxBatchDelayMs = "spectate.upload.maxBatchDelayMs";
+
+			/// <summary>
+			/// Maximum number of batches waiting for an acknowledgement. Beyond that, the tasks of the oldest ones fail without waiting for it.
+			/// Default is "256".
+			/// </summary>
+			constexpr const char* MaxUnacknowledgedBatches = "spectate.upload.maxUnacknowledgedBatches";
+		}
+
 		enum class FrameType
 		{
 			Snapshot = 0,
@@ -38,7 +72,12 @@ namespace Stormancer
 			uint64 time;
 			std::vector<byte> data;
 
-			MSGPACK_DEFINE(type, time, data);
+			/// <summary>
+			/// Identifier of the FrameCodec the data is encoded with. 0 if it is not encoded.
+			/// </summary>
+			uint8 encoding = 0;
+
+			MSGPACK_DEFINE(type, time, data, encoding);
 		};
 
 		struct Frame
@@ -48,7 +87,12 @@ namespace Stormancer
 			std::vector<byte> data;
 			SessionId origin;
 
-			MSGPACK_DEFINE(type, time, data, origin);
+			/// <summary>
+			/// Identifier of the FrameCodec the data is encoded with. 0 if it is not encoded.
+			/// </summary>
+			uint8 encoding = 0;
+
+			MSGPACK_DEFINE(type, time, data, origin, encoding);
 		};
 
 		struct FrameList
@@ -59,38 +103,313 @@ namespace Stormancer
 			MSGPACK_DEFINE(time, frames);
 		};
 
+		struct FrameBatchDto
+		{
+			uint64 sequence = 0;
+			std::vector<FrameDataDto> frames;
+
+			MSGPACK_DEFINE(sequence, frames);
+		};
+
+		/// <summary>
+		/// Encodes the frames uploaded by a game server, and decodes them on spectators.
+		/// </summary>
+		/// <remarks>
+		/// The plugin doesn't bundle a compression library: a typical codec compresses diffs with a dictionary trained on the game frames, shared by the game server and the spectators.
+		/// The server relays and stores encoded frames as is.
+		/// </remarks>
+		struct FrameCodec
+		{
+			/// <summary>
+			/// Identifier of the codec, written in the encoded frames. Must not be 0, which identifies raw data.
+			/// </summary>
+			uint8 id = 1;
+
+			/// <summary>
+			/// Encodes the data of a frame. Returns false to upload the frame raw, for instance snapshots, or data that doesn't compress.
+			/// </summary>
+			std::function<bool(FrameType type, const std::vector<byte>& data, std::vector<byte>& encoded)> encode;
+
+			/// <summary>
+			/// Decodes the data of a frame encoded by this codec.
+			/// </summary>
+			std::function<std::vector<byte>(FrameType type, const std::vector<byte>& encoded)> decode;
+		};
+
+		namespace details
+		{
+			struct FrameBatch
+			{
+				FrameBatchDto dto;
+				std::size_t size = 0;
+				pplx::task_completion_event<void> tce;
+			};
+
+			/// <summary>
+			/// Numbers the uploaded frame batches, and tracks them until they are transmitted and acknowledged.
+			/// </summary>
+			/// <remarks>
+			/// Not thread safe.
+			/// </remarks>
+			class FrameBatchSequencer
+			{
+			public:
+
+				FrameBatchSequencer(std::size_t maxUnacknowledgedBatches = 256)
+					: _maxUnacknowledgedBatches(std::max<std::size_t>(maxUnacknowledgedBatches, 1))
+				{
+				}
+
+				/// <summary>
+				/// Numbers a batch and queues it for transmission.
+				/// </summary>
+				/// <returns>
+				/// The oldest batch waiting for an acknowledgement if there are more than the maximum, or nullptr.
+				/// The batch is no longer tracked, but is still transmitted if it was not yet.
+				/// </returns>
+				std::shared_ptr<FrameBatch> push(std::shared_ptr<FrameBatch> batch)
+				{
+					batch->dto.sequence = _nextSequence++;
+					_transmitQueue.push_back(batch);
+					_unacknowledged.push_back(batch);
+
+					if (_unacknowledged.size() > _maxUnacknowledgedBatches)
+					{
+						auto dropped = _unacknowledged.front();
+						_unacknowledged.pop_front();
+						return dropped;
+					}
+					return nullptr;
+				}
+
+				/// <summary>
+				/// Gets the next batch to transmit, in sequence order, or nullptr if all the batches were transmitted.
+				/// </summary>
+				std::shared_ptr<FrameBatch> nextToTransmit()
+				{
+					if (_transmitQueue.empty())
+					{
+						return nullptr;
+					}
+					auto batch = _transmitQueue.front();
+					_transmitQueue.pop_front();
+					return batch;
+				}
+
+				/// <summary>
+				/// Stops tracking the batches up to <c>sequence</c>. Acknowledgements are cumulative.
+				/// </summary>
+				/// <returns>The batches acknowledged, in sequence order.</returns>
+				std::vector<std::shared_ptr<FrameBatch>> acknowledge(uint64 sequence)
+				{
+					std::vector<std::shared_ptr<FrameBatch>> acknowledged;
+					while (!_unacknowledged.empty() && _unacknowledged.front()->dto.sequence <= sequence)
+					{
+						acknowledged.push_back(_unacknowledged.front());
+						_unacknowledged.pop_front();
+					}
+					return acknowledged;
+				}
+
+				/// <summary>
+				/// Batches waiting for an acknowledgement, in sequence order.
+				/// </summary>
+				const std::deque<std::shared_ptr<FrameBatch>>& unacknowledged() const
+				{
+					return _unacknowledged;
+				}
+
+			private:
+
+				std::size_t _maxUnacknowledgedBatches;
+				// Pushed and not transmitted yet, by sequence number
+				std::deque<std::shared_ptr<FrameBatch>> _transmitQueue;
+				// Pushed and not acknowledged yet, by sequence number
+				std::deque<std::shared_ptr<FrameBatch>> _unacknowledged;
+				uint64 _nextSequence = 1;
+			};
+		}
+
 		class SpectateService : public std::enable_shared_from_this<SpectateService>
 		{
 		public:
 
-			SpectateService(std::shared_ptr<RpcService> rpcService, std::shared_ptr<ILogger> logger)
+			SpectateService(std::shared_ptr<RpcService> rpcService, std::shared_ptr<ILogger> logger, std::shared_ptr<Configuration> config)
 				: _rpcService(rpcService)
 				, _logger(logger)
+			{
+				_maxBatchBytes = readConfigurationParameter(config, ConfigurationKeys::MaxBatchBytes, _maxBatchBytes);
+				_maxBatchDelay = std::chrono::milliseconds(readConfigurationParameter(config, ConfigurationKeys::MaxBatchDelayMs, 50));
+				_sequencer = details::FrameBatchSequencer(readConfigurationParameter(config, ConfigurationKeys::MaxUnacknowledgedBatches, 256));
+			}
 
+			~SpectateService()
 			{
+				_uploadCts.cancel();
+				std::lock_guard<std::mutex> lg(_uploadMutex);
+				for (auto& batch : _sequencer.unacknowledged())
+				{
+					batch->tce.set_exception(pplx::task_canceled());
+				}
+				if (_nextBatch)
+				{
+					_nextBatch->tce.set_exception(pplx::task_canceled());
+				}
 			}
 
 			void initialize(std::shared_ptr<Scene> scene)
 			{
+				_scene = scene;
+				_uploadSupported = !scene->getHostMetadata("stormancer.spectate.upload").empty();
+
 				std::weak_ptr<SpectateService> wThat = this->shared_from_this();
 				scene->addRoute("Spectate.SendFrames", [wThat](Stormancer::Packetisp_ptr packet)
 					{
 						if (auto that = wThat.lock())
 						{
 							auto frames = packet->readObject<std::vector<Frame>>();
+							that->decode(frames);
 							that->_onFramesReceived(frames);
 						}
 					});
 
+				scene->addRoute("Spectate.FramesAck", [wThat](Stormancer::Packetisp_ptr packet)
+					{
+						if (auto that = wThat.lock())
+						{
+							that->onAcknowledged(packet->readObject<uint64>());
+						}
+					});
+			}
+
+			/// <summary>
+			/// Sets the codec used to encode the frames sent, and to decode the frames received.
+			/// </summary>
+			void setCodec(FrameCodec codec)
+			{
+				std::lock_guard<std::mutex> lg(_uploadMutex);
+				_codec = std::make_shared<FrameCodec>(std::move(codec));
 			}
+
+			/// <summary>
+			/// Sends frames to the spectators.
+			/// </summary>
+			/// <remarks>
+			/// If the server supports it, frames are accumulated in batches of at most <c>ConfigurationKeys::MaxBatchBytes</c>, sent at most <c>ConfigurationKeys::MaxBatchDelayMs</c> after their first frame.
+			/// Batches are sent in order on a reliable ordered channel, without waiting for a response. The server acknowledges them as they are received.
+			/// Older servers receive the frames with an RPC.
+			/// </remarks>
+			/// <returns>A task that completes when the server acknowledged the frames.</returns>
 			pplx::task<void> sendFrames(std::vector<FrameDataDto> frames)
 			{
-				return _rpcService->rpc("Spectate.SendFrames", frames);
+				if (!_uploadSupported)
+				{
+					return _rpcService->rpc("Spectate.SendFrames", frames);
+				}
+
+				std::shared_ptr<FrameCodec> codec;
+				{
+					std::lock_guard<std::mutex> lg(_uploadMutex);
+					codec = _codec;
+				}
+				if (codec && codec->encode)
+				{
+					std::vector<byte> encoded;
+					for (auto& frame : frames)
+					{
+						encoded.clear();
+						if (frame.encoding == 0 && codec->encode(frame.type, frame.data, encoded) && encoded.size() < frame.data.size())
+						{
+							frame.data.swap(encoded);
+							frame.encoding = codec->id;
+						}
+					}
+				}
+
+				std::vector<pplx::task<void>> tasks;
+				bool batchTaken = false;
+				std::shared_ptr<FrameBatch> batchToSchedule;
+				{
+					std::lock_guard<std::mutex> lg(_uploadMutex);
+					for (auto& frame : frames)
+					{
+						// msgpack headers, type and time
+						auto size = frame.data.size() + 16;
+						if (_nextBatch && !_nextBatch->dto.frames.empty() && _nextBatch->size + size > _maxBatchBytes)
+						{
+							takeBatch();
+							batchTaken = true;
+						}
+						if (!_nextBatch)
+						{
+							_nextBatch = std::make_shared<FrameBatch>();
+							tasks.push_back(pplx::create_task(_nextBatch->tce));
+							batchToSchedule = _nextBatch;
+						}
+						else if (tasks.empty())
+						{
+							tasks.push_back(pplx::create_task(_nextBatch->tce));
+						}
+						_nextBatch->dto.frames.push_back(std::move(frame));
+						_nextBatch->size += size;
+					}
+					if (_nextBatch && _nextBatch->size >= _maxBatchBytes)
+					{
+						takeBatch();
+						batchTaken = true;
+					}
+					if (batchToSchedule != _nextBatch)
+					{
+						batchToSchedule = nullptr;
+					}
+				}
+
+				if (batchTaken)
+				{
+					transmitPending();
+				}
+				if (batchToSchedule)
+				{
+					scheduleFlush(batchToSchedule);
+				}
+
+				return pplx::when_all(tasks.begin(), tasks.end());
+			}
+
+			/// <summary>
+			/// Sends the frames waiting for a batch to fill up.
+			/// </summary>
+			void flush()
+			{
+				bool batchTaken = false;
+				{
+					std::lock_guard<std::mutex> lg(_uploadMutex);
+					if (_nextBatch && !_nextBatch->dto.frames.empty())
+					{
+						takeBatch();
+						batchTaken = true;
+					}
+				}
+				if (batchTaken)
+				{
+					transmitPending();
+				}
 			}
 
 			pplx::task<std::vector<FrameList>> GetFrames(uint64 startTime, uint64 endTime)
 			{
-				return _rpcService->rpc<std::vector<FrameList>>("Spectate.GetFrames", startTime, endTime);
+				std::weak_ptr<SpectateService> wThat = this->shared_from_this();
+				return _rpcService->rpc<std::vector<FrameList>>("Spectate.GetFrames", startTime, endTime).then([wThat](std::vector<FrameList> frameLists)
+				{
+					if (auto that = wThat.lock())
+					{
+						for (auto& frameList : frameLists)
+						{
+							that->decode(frameList.frames);
+						}
+					}
+					return frameLists;
+				});
 			}
 
 			pplx::task<uint64> startReceiveFrames(pplx::cancellation_token ct = pplx::cancellation_token::none())
@@ -110,10 +429,823 @@ namespace Stormancer
 			}
 		private:
 
+			using FrameBatch = details::FrameBatch;
+
+			// Requires _uploadMutex
+			// Numbers the next batch and queues it for transmission. Batches are transmitted in the order of their sequence numbers.
+			void takeBatch()
+			{
+				auto batch = _nextBatch;
+				_nextBatch = nullptr;
+				if (auto dropped = _sequencer.push(batch))
+				{
+					// The batch is still delivered, but its task fails to bound the number of batches tracked.
+					_logger->log(LogLevel::Warn, "Spectate", "Too many frame batches waiting for an acknowledgement, stopped waiting for batch " + std::to_string(dropped->dto.sequence));
+					dropped->tce.set_exception(std::runtime_error("Frame batch not acknowledged in time"));
+				}
+			}
+
+			void scheduleFlush(std::shared_ptr<FrameBatch> batch)
+			{
+				std::weak_ptr<SpectateService> wThat = this->shared_from_this();
+				std::weak_ptr<FrameBatch> wBatch = batch;
+				taskDelay(_maxBatchDelay, _uploadCts.get_token()).then([wThat, wBatch](pplx::task<void> task)
+				{
+					try
+					{
+						task.get();
+					}
+					catch (const pplx::task_canceled&)
+					{
+						return;
+					}
+					auto that = wThat.lock();
+					auto batch = wBatch.lock();
+					if (that && batch)
+					{
+						that->flush(batch);
+					}
+				});
+			}
+
+			void flush(std::shared_ptr<FrameBatch> expected)
+			{
+				bool batchTaken = false;
+				{
+					std::lock_guard<std::mutex> lg(_uploadMutex);
+					// The batch may have been sent full already.
+					if (_nextBatch == expected)
+					{
+						takeBatch();
+						batchTaken = true;
+					}
+				}
+				if (batchTaken)
+				{
+					transmitPending();
+				}
+			}
+
+			// Transmits the queued batches in sequence order.
+			// Batches taken concurrently by several threads are transmitted by whichever thread holds _transmitMutex, so they can't overtake each other.
+			// Batches are not retransmitted: the reliable ordered channel delivers them, in order, as long as the scene is connected.
+			void transmitPending()
+			{
+				std::lock_guard<std::mutex> transmitLock(_transmitMutex);
+				while (true)
+				{
+					std::shared_ptr<FrameBatch> batch;
+					{
+						std::lock_guard<std::mutex> lg(_uploadMutex);
+						batch = _sequencer.nextToTransmit();
+					}
+					if (!batch)
+					{
+						return;
+					}
+
+					transmit(*batch);
+					// Only the sequence number is needed until the acknowledgement.
+					std::vector<FrameDataDto>().swap(batch->dto.frames);
+				}
+			}
+
+			void transmit(const FrameBatch& batch)
+			{
+				auto scene = _scene.lock();
+				if (!scene)
+				{
+					return;
+				}
+				try
+				{
+					const auto& dto = batch.dto;
+					scene->send("Spectate.UploadFrames", [&dto](obytestream& stream)
+					{
+						Serializer serializer;
+						serializer.serialize(stream, dto);
+					}, PacketPriority::MEDIUM_PRIORITY, PacketReliability::RELIABLE_ORDERED);
+				}
+				catch (const std::exception& ex)
+				{
+					_logger->log(LogLevel::Warn, "Spectate", "Failed to send frame batch " + std::to_string(batch.dto.sequence), ex);
+				}
+			}
+
+			// Acknowledgements are cumulative.
+			void onAcknowledged(uint64 sequence)
+			{
+				std::vector<std::shared_ptr<FrameBatch>> acknowledged;
+				{
+					std::lock_guard<std::mutex> lg(_uploadMutex);
+					acknowledged = _sequencer.acknowledge(sequence);
+				}
+				for (auto& batch : acknowledged)
+				{
+					batch->tce.set();
+				}
+			}
+
+			void decode(std::vector<Frame>& frames)
+			{
+				std::shared_ptr<FrameCodec> codec;
+				{
+					std::lock_guard<std::mutex> lg(_uploadMutex);
+					codec = _codec;
+				}
+				for (auto& frame : frames)
+				{
+					if (frame.encoding == 0)
+					{
+						continue;
+					}
+					if (!codec || !codec->decode || codec->id != frame.encoding)
+					{
+						_logger->log(LogLevel::Warn, "Spectate", "No codec to decode frame encoding " + std::to_string(frame.encoding));
+						continue;
+					}
+					try
+					{
+						frame.data = codec->decode(frame.type, frame.data);
+						frame.encoding = 0;
+					}
+					catch (const std::exception& ex)
+					{
+						_logger->log(LogLevel::Warn, "Spectate", "Failed to decode frame " + std::to_string(frame.time), ex);
+					}
+				}
+			}
 
 			std::shared_ptr<RpcService> _rpcService;
 			std::shared_ptr<ILogger> _logger;
+			std::weak_ptr<Scene> _scene;
 			Stormancer::Event<std::vector<Frame>> _onFramesReceived;
+
+			bool _uploadSupported = false;
+			std::size_t _maxBatchBytes = 16384;
+			std::chrono::milliseconds _maxBatchDelay;
+
+			std::mutex _uploadMutex;
+			std::shared_ptr<FrameCodec> _codec;
+			std::shared_ptr<FrameBatch> _nextBatch;
+			details::FrameBatchSequencer _sequencer;
+			// Held while transmitting, to transmit the batches in sequence order
+			std::mutex _transmitMutex;
+			pplx::cancellation_token_source _uploadCts;
+		};
+
+		/// <summary>
+		/// Options of a <c>SpectatePlayback</c>.
+		/// </summary>
+		struct SpectatePlaybackOptions
+		{
+			/// <summary>
+			/// Number of frame time units per second. Frame times are set by the game server, the default value assumes milliseconds.
+			/// </summary>
+			uint64 timeUnitsPerSecond = 1000;
+
+			/// <summary>
+			/// Duration kept behind the most recent frame, in frame time units. Seeking is possible within this window.
+			/// </summary>
+			uint64 window = 30000;
+
+			/// <summary>
+			/// Lower bound of the delay between the most recent frame received and the live playout time, in frame time units.
+			/// </summary>
+			uint64 minDelay = 50;
+
+			/// <summary>
+			/// Upper bound of the delay between the most recent frame received and the live playout time, in frame time units.
+			/// When playout falls further behind, it skips forward.
+			/// </summary>
+			uint64 maxDelay = 1000;
+
+			/// <summary>
+			/// Duration fetched behind the seek time by the first request of a seek, in frame time units, until the distance between two snapshots is known.
+			/// Each further request of the seek doubles the duration, until a snapshot is found.
+			/// </summary>
+			uint64 initialSeekStep = 1000;
+		};
+
+		namespace details
+		{
+			// Playout clock of a SpectatePlayback: playout time is the anchor time at the anchor wall clock time, and advances at normal speed.
+			// Live playout is kept a jitter buffer delay behind the most recent frame.
+			class PlayoutClock
+			{
+			public:
+
+				PlayoutClock(const SpectatePlaybackOptions& options, std::chrono::steady_clock::time_point epoch)
+					: _options(options)
+					, _epoch(epoch)
+				{
+				}
+
+				bool isStarted() const
+				{
+					return _started;
+				}
+
+				bool isLive() const
+				{
+					return _live;
+				}
+
+				// Playout starts live when the first frames are received.
+				void waitLive()
+				{
+					_started = false;
+					_live = true;
+				}
+
+				// Moves playout to time.
+				void anchor(uint64 time, bool live, std::chrono::steady_clock::time_point now)
+				{
+					_anchorTime = time;
+					_anchorWall = now;
+					_live = live;
+					_started = true;
+				}
+
+				// Gets the live playout time for a most recent frame at latestTime.
+				uint64 liveTarget(uint64 latestTime) const
+				{
+					auto delay = currentDelay();
+					return latestTime > delay ? latestTime - delay : 0;
+				}
+
+				uint64 currentDelay() const
+				{
+					// Same margin as the usual playout delay of RTP receivers: a few times the interarrival jitter.
+					auto delay = static_cast<uint64>(4.0 * _jitter);
+					return std::max(_options.minDelay, std::min(delay, _options.maxDelay));
+				}
+
+				// Interarrival jitter estimator of RFC 3550, in frame time units.
+				void onFrameReceived(uint64 frameTime, std::chrono::steady_clock::time_point now)
+				{
+					auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - _epoch).count();
+					auto transit = double(elapsed) * double(_options.timeUnitsPerSecond) / 1000000.0 - double(frameTime);
+					if (_hasTransit)
+					{
+						_jitter += (std::abs(transit - _lastTransit) - _jitter) / 16.0;
+					}
+					_lastTransit = transit;
+					_hasTransit = true;
+				}
+
+				uint64 playoutTime(uint64 latestTime, std::chrono::steady_clock::time_point now)
+				{
+					auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - _anchorWall).count();
+					auto playout = _anchorTime + static_cast<uint64>(double(elapsed) * double(_options.timeUnitsPerSecond) / 1000000.0);
+					auto target = liveTarget(latestTime);
+
+					if (playout > latestTime)
+					{
+						// Buffer underrun: wait for frames, and build up the delay again.
+						_anchorTime = target;
+						_anchorWall = now;
+						playout = target;
+					}
+
+					if (_live)
+					{
+						if (playout + _options.maxDelay < target)
+						{
+							// Too far behind the live stream, for instance after a stall: skip forward. The frames skipped are still returned by poll().
+							_anchorTime = target;
+							_anchorWall = now;
+							playout = target;
+						}
+					}
+					else if (playout >= target)
+					{
+						_live = true;
+					}
+					return playout;
+				}
+
+			private:
+
+				SpectatePlaybackOptions _options;
+				bool _started = false;
+				bool _live = false;
+				uint64 _anchorTime = 0;
+				std::chrono::steady_clock::time_point _anchorWall;
+
+				std::chrono::steady_clock::time_point _epoch;
+				bool _hasTransit = false;
+				double _lastTransit = 0;
+				double _jitter = 0;
+			};
+		}
+
+		/// <summary>
+		/// Buffers the frames of a spectated game for playback.
+		/// </summary>
+		/// <remarks>
+		/// Frames received live and frames fetched with <c>GetFrames</c> are kept ordered by time, for <c>SpectatePlaybackOptions::window</c> behind the most recent one.
+		/// Snapshots are indexed, so that seeking to a time only requires the frames from the preceding snapshot, and only the ranges missing from the buffer are fetched.
+		/// Live playout is delayed by a jitter buffer, whose delay follows the variation of the frame arrival times.
+		/// Must be created with std::make_shared.
+		/// </remarks>
+		class SpectatePlayback : public std::enable_shared_from_this<SpectatePlayback>
+		{
+		public:
+
+			SpectatePlayback(std::shared_ptr<SpectateService> service, SpectatePlaybackOptions options = SpectatePlaybackOptions())
+				: _service(service)
+				, _options(options)
+				, _clock(options, std::chrono::steady_clock::now())
+			{
+				_keyframeSpacing = std::max<uint64>(_options.initialSeekStep, 1);
+			}
+
+			/// <summary>
+			/// Starts receiving the live frames. Playout starts the jitter buffer delay behind the last frame sent before the call.
+			/// </summary>
+			pplx::task<void> start(pplx::cancellation_token ct = pplx::cancellation_token::none())
+			{
+				std::weak_ptr<SpectatePlayback> wThat = this->shared_from_this();
+				_subscription = _service->subscribeToFrames([wThat](std::vector<Frame> frames)
+				{
+					if (auto that = wThat.lock())
+					{
+						that->onLiveFrames(frames);
+					}
+				});
+
+				return _service->startReceiveFrames(ct).then([wThat](uint64 lastFrameTime)
+				{
+					auto that = wThat.lock();
+					if (!that)
+					{
+						throw ObjectDeletedException("SpectatePlayback");
+					}
+
+					uint64 target;
+					{
+						std::lock_guard<std::mutex> lg(that->_mutex);
+						// Frames after the last one sent before the subscription are pushed.
+						that->_liveStart = lastFrameTime + 1;
+						that->_liveStartKnown = true;
+						that->_latestTime = std::max(that->_latestTime, lastFrameTime);
+						if (that->_hasFrames)
+						{
+							that->addCoverage(that->_liveStart, that->_latestTime);
+						}
+						if (lastFrameTime == 0)
+						{
+							// No frame yet: playout starts with the first frame received.
+							that->_clock.waitLive();
+							return pplx::task_from_result();
+						}
+						target = that->_clock.liveTarget(that->_latestTime);
+					}
+					return that->seekInternal(target, true);
+				});
+			}
+
+			/// <summary>
+			/// Stops receiving the live frames. Buffered frames can still be played.
+			/// </summary>
+			pplx::task<void> stop()
+			{
+				_subscription = nullptr;
+				return _service->stopReceiveFrames();
+			}
+
+			/// <summary>
+			/// Gets the frames to apply since the previous call, up to the current playout time.
+			/// </summary>
+			/// <remarks>
+			/// After a seek, the first frames returned start with the snapshot preceding the seek time.
+			/// Returns nothing while a seek is fetching frames.
+			/// </remarks>
+			std::vector<FrameList> poll()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				std::vector<FrameList> result;
+				if (_seeking || !_clock.isStarted())
+				{
+					return result;
+				}
+
+				auto playout = _clock.playoutTime(_latestTime, std::chrono::steady_clock::now());
+				if (playout < _nextDelivery)
+				{
+					return result;
+				}
+
+				auto it = std::lower_bound(_frames.begin(), _frames.end(), _nextDelivery, [](const FrameList& frameList, uint64 time) { return frameList.time < time; });
+				for (; it != _frames.end() && it->time <= playout; ++it)
+				{
+					result.push_back(*it);
+				}
+				_nextDelivery = playout + 1;
+				return result;
+			}
+
+			/// <summary>
+			/// Moves playout to a time within the window. Playout continues from there at normal speed.
+			/// </summary>
+			/// <returns>A task that completes when the frames required to play from this time are buffered.</returns>
+			pplx::task<void> seek(uint64 time)
+			{
+				return seekInternal(time, false);
+			}
+
+			/// <summary>
+			/// Moves playout back to the live stream, after a seek.
+			/// </summary>
+			pplx::task<void> goLive()
+			{
+				uint64 target;
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					target = _clock.liveTarget(_latestTime);
+				}
+				return seekInternal(target, true);
+			}
+
+			/// <summary>
+			/// Gets the current playout time.
+			/// </summary>
+			uint64 playoutTime()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return _clock.isStarted() ? _clock.playoutTime(_latestTime, std::chrono::steady_clock::now()) : 0;
+			}
+
+			/// <summary>
+			/// True if playout follows the live stream, false after a seek until playout catches up with it.
+			/// </summary>
+			bool isLive()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return _clock.isLive();
+			}
+
+			/// <summary>
+			/// Gets the time of the most recent frame.
+			/// </summary>
+			uint64 latestTime()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return _latestTime;
+			}
+
+			/// <summary>
+			/// Gets the earliest time playout can seek to.
+			/// </summary>
+			uint64 earliestTime()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return windowFloor();
+			}
+
+			/// <summary>
+			/// Gets the times of the buffered snapshots.
+			/// </summary>
+			std::vector<uint64> keyframes()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return std::vector<uint64>(_keyframes.begin(), _keyframes.end());
+			}
+
+			/// <summary>
+			/// Gets the current delay between the most recent frame and the live playout time.
+			/// </summary>
+			uint64 delay()
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				return _clock.currentDelay();
+			}
+
+		private:
+
+			void onLiveFrames(const std::vector<Frame>& frames)
+			{
+				if (frames.empty())
+				{
+					return;
+				}
+
+				auto now = std::chrono::steady_clock::now();
+				std::lock_guard<std::mutex> lg(_mutex);
+
+				uint64 minTime = frames.front().time;
+				uint64 maxTime = frames.front().time;
+				for (const auto& frame : frames)
+				{
+					minTime = std::min(minTime, frame.time);
+					maxTime = std::max(maxTime, frame.time);
+					insert(frame);
+				}
+
+				_clock.onFrameReceived(maxTime, now);
+				_latestTime = std::max(_latestTime, maxTime);
+				if (!_liveStartKnown && !_hasFrames)
+				{
+					_liveStart = minTime;
+				}
+				_hasFrames = true;
+				addCoverage(_liveStart, _latestTime);
+
+				if (!_clock.isStarted() && _clock.isLive() && !_seeking)
+				{
+					// First frames of a game that had not started when playback started.
+					_clock.anchor(_clock.liveTarget(_latestTime), true, now);
+					_nextDelivery = minTime;
+				}
+
+				evict();
+			}
+
+			pplx::task<void> seekInternal(uint64 time, bool live)
+			{
+				uint64 generation;
+				uint64 from;
+				uint64 step;
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					auto floor = windowFloor();
+					time = std::max(floor, std::min(time, _latestTime));
+					generation = ++_seekGeneration;
+					_seeking = true;
+
+					uint64 keyframe;
+					if (tryFindKeyframe(time, keyframe))
+					{
+						completeSeek(time, keyframe, live);
+						return pplx::task_from_result();
+					}
+					step = _keyframeSpacing;
+					from = time - std::min(time - floor, step);
+				}
+				return seekFrom(time, from, step, live, generation);
+			}
+
+			// Fetches the missing frames between from and time, then looks for a snapshot in them.
+			// Goes further back if there is none, doubling the step so that a distant snapshot is found in a few requests.
+			pplx::task<void> seekFrom(uint64 time, uint64 from, uint64 step, bool live, uint64 generation)
+			{
+				std::vector<std::pair<uint64, uint64>> missing;
+				{
+					std::lock_guard<std::mutex> lg(_mutex);
+					missing = missingRanges(from, time);
+				}
+
+				std::weak_ptr<SpectatePlayback> wThat = this->shared_from_this();
+				return fetch(missing).then([wThat, time, from, step, live, generation](pplx::task<void> task)
+				{
+					auto that = wThat.lock();
+					if (!that)
+					{
+						throw ObjectDeletedException("SpectatePlayback");
+					}
+
+					uint64 nextFrom;
+					uint64 nextStep;
+					{
+						std::lock_guard<std::mutex> lg(that->_mutex);
+						if (generation != that->_seekGeneration)
+						{
+							// Superseded by another seek
+							return pplx::task_from_result();
+						}
+
+						try
+						{
+							task.get();
+						}
+						catch (...)
+						{
+							// Playout continues from where it was.
+							that->_seeking = false;
+							throw;
+						}
+
+						auto floor = that->windowFloor();
+						uint64 keyframe;
+						if (that->tryFindKeyframe(time, keyframe))
+						{
+							that->completeSeek(time, keyframe, live);
+							return pplx::task_from_result();
+						}
+						if (from <= floor)
+						{
+							// No snapshot within the window: play the diffs available.
+							that->completeSeek(time, floor, live);
+							return pplx::task_from_result();
+						}
+						nextStep = std::max(step * 2, that->_keyframeSpacing);
+						nextFrom = from - std::min(from - floor, nextStep);
+					}
+					return that->seekFrom(time, nextFrom, nextStep, live, generation);
+				});
+			}
+
+			pplx::task<void> fetch(const std::vector<std::pair<uint64, uint64>>& ranges)
+			{
+				std::vector<pplx::task<void>> tasks;
+				std::weak_ptr<SpectatePlayback> wThat = this->shared_from_this();
+				for (const auto& range : ranges)
+				{
+					tasks.push_back(_service->GetFrames(range.first, range.second).then([wThat, range](std::vector<FrameList> frameLists)
+					{
+						if (auto that = wThat.lock())
+						{
+							std::lock_guard<std::mutex> lg(that->_mutex);
+							for (const auto& frameList : frameLists)
+							{
+								for (const auto& frame : frameList.frames)
+								{
+									that->insert(frame);
+									that->_latestTime = std::max(that->_latestTime, frame.time);
+								}
+							}
+							that->addCoverage(range.first, range.second);
+						}
+					}));
+				}
+				return pplx::when_all(tasks.begin(), tasks.end());
+			}
+
+			// Requires _mutex
+			void completeSeek(uint64 time, uint64 from, bool live)
+			{
+				_clock.anchor(time, live, std::chrono::steady_clock::now());
+				_nextDelivery = from;
+				_seeking = false;
+			}
+
+			// Requires _mutex
+			// Finds the latest snapshot at or before time, such that all the frames between them are buffered.
+			bool tryFindKeyframe(uint64 time, uint64& keyframe) const
+			{
+				auto it = std::upper_bound(_keyframes.begin(), _keyframes.end(), time);
+				if (it == _keyframes.begin())
+				{
+					return false;
+				}
+				keyframe = *std::prev(it);
+				return missingRanges(keyframe, time).empty();
+			}
+
+			// Requires _mutex
+			uint64 windowFloor() const
+			{
+				return _latestTime > _options.window ? _latestTime - _options.window : 0;
+			}
+
+			// Requires _mutex
+			void insert(const Frame& frame)
+			{
+				auto it = std::lower_bound(_frames.begin(), _frames.end(), frame.time, [](const FrameList& frameList, uint64 time) { return frameList.time < time; });
+				if (it == _frames.end() || it->time != frame.time)
+				{
+					FrameList frameList;
+					frameList.time = frame.time;
+					it = _frames.insert(it, frameList);
+				}
+				else
+				{
+					// A fetched range can overlap frames pushed while the request was running.
+					for (const auto& existing : it->frames)
+					{
+						if (existing.type == frame.type && existing.origin == frame.origin && existing.data == frame.data)
+						{
+							return;
+						}
+					}
+				}
+				it->frames.push_back(frame);
+
+				if (frame.type == FrameType::Snapshot)
+				{
+					auto keyframeIt = std::lower_bound(_keyframes.begin(), _keyframes.end(), frame.time);
+					if (keyframeIt == _keyframes.end() || *keyframeIt != frame.time)
+					{
+						keyframeIt = _keyframes.insert(keyframeIt, frame.time);
+						if (keyframeIt != _keyframes.begin())
+						{
+							_keyframeSpacing = std::max<uint64>(frame.time - *std::prev(keyframeIt), 1);
+						}
+					}
+				}
+			}
+
+			// Requires _mutex
+			// Drops the frames out of the window.
+			void evict()
+			{
+				auto floor = windowFloor();
+				while (!_frames.empty() && _frames.front().time < floor)
+				{
+					_frames.pop_front();
+				}
+				while (!_keyframes.empty() && _keyframes.front() < floor)
+				{
+					_keyframes.pop_front();
+				}
+				while (!_covered.empty() && _covered.begin()->second < floor)
+				{
+					_covered.erase(_covered.begin());
+				}
+				if (!_covered.empty() && _covered.begin()->first < floor)
+				{
+					auto end = _covered.begin()->second;
+					_covered.erase(_covered.begin());
+					_covered.emplace(floor, end);
+				}
+			}
+
+			// Requires _mutex
+			// Records that all the frames between start and end (inclusive) are buffered.
+			void addCoverage(uint64 start, uint64 end)
+			{
+				if (end < start)
+				{
+					return;
+				}
+
+				auto it = _covered.upper_bound(start);
+				if (it != _covered.begin())
+				{
+					auto previous = std::prev(it);
+					if (previous->second + 1 >= start)
+					{
+						start = previous->first;
+						end = std::max(end, previous->second);
+						it = _covered.erase(previous);
+					}
+				}
+				while (it != _covered.end() && it->first <= end + 1)
+				{
+					end = std::max(end, it->second);
+					it = _covered.erase(it);
+				}
+				_covered.emplace(start, end);
+			}
+
+			// Requires _mutex
+			std::vector<std::pair<uint64, uint64>> missingRanges(uint64 start, uint64 end) const
+			{
+				std::vector<std::pair<uint64, uint64>> result;
+				if (end < start)
+				{
+					return result;
+				}
+
+				auto cursor = start;
+				auto it = _covered.upper_bound(start);
+				if (it != _covered.begin())
+				{
+					--it;
+				}
+				for (; it != _covered.end() && it->first <= end; ++it)
+				{
+					if (it->second < cursor)
+					{
+						continue;
+					}
+					if (it->first > cursor)
+					{
+						result.emplace_back(cursor, it->first - 1);
+					}
+					if (it->second >= end)
+					{
+						return result;
+					}
+					cursor = it->second + 1;
+				}
+				result.emplace_back(cursor, end);
+				return result;
+			}
+
+			std::shared_ptr<SpectateService> _service;
+			SpectatePlaybackOptions _options;
+			Stormancer::Subscription _subscription;
+
+			std::mutex _mutex;
+			// Ordered by time, within the window
+			std::deque<FrameList> _frames;
+			// Times of the snapshots in _frames
+			std::deque<uint64> _keyframes;
+			// Last observed distance between two snapshots, SpectatePlaybackOptions::initialSeekStep until two snapshots were received
+			uint64 _keyframeSpacing;
+			// Buffered time ranges (start, inclusive end), by start
+			std::map<uint64, uint64> _covered;
+			uint64 _latestTime = 0;
+			bool _hasFrames = false;
+			uint64 _liveStart = 0;
+			bool _liveStartKnown = false;
+
+			details::PlayoutClock _clock;
+			bool _seeking = false;
+			uint64 _seekGeneration = 0;
+			uint64 _nextDelivery = 0;
 		};
 
 		class SpectatePlugin : public Stormancer::IPlugin
@@ -141,7 +1273,7 @@ namespace Stormancer
 				auto name = scene->getHostMetadata("stormancer.spectate");
 				if (name.length() > 0)
 				{
-					builder.registerDependency<SpectateService, RpcService, ILogger>().singleInstance();
+					builder.registerDependency<SpectateService, RpcService, ILogger, Configuration>().singleInstance();
 				}
 			}
 		};
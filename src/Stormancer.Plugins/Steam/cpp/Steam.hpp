@@ -3,6 +3,7 @@
 #include "Friends/Friends.hpp"
 #include "Party/Party.hpp"
 #include "Users/Users.hpp"
+#include "Users/LookupCache.hpp"
 
 #include "stormancer/Configuration.h"
 #include "stormancer/IPlugin.h"
@@ -535,7 +536,7 @@ namespace Stormancer
 
 #pragma region public_methods
 
-				SteamImpl(std::shared_ptr<Users::UsersApi> usersApi, std::shared_ptr<SteamState> steamConfig, std::shared_ptr<Configuration> config, std::shared_ptr<IScheduler> scheduler, std::shared_ptr<ILogger> logger, std::shared_ptr<Party::PartyApi> partyApi, std::shared_ptr<Party::Platform::InvitationMessenger> invitationMessenger)
+				SteamImpl(std::shared_ptr<Users::UsersApi> usersApi, std::shared_ptr<SteamState> steamConfig, std::shared_ptr<Configuration> config, std::shared_ptr<IScheduler> scheduler, std::shared_ptr<ILogger> logger, std::shared_ptr<Party::PartyApi> partyApi, std::shared_ptr<Party::Platform::InvitationMessenger> invitationMessenger, std::shared_ptr<PeriodicTaskScheduler> periodicTaskScheduler)
 					: ClientAPI(usersApi, "stormancer.steam")
 					, _wSteamConfig(steamConfig)
 					, _wScheduler(scheduler)
@@ -544,11 +545,16 @@ namespace Stormancer
 					, _wUsersApi(usersApi)
 					, _wPartyApi(partyApi)
 					, _wInvitationMessenger(invitationMessenger)
+					, _runCallbacksTask(periodicTaskScheduler->createTask("steam.runCallbacks", std::chrono::milliseconds(16), []()
+						{
+							SteamAPI_RunCallbacks();
+						}))
 				{}
 
 				~SteamImpl()
 				{
 					_cts.cancel();
+					_runCallbacksTask->stop();
 				}
 
 				void initializePartyScene(std::shared_ptr<Scene> scene)
@@ -713,7 +719,7 @@ namespace Stormancer
 
 						if (steamConfig->getSteamApiRunCallbacks())
 						{
-							scheduleRunSteamAPiCallbacks();
+							_runCallbacksTask->start();
 						}
 
 						auto connectLobbyArgument = steamConfig->getConnectLobby();
@@ -868,26 +874,6 @@ namespace Stormancer
 				}
 
 
-				void scheduleRunSteamAPiCallbacks()
-				{
-					if (!_cts.get_token().is_canceled())
-					{
-						SteamAPI_RunCallbacks();
-
-						if (auto actionDispatcher = _wActionDispatcher.lock())
-						{
-							auto wSteamImpl = STORM_WEAK_FROM_THIS();
-							actionDispatcher->post([wSteamImpl]()
-								{
-									if (auto steamImpl = wSteamImpl.lock())
-									{
-										steamImpl->scheduleRunSteamAPiCallbacks();
-									}
-								});
-						}
-					}
-				}
-
 				SteamID getSteamID() override
 				{
 					auto steamUser = SteamUser();
@@ -1303,19 +1289,32 @@ namespace Stormancer
 
 				pplx::task<std::unordered_map<SteamID, std::string>> queryUserIds(const std::vector<SteamID>& steamIDs, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
 				{
-					return getService([](auto, auto, auto) {}, [](auto, auto) {}, ct)
-						.then([steamIDs, ct](std::shared_ptr<SteamService> service)
-							{
-								return service->queryUserIds(steamIDs, ct);
-							});
+					return userIdsCache()->get(steamIDs, ct);
 				}
 
 				pplx::task<std::unordered_map<std::string, PartyDataDto>> decodePartyDataBearerTokens(const std::unordered_map<std::string, std::string>& partyDataBearerTokens, pplx::cancellation_token ct = pplx::cancellation_token::none()) override
 				{
-					return getService([](auto, auto, auto) {}, [](auto, auto) {}, ct)
-						.then([partyDataBearerTokens, ct](std::shared_ptr<SteamService> service)
+					// Cached by token rather than by lobby: a lobby gets a new token when its party changes.
+					std::vector<std::string> tokens;
+					tokens.reserve(partyDataBearerTokens.size());
+					for (const auto& kvp : partyDataBearerTokens)
+					{
+						tokens.push_back(kvp.second);
+					}
+
+					return partyDataCache()->get(tokens, ct)
+						.then([partyDataBearerTokens](std::unordered_map<std::string, PartyDataDto> dtosByToken)
 							{
-								return service->decodePartyDataBearerTokens(partyDataBearerTokens, ct);
+								std::unordered_map<std::string, PartyDataDto> dtos;
+								for (const auto& kvp : partyDataBearerTokens)
+								{
+									auto it = dtosByToken.find(kvp.second);
+									if (it != dtosByToken.end())
+									{
+										dtos.emplace(kvp.first, it->second);
+									}
+								}
+								return dtos;
 							});
 				}
 
@@ -1595,6 +1594,76 @@ namespace Stormancer
 					}
 				}
 
+				// Lookups issued within this window, for instance while rendering a friends list, are sent in a single request.
+				// A function rather than a static constexpr member: copying a duration ODR-uses it, which would require an out-of-class definition before C++17.
+				static std::chrono::milliseconds lookupBatchWindow()
+				{
+					return std::chrono::milliseconds(10);
+				}
+
+				std::shared_ptr<LookupCache<SteamID, std::string>> userIdsCache()
+				{
+					std::lock_guard<std::recursive_mutex> lg(_mutex);
+					if (!_userIdsCache)
+					{
+						auto wSteamImpl = STORM_WEAK_FROM_THIS();
+						// The user id of a Steam account never changes, the TTL only bounds the lifetime of ids of deleted users.
+						_userIdsCache = std::make_shared<LookupCache<SteamID, std::string>>([wSteamImpl](const std::vector<SteamID>& steamIDs)
+							{
+								auto steamImpl = wSteamImpl.lock();
+								if (!steamImpl)
+								{
+									return pplx::task_from_exception<std::unordered_map<SteamID, std::string>>(ObjectDeletedException("SteamImpl"));
+								}
+								return steamImpl->getService([](auto, auto, auto) {}, [](auto, auto) {})
+									.then([steamIDs](std::shared_ptr<SteamService> service)
+										{
+											return service->queryUserIds(steamIDs);
+										})
+									.then([](std::unordered_map<SteamID, std::string> userIds)
+										{
+											// Steam accounts without Stormancer user are looked up again next time.
+											for (auto it = userIds.begin(); it != userIds.end();)
+											{
+												it = it->second.empty() ? userIds.erase(it) : std::next(it);
+											}
+											return userIds;
+										});
+							}, 4096, std::chrono::hours(1), lookupBatchWindow());
+					}
+					return _userIdsCache;
+				}
+
+				std::shared_ptr<LookupCache<std::string, PartyDataDto>> partyDataCache()
+				{
+					std::lock_guard<std::recursive_mutex> lg(_mutex);
+					if (!_partyDataCache)
+					{
+						auto wSteamImpl = STORM_WEAK_FROM_THIS();
+						_partyDataCache = std::make_shared<LookupCache<std::string, PartyDataDto>>([wSteamImpl](const std::vector<std::string>& tokens)
+							{
+								auto steamImpl = wSteamImpl.lock();
+								if (!steamImpl)
+								{
+									return pplx::task_from_exception<std::unordered_map<std::string, PartyDataDto>>(ObjectDeletedException("SteamImpl"));
+								}
+
+								// The server API is keyed by lobby, tokens are used as keys since they are unique.
+								std::unordered_map<std::string, std::string> partyDataBearerTokens;
+								for (const auto& token : tokens)
+								{
+									partyDataBearerTokens.emplace(token, token);
+								}
+								return steamImpl->getService([](auto, auto, auto) {}, [](auto, auto) {})
+									.then([partyDataBearerTokens](std::shared_ptr<SteamService> service)
+										{
+											return service->decodePartyDataBearerTokens(partyDataBearerTokens);
+										});
+							}, 256, std::chrono::minutes(5), lookupBatchWindow());
+					}
+					return _partyDataCache;
+				}
+
 
 
 				std::string convertEChatRoomEnterResponseToString(uint32 chatRoomEnterResponse)
@@ -1645,6 +1714,8 @@ namespace Stormancer
 				SteamIDLobby _partySteamIDLobby = 0;
 				Subscription _gameConnectionStateSub;
 				std::unordered_map<SteamIDLobby, pplx::task_completion_event<Lobby>> _requestLobbyDataTces;
+				std::shared_ptr<LookupCache<SteamID, std::string>> _userIdsCache;
+				std::shared_ptr<LookupCache<std::string, PartyDataDto>> _partyDataCache;
 				std::shared_ptr<pplx::task_completion_event<std::vector<Lobby>>> _requestLobbyListTce; // shared_ptr is used as an optional
 				std::unordered_map<SteamIDLobby, LobbyEnterEventData> _lobbyEnterEventData;
 				std::shared_ptr<pplx::task_completion_event<SteamIDLobby>> _lobbyCreatedTce; // shared_ptr is used as an optional
@@ -1656,6 +1727,7 @@ namespace Stormancer
 				std::weak_ptr<Users::UsersApi> _wUsersApi;
 				std::weak_ptr<Party::PartyApi> _wPartyApi;
 				std::weak_ptr<Party::Platform::InvitationMessenger> _wInvitationMessenger;
+				std::shared_ptr<PeriodicTask> _runCallbacksTask;
 
 #pragma endregion
 			};
@@ -2132,11 +2204,14 @@ namespace Stormancer
 					}
 
 					auto advertisedParties = std::make_shared<std::vector<Party::AdvertisedParty>>();
+					auto dtos = std::make_shared<std::unordered_map<std::string, PartyDataDto>>();
+					auto mapSteamIdToUserId = std::make_shared<std::unordered_map<SteamID, std::string>>();
 
 					return pplx::when_all(lobbyTasks.begin(), lobbyTasks.end())
-						.then([steamApi, mapSteamIDLobbyToFriend, advertisedParties, ct, logger = _logger](std::vector<Steam::Lobby> lobbies)
+						.then([steamApi, mapSteamIDLobbyToFriend, advertisedParties, dtos, mapSteamIdToUserId, ct, logger = _logger](std::vector<Steam::Lobby> lobbies)
 							{
 								std::unordered_map<std::string, std::string> partyDataTokens;
+								std::vector<SteamID> steamIDs;
 
 								for (auto& lobby : lobbies)
 								{
@@ -2161,42 +2236,44 @@ namespace Stormancer
 												advertisedParty.metadata["steam.lobbyData." + kvp.first] = kvp.second;
 											}
 											advertisedParties->push_back(advertisedParty);
+											steamIDs.push_back(steamIDFriend);
 										}
 									}
 								}
 
-								auto task = partyDataTokens.size() > 0
-									? steamApi->decodePartyDataBearerTokens(partyDataTokens, ct)
-									: pplx::task_from_result(std::unordered_map<std::string, PartyDataDto>());
+								if (partyDataTokens.empty())
+								{
+									return pplx::task_from_result();
+								}
 
-								return task;
+								// Friends' user ids are resolved in parallel with the party data tokens instead of after them. Most of them are served by the user id cache.
+								auto decodeTask = steamApi->decodePartyDataBearerTokens(partyDataTokens, ct)
+									.then([dtos](std::unordered_map<std::string, PartyDataDto> result)
+										{
+											*dtos = std::move(result);
+										});
+								auto userIdsTask = steamApi->queryUserIds(steamIDs, ct)
+									.then([mapSteamIdToUserId](std::unordered_map<SteamID, std::string> result)
+										{
+											*mapSteamIdToUserId = std::move(result);
+										});
+								return decodeTask && userIdsTask;
 							})
-						.then([steamApi, advertisedParties, ct, logger = _logger](std::unordered_map<std::string, PartyDataDto> dtos)
+						.then([advertisedParties, dtos, mapSteamIdToUserId]()
 							{
-								std::vector<SteamID> steamIDs;
-
 								for (auto& advertisedParty : *advertisedParties)
 								{
-									auto it = dtos.find(advertisedParty.metadata["steam.steamIDLobby"]);
-									if (it != dtos.end())
+									auto dtoIt = dtos->find(advertisedParty.metadata["steam.steamIDLobby"]);
+									if (dtoIt != dtos->end())
 									{
-										auto& dto = it->second;
+										auto& dto = dtoIt->second;
 										advertisedParty.partyId.id = dto.partyId;
 										advertisedParty.partyId.type = Party::PartyId::TYPE_PARTY_ID;
 										advertisedParty.leaderUserId = dto.leaderUserId;
-
-										steamIDs.push_back(std::stoull(advertisedParty.metadata["steam.steamIDFriend"]));
 									}
-								}
 
-								return steamApi->queryUserIds(steamIDs, ct);
-							})
-						.then([advertisedParties](std::unordered_map<SteamID, std::string> mapSteamIdToUserId)
-							{
-								for (auto& advertisedParty : *advertisedParties)
-								{
-									auto it = mapSteamIdToUserId.find(std::stoull(advertisedParty.metadata["steam.steamIDFriend"]));
-									if (it != mapSteamIdToUserId.end())
+									auto it = mapSteamIdToUserId->find(std::stoull(advertisedParty.metadata["steam.steamIDFriend"]));
+									if (it != mapSteamIdToUserId->end())
 									{
 										auto& friendId = it->second;
 										advertisedParty.metadata["stormancer.friendId"] = friendId;
@@ -2407,7 +2484,7 @@ namespace Stormancer
 			void registerClientDependencies(ContainerBuilder& builder) override
 			{
 				builder.registerDependency<details::SteamState, Configuration, ILogger>().singleInstance();
-				builder.registerDependency<details::SteamImpl, Users::UsersApi, details::SteamState, Configuration, IScheduler, ILogger, Party::PartyApi, Party::Platform::InvitationMessenger>().asSelf().as<SteamApi>().singleInstance();
+				builder.registerDependency<details::SteamImpl, Users::UsersApi, details::SteamState, Configuration, IScheduler, ILogger, Party::PartyApi, Party::Platform::InvitationMessenger, PeriodicTaskScheduler>().asSelf().as<SteamApi>().singleInstance();
 				builder.registerDependency<details::SteamPartyProvider, Party::Platform::InvitationMessenger, Users::UsersApi, details::SteamImpl, ILogger, Party::PartyApi, IActionDispatcher>().as<Party::Platform::IPlatformSupportProvider>();
 				builder.registerDependency<SteamAuthenticationEventHandler, details::SteamState>().as<Users::IAuthenticationEventHandler>();
 			}
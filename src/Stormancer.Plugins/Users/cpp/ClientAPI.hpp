@@ -42,7 +42,32 @@ namespace Stormancer
 
 				if (!_scene)
 				{
-					_scene = std::make_shared<pplx::task<std::shared_ptr<Scene>>>(users->getSceneForService(_type, _name, ct)
+					RetryPolicyOptions retryOptions;
+					retryOptions.baseDelay = std::chrono::milliseconds(500);
+					retryOptions.maxDelay = std::chrono::milliseconds(5000);
+					retryOptions.maxAttempts = 3;
+					retryOptions.circuitBreakerOpenDuration = std::chrono::milliseconds(10000);
+					auto retryPolicy = users->createRetryPolicy(Users::ConfigurationKeys::ServiceRetryPrefix + _type, retryOptions);
+
+					std::weak_ptr<Users::UsersApi> wUsers = users;
+					auto type = _type;
+					auto name = _name;
+					auto getScene = retryPolicy.execute<std::shared_ptr<Scene>>([wUsers, type, name](pplx::cancellation_token ct)
+						{
+							auto users = wUsers.lock();
+							if (!users)
+							{
+								return pplx::task_from_exception<std::shared_ptr<Scene>>(ObjectDeletedException("UsersApi"));
+							}
+							return users->getSceneForService(type, name, ct);
+						}, [wUsers](const std::exception&)
+						{
+							// Connection failures while logged out are handled by the reconnection of UsersApi.
+							auto users = wUsers.lock();
+							return users && users->connectionState() == Users::GameConnectionState::Authenticated;
+						}, ct);
+
+					_scene = std::make_shared<pplx::task<std::shared_ptr<Scene>>>(getScene
 						.then([wThat, cleanup](std::shared_ptr<Scene> scene)
 							{
 								auto that = wThat.lock();
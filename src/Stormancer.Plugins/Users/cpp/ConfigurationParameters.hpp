@@ -0,0 +1,136 @@
+#pragma once
+
+#include "stormancer/Configuration.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Stormancer
+{
+	namespace details
+	{
+		// std::stoull and std::stod accept a leading '-', and std::stoull wraps negative values around to huge ones.
+		inline bool isNegativeConfigurationValue(const std::string& value)
+		{
+			auto it = std::find_if(value.begin(), value.end(), [](char c) { return !std::isspace(static_cast<unsigned char>(c)); });
+			return it != value.end() && *it == '-';
+		}
+
+		template<typename TParameters>
+		bool tryReadConfigurationParameter(const TParameters& parameters, const std::string& key, unsigned long long& value)
+		{
+			auto it = parameters.find(key);
+			if (it == parameters.end() || isNegativeConfigurationValue(it->second))
+			{
+				return false;
+			}
+			try
+			{
+				value = std::stoull(it->second);
+				return true;
+			}
+			catch (const std::exception&)
+			{
+				return false;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Reads a non-negative integer from a map of configuration parameters, like <c>Configuration::additionalParameters</c>.
+	/// </summary>
+	/// <param name="parameters">Configuration parameters.</param>
+	/// <param name="key">Key of the parameter.</param>
+	/// <param name="defaultValue">Value returned if the parameter is not set, or is not a valid non-negative integer.</param>
+	/// <returns>The value of the parameter.</returns>
+	template<typename TParameters>
+	std::size_t readConfigurationParameter(const TParameters& parameters, const std::string& key, std::size_t defaultValue)
+	{
+		unsigned long long value;
+		if (!details::tryReadConfigurationParameter(parameters, key, value) || value > std::numeric_limits<std::size_t>::max())
+		{
+			return defaultValue;
+		}
+		return static_cast<std::size_t>(value);
+	}
+
+	/// <summary>
+	/// Reads a duration in milliseconds from a map of configuration parameters.
+	/// </summary>
+	/// <param name="parameters">Configuration parameters.</param>
+	/// <param name="key">Key of the parameter.</param>
+	/// <param name="defaultValue">Value returned if the parameter is not set, or is not a valid non-negative integer.</param>
+	/// <returns>The value of the parameter.</returns>
+	template<typename TParameters>
+	std::chrono::milliseconds readConfigurationParameter(const TParameters& parameters, const std::string& key, std::chrono::milliseconds defaultValue)
+	{
+		using Rep = std::chrono::milliseconds::rep;
+		unsigned long long value;
+		if (!details::tryReadConfigurationParameter(parameters, key, value))
+		{
+			return defaultValue;
+		}
+		unsigned long long maxValue = std::numeric_limits<Rep>::max();
+		return std::chrono::milliseconds(static_cast<Rep>(std::min(value, maxValue)));
+	}
+
+	/// <summary>
+	/// Reads a fraction between 0 and 1 from a map of configuration parameters. Values above 1 are lowered to 1.
+	/// </summary>
+	/// <param name="parameters">Configuration parameters.</param>
+	/// <param name="key">Key of the parameter.</param>
+	/// <param name="defaultValue">Value returned if the parameter is not set, or is not a valid non-negative number.</param>
+	/// <returns>The value of the parameter.</returns>
+	template<typename TParameters>
+	double readConfigurationFraction(const TParameters& parameters, const std::string& key, double defaultValue)
+	{
+		auto it = parameters.find(key);
+		if (it == parameters.end() || details::isNegativeConfigurationValue(it->second))
+		{
+			return defaultValue;
+		}
+		try
+		{
+			auto value = std::stod(it->second);
+			// Also rejects NaN
+			if (!(value >= 0))
+			{
+				return defaultValue;
+			}
+			return std::min(1.0, value);
+		}
+		catch (const std::exception&)
+		{
+			return defaultValue;
+		}
+	}
+
+	/// <summary>
+	/// Reads a non-negative integer from <c>Configuration::additionalParameters</c>.
+	/// </summary>
+	/// <param name="config">Client configuration.</param>
+	/// <param name="key">Key of the parameter.</param>
+	/// <param name="defaultValue">Value returned if the parameter is not set, or is not a valid non-negative integer.</param>
+	/// <returns>The value of the parameter.</returns>
+	inline std::size_t readConfigurationParameter(const std::shared_ptr<Configuration>& config, const std::string& key, std::size_t defaultValue)
+	{
+		return readConfigurationParameter(config->additionalParameters, key, defaultValue);
+	}
+
+	/// <summary>
+	/// Reads a duration in milliseconds from <c>Configuration::additionalParameters</c>.
+	/// </summary>
+	/// <param name="config">Client configuration.</param>
+	/// <param name="key">Key of the parameter.</param>
+	/// <param name="defaultValue">Value returned if the parameter is not set, or is not a valid non-negative integer.</param>
+	/// <returns>The value of the parameter.</returns>
+	inline std::chrono::milliseconds readConfigurationParameter(const std::shared_ptr<Configuration>& config, const std::string& key, std::chrono::milliseconds defaultValue)
+	{
+		return readConfigurationParameter(config->additionalParameters, key, defaultValue);
+	}
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "stormancer/Tasks.h"
+#include "stormancer/Utilities/TaskUtilities.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Stormancer
+{
+	/// <summary>
+	/// Client side cache of a key to value mapping resolved by batch requests, for instance platform ids to Stormancer user ids.
+	/// </summary>
+	/// <remarks>
+	/// Values are kept for a limited time, and the least recently used ones are evicted when the capacity is reached.
+	/// A key already being fetched is not fetched again, and keys requested within the batch window are fetched with a single request.
+	/// Keys missing from the fetch result are not cached.
+	/// Must be created with std::make_shared.
+	/// </remarks>
+	template<typename TKey, typename TValue, typename THash = std::hash<TKey>>
+	class LookupCache : public std::enable_shared_from_this<LookupCache<TKey, TValue, THash>>
+	{
+	public:
+
+		using Map = std::unordered_map<TKey, TValue, THash>;
+		using Fetch = std::function<pplx::task<Map>(const std::vector<TKey>&)>;
+
+		/// <param name="fetch">Requests the values of a batch of keys.</param>
+		/// <param name="capacity">Maximum number of cached values.</param>
+		/// <param name="ttl">How long a value is served from the cache.</param>
+		/// <param name="batchWindow">How long to wait for other lookups before sending a request. 0 sends it immediately.</param>
+		LookupCache(Fetch fetch, size_t capacity, std::chrono::milliseconds ttl, std::chrono::milliseconds batchWindow = std::chrono::milliseconds(0))
+			: _fetch(std::move(fetch))
+			, _capacity(std::max<size_t>(capacity, 1))
+			, _ttl(ttl)
+			, _batchWindow(batchWindow)
+		{
+		}
+
+		/// <summary>
+		/// Gets the values of a set of keys, fetching the ones that are not cached.
+		/// </summary>
+		/// <returns>The values found. Keys unknown to the fetch function are absent from the result.</returns>
+		pplx::task<Map> get(const std::vector<TKey>& keys, pplx::cancellation_token ct = pplx::cancellation_token::none())
+		{
+			Map result;
+			std::vector<pplx::task<Map>> batches;
+			std::shared_ptr<Batch> batchToSchedule;
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				auto now = std::chrono::steady_clock::now();
+				for (const auto& key : keys)
+				{
+					auto it = _entries.find(key);
+					if (it != _entries.end())
+					{
+						if (it->second.expiresAt > now)
+						{
+							_lru.splice(_lru.begin(), _lru, it->second.lruIt);
+							result[key] = it->second.value;
+							continue;
+						}
+						_lru.erase(it->second.lruIt);
+						_entries.erase(it);
+					}
+
+					auto inFlightIt = _inFlight.find(key);
+					if (inFlightIt == _inFlight.end())
+					{
+						if (!_nextBatch)
+						{
+							_nextBatch = std::make_shared<Batch>();
+							batchToSchedule = _nextBatch;
+						}
+						_nextBatch->keys.push_back(key);
+						inFlightIt = _inFlight.emplace(key, pplx::create_task(_nextBatch->tce)).first;
+					}
+
+					if (std::find(batches.begin(), batches.end(), inFlightIt->second) == batches.end())
+					{
+						batches.push_back(inFlightIt->second);
+					}
+				}
+			}
+
+			if (batchToSchedule)
+			{
+				schedule(batchToSchedule);
+			}
+
+			if (batches.empty())
+			{
+				return pplx::task_from_result(result);
+			}
+
+			pplx::task_completion_event<Map> tce;
+			pplx::cancellation_token_registration registration;
+			if (ct.is_cancelable())
+			{
+				registration = ct.register_callback([tce]()
+				{
+					tce.set_exception(pplx::task_canceled());
+				});
+			}
+
+			auto requestedKeys = std::make_shared<std::vector<TKey>>(keys);
+			pplx::when_all(batches.begin(), batches.end()).then([tce, result, requestedKeys, ct, registration](pplx::task<std::vector<Map>> task) mutable
+			{
+				if (ct.is_cancelable())
+				{
+					ct.deregister_callback(registration);
+				}
+				try
+				{
+					auto fetched = task.get();
+					for (const auto& key : *requestedKeys)
+					{
+						for (const auto& values : fetched)
+						{
+							auto it = values.find(key);
+							if (it != values.end())
+							{
+								result[key] = it->second;
+								break;
+							}
+						}
+					}
+					tce.set(result);
+				}
+				catch (...)
+				{
+					tce.set_exception(std::current_exception());
+				}
+			});
+
+			return pplx::create_task(tce);
+		}
+
+		/// <summary>
+		/// Removes a value from the cache.
+		/// </summary>
+		void invalidate(const TKey& key)
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			auto it = _entries.find(key);
+			if (it != _entries.end())
+			{
+				_lru.erase(it->second.lruIt);
+				_entries.erase(it);
+			}
+		}
+
+		void clear()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			_entries.clear();
+			_lru.clear();
+		}
+
+	private:
+
+		struct Batch
+		{
+			std::vector<TKey> keys;
+			pplx::task_completion_event<Map> tce;
+		};
+
+		struct Entry
+		{
+			TValue value;
+			std::chrono::steady_clock::time_point expiresAt;
+			typename std::list<TKey>::iterator lruIt;
+		};
+
+		void schedule(std::shared_ptr<Batch> batch)
+		{
+			std::weak_ptr<LookupCache> wThat = this->shared_from_this();
+			if (_batchWindow.count() > 0)
+			{
+				taskDelay(_batchWindow).then([wThat, batch]()
+				{
+					if (auto that = wThat.lock())
+					{
+						that->send(batch);
+					}
+					else
+					{
+						batch->tce.set_exception(pplx::task_canceled());
+					}
+				});
+			}
+			else
+			{
+				send(batch);
+			}
+		}
+
+		void send(std::shared_ptr<Batch> batch)
+		{
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				if (_nextBatch == batch)
+				{
+					_nextBatch = nullptr;
+				}
+			}
+
+			pplx::task<Map> task;
+			try
+			{
+				task = _fetch(batch->keys);
+			}
+			catch (...)
+			{
+				task = pplx::task_from_exception<Map>(std::current_exception());
+			}
+
+			std::weak_ptr<LookupCache> wThat = this->shared_from_this();
+			task.then([wThat, batch](pplx::task<Map> task)
+			{
+				auto that = wThat.lock();
+				try
+				{
+					auto values = task.get();
+					if (that)
+					{
+						that->complete(*batch, &values);
+					}
+					batch->tce.set(values);
+				}
+				catch (...)
+				{
+					if (that)
+					{
+						that->complete(*batch, nullptr);
+					}
+					batch->tce.set_exception(std::current_exception());
+				}
+			});
+		}
+
+		void complete(const Batch& batch, const Map* values)
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			for (const auto& key : batch.keys)
+			{
+				_inFlight.erase(key);
+			}
+			if (!values)
+			{
+				return;
+			}
+
+			auto expiresAt = std::chrono::steady_clock::now() + _ttl;
+			for (const auto& kvp : *values)
+			{
+				auto it = _entries.find(kvp.first);
+				if (it != _entries.end())
+				{
+					it->second.value = kvp.second;
+					it->second.expiresAt = expiresAt;
+					_lru.splice(_lru.begin(), _lru, it->second.lruIt);
+				}
+				else
+				{
+					_lru.push_front(kvp.first);
+					_entries.emplace(kvp.first, Entry{ kvp.second, expiresAt, _lru.begin() });
+				}
+			}
+
+			while (_entries.size() > _capacity)
+			{
+				_entries.erase(_lru.back());
+				_lru.pop_back();
+			}
+		}
+
+		Fetch _fetch;
+		size_t _capacity;
+		std::chrono::milliseconds _ttl;
+		std::chrono::milliseconds _batchWindow;
+
+		std::mutex _mutex;
+		std::unordered_map<TKey, Entry, THash> _entries;
+		// Most recently used first.
+		std::list<TKey> _lru;
+		std::unordered_map<TKey, pplx::task<Map>, THash> _inFlight;
+		std::shared_ptr<Batch> _nextBatch;
+	};
+}
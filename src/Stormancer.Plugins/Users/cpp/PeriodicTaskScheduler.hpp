@@ -0,0 +1,289 @@
+#pragma once
+
+#include "Users/ConfigurationParameters.hpp"
+#include "stormancer/Configuration.h"
+#include "stormancer/Tasks.h"
+#include "stormancer/Utilities/TaskUtilities.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stormancer
+{
+	/// <summary>
+	/// Counters of a periodic task.
+	/// </summary>
+	struct PeriodicTaskStatistics
+	{
+		std::string name;
+		std::chrono::milliseconds period{ 0 };
+
+		/// <summary>
+		/// Number of executions.
+		/// </summary>
+		uint64 runs = 0;
+
+		/// <summary>
+		/// Ticks skipped because the previous execution had not run yet.
+		/// </summary>
+		uint64 coalesced = 0;
+
+		/// <summary>
+		/// Time spent executing the task.
+		/// </summary>
+		std::chrono::microseconds busyTime{ 0 };
+
+		/// <summary>
+		/// Longest execution.
+		/// </summary>
+		std::chrono::microseconds maxRunTime{ 0 };
+	};
+
+	/// <summary>
+	/// A task run periodically by the PeriodicTaskScheduler.
+	/// </summary>
+	class PeriodicTask : public std::enable_shared_from_this<PeriodicTask>
+	{
+		friend class PeriodicTaskScheduler;
+	public:
+
+		PeriodicTask(std::string name, std::chrono::milliseconds period, std::function<void()> action, std::shared_ptr<IActionDispatcher> dispatcher, std::shared_ptr<ILogger> logger)
+			: _action(std::move(action))
+			, _dispatcher(std::move(dispatcher))
+			, _logger(std::move(logger))
+		{
+			_statistics.name = std::move(name);
+			_statistics.period = clampPeriod(period);
+		}
+
+		~PeriodicTask()
+		{
+			_cts.cancel();
+		}
+
+		/// <summary>
+		/// Starts running the task. Does nothing if it is already started.
+		/// </summary>
+		void start()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			if (_started)
+			{
+				return;
+			}
+			_started = true;
+			_cts = pplx::cancellation_token_source();
+			arm(_cts.get_token());
+		}
+
+		/// <summary>
+		/// Stops running the task. An execution already posted to the dispatcher is skipped.
+		/// </summary>
+		void stop()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			_started = false;
+			_cts.cancel();
+		}
+
+		bool isStarted() const
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			return _started;
+		}
+
+		/// <summary>
+		/// Changes the period of the task. Applies from the next tick.
+		/// </summary>
+		/// <remarks>
+		/// Periods shorter than 1ms are raised to 1ms.
+		/// </remarks>
+		void setPeriod(std::chrono::milliseconds period)
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			_statistics.period = clampPeriod(period);
+		}
+
+		PeriodicTaskStatistics statistics() const
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			return _statistics;
+		}
+
+	private:
+
+		// A period of 0 would arm the next tick right away and keep a thread spinning.
+		static std::chrono::milliseconds clampPeriod(std::chrono::milliseconds period)
+		{
+			return period < std::chrono::milliseconds(1) ? std::chrono::milliseconds(1) : period;
+		}
+
+		// Requires _mutex
+		void arm(pplx::cancellation_token token)
+		{
+			std::weak_ptr<PeriodicTask> wThat = this->shared_from_this();
+			taskDelay(_statistics.period, token).then([wThat, token](pplx::task<void> task)
+			{
+				try
+				{
+					task.get();
+				}
+				catch (const pplx::task_canceled&)
+				{
+					return;
+				}
+
+				if (auto that = wThat.lock())
+				{
+					that->tick(token);
+				}
+			});
+		}
+
+		void tick(pplx::cancellation_token token)
+		{
+			{
+				std::lock_guard<std::mutex> lg(_mutex);
+				if (token.is_canceled())
+				{
+					return;
+				}
+				// The next tick is armed before running this one, so that the period doesn't drift with the execution time and the dispatcher latency.
+				arm(token);
+
+				if (_pending)
+				{
+					_statistics.coalesced++;
+					return;
+				}
+				_pending = true;
+			}
+
+			if (_dispatcher)
+			{
+				std::weak_ptr<PeriodicTask> wThat = this->shared_from_this();
+				_dispatcher->post([wThat, token]()
+				{
+					if (auto that = wThat.lock())
+					{
+						that->run(token);
+					}
+				});
+			}
+			else
+			{
+				run(token);
+			}
+		}
+
+		void run(pplx::cancellation_token token)
+		{
+			if (!token.is_canceled())
+			{
+				auto start = std::chrono::steady_clock::now();
+				try
+				{
+					_action();
+				}
+				catch (const std::exception& ex)
+				{
+					_logger->log(LogLevel::Error, "PeriodicTaskScheduler", "Periodic task '" + _statistics.name + "' failed", ex);
+				}
+				auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+				std::lock_guard<std::mutex> lg(_mutex);
+				_statistics.runs++;
+				_statistics.busyTime += duration;
+				if (duration > _statistics.maxRunTime)
+				{
+					_statistics.maxRunTime = duration;
+				}
+			}
+
+			std::lock_guard<std::mutex> lg(_mutex);
+			_pending = false;
+		}
+
+		std::function<void()> _action;
+		std::shared_ptr<IActionDispatcher> _dispatcher;
+		std::shared_ptr<ILogger> _logger;
+
+		mutable std::mutex _mutex;
+		pplx::cancellation_token_source _cts;
+		bool _started = false;
+		// An execution is posted or running.
+		bool _pending = false;
+		PeriodicTaskStatistics _statistics;
+	};
+
+	/// <summary>
+	/// Runs the periodic work of the client, such as platform SDK pumps, at a bounded rate.
+	/// </summary>
+	/// <remarks>
+	/// Tasks are driven by timers: an idle client doesn't keep the dispatcher busy.
+	/// When a tick is due while the previous execution has not run yet, it is skipped instead of queued.
+	/// The period of a task can be overridden in Configuration::additionalParameters with the key "scheduler.&lt;task name&gt;.periodMs".
+	/// </remarks>
+	class PeriodicTaskScheduler
+	{
+	public:
+
+		PeriodicTaskScheduler(std::shared_ptr<Configuration> config, std::shared_ptr<ILogger> logger)
+			: _config(config)
+			, _logger(logger)
+		{
+		}
+
+		/// <summary>
+		/// Creates a periodic task. The task is not started.
+		/// </summary>
+		/// <param name="name">Name of the task, used for statistics and configuration.</param>
+		/// <param name="period">Default period of the task. Periods shorter than 1ms are raised to 1ms.</param>
+		/// <param name="action">Work to run.</param>
+		/// <param name="runOnDispatcher">Run the task on the action dispatcher of the client (the game thread) instead of a thread pool thread.</param>
+		/// <returns>The task. It stops when destroyed.</returns>
+		std::shared_ptr<PeriodicTask> createTask(const std::string& name, std::chrono::milliseconds period, std::function<void()> action, bool runOnDispatcher = true)
+		{
+			period = readConfigurationParameter(_config, "scheduler." + name + ".periodMs", period);
+
+			auto task = std::make_shared<PeriodicTask>(name, period, std::move(action), runOnDispatcher ? _config->actionDispatcher : nullptr, _logger);
+
+			std::lock_guard<std::mutex> lg(_mutex);
+			_tasks.push_back(task);
+			return task;
+		}
+
+		/// <summary>
+		/// Gets the counters of the tasks still alive.
+		/// </summary>
+		std::vector<PeriodicTaskStatistics> statistics()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			std::vector<PeriodicTaskStatistics> result;
+			for (auto it = _tasks.begin(); it != _tasks.end();)
+			{
+				if (auto task = it->lock())
+				{
+					result.push_back(task->statistics());
+					++it;
+				}
+				else
+				{
+					it = _tasks.erase(it);
+				}
+			}
+			return result;
+		}
+
+	private:
+
+		std::shared_ptr<Configuration> _config;
+		std::shared_ptr<ILogger> _logger;
+		std::mutex _mutex;
+		std::vector<std::weak_ptr<PeriodicTask>> _tasks;
+	};
+}
@@ -0,0 +1,476 @@
+#pragma once
+
+#include "Users/ConfigurationParameters.hpp"
+#include "stormancer/IClient.h"
+#include "stormancer/Tasks.h"
+#include "stormancer/Utilities/TaskUtilities.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stormancer
+{
+	/// <summary>
+	/// Thrown instead of attempting an operation when the circuit breaker of the target service is open.
+	/// </summary>
+	class CircuitOpenException : public std::runtime_error
+	{
+	public:
+
+		CircuitOpenException(const std::string& service)
+			: std::runtime_error("Circuit breaker open for service '" + service + "'")
+		{
+		}
+	};
+
+	/// <summary>
+	/// Parameters of a RetryPolicy.
+	/// </summary>
+	/// <remarks>
+	/// Every field can be overridden in Configuration::additionalParameters with the key "&lt;service&gt;&lt;suffix&gt;",
+	/// where suffix is one of the *Key constants below. For instance "party.stateSync.retry.maxAttempts".
+	/// </remarks>
+	struct RetryPolicyOptions
+	{
+		static constexpr const char* BaseDelayMsKey = ".retry.baseDelayMs";
+		static constexpr const char* MaxDelayMsKey = ".retry.maxDelayMs";
+		static constexpr const char* MaxAttemptsKey = ".retry.maxAttempts";
+		static constexpr const char* JitterKey = ".retry.jitter";
+		static constexpr const char* CircuitBreakerThresholdKey = ".circuitBreaker.failureThreshold";
+		static constexpr const char* CircuitBreakerOpenMsKey = ".circuitBreaker.openMs";
+
+		/// <summary>
+		/// Delay before the first retry. Doubles after each failed attempt.
+		/// </summary>
+		std::chrono::milliseconds baseDelay = std::chrono::milliseconds(200);
+
+		/// <summary>
+		/// Upper bound of the delay between two attempts.
+		/// </summary>
+		std::chrono::milliseconds maxDelay = std::chrono::milliseconds(10000);
+
+		/// <summary>
+		/// Fraction of each delay that is randomized, between 0 and 1, so that clients failing together don't retry together.
+		/// </summary>
+		double jitter = 0.5;
+
+		/// <summary>
+		/// Maximum number of attempts, including the first one. 0 retries until the operation succeeds or is cancelled.
+		/// </summary>
+		int maxAttempts = 0;
+
+		/// <summary>
+		/// Number of consecutive failures of the service after which the circuit breaker opens. 0 disables the circuit breaker.
+		/// </summary>
+		int circuitBreakerThreshold = 5;
+
+		/// <summary>
+		/// How long the circuit breaker stays open before letting a single trial attempt through.
+		/// </summary>
+		std::chrono::milliseconds circuitBreakerOpenDuration = std::chrono::milliseconds(5000);
+
+		template<typename TParameters>
+		void load(const TParameters& parameters, const std::string& service)
+		{
+			// Negative and invalid values are rejected, the default value is kept.
+			auto readCount = [&parameters, &service](const char* suffix, int defaultValue)
+			{
+				auto value = readConfigurationParameter(parameters, service + suffix, static_cast<std::size_t>(defaultValue));
+				return static_cast<int>(std::min<std::size_t>(value, static_cast<std::size_t>(std::numeric_limits<int>::max())));
+			};
+
+			baseDelay = readConfigurationParameter(parameters, service + BaseDelayMsKey, baseDelay);
+			maxDelay = readConfigurationParameter(parameters, service + MaxDelayMsKey, maxDelay);
+			maxAttempts = readCount(MaxAttemptsKey, maxAttempts);
+			jitter = readConfigurationFraction(parameters, service + JitterKey, jitter);
+			circuitBreakerThreshold = readCount(CircuitBreakerThresholdKey, circuitBreakerThreshold);
+			circuitBreakerOpenDuration = readConfigurationParameter(parameters, service + CircuitBreakerOpenMsKey, circuitBreakerOpenDuration);
+		}
+	};
+
+	/// <summary>
+	/// Retry counters of a service.
+	/// </summary>
+	struct RetryStatistics
+	{
+		/// <summary>
+		/// Operations actually sent to the service.
+		/// </summary>
+		uint64 attempts = 0;
+
+		/// <summary>
+		/// Attempts that failed.
+		/// </summary>
+		uint64 failures = 0;
+
+		/// <summary>
+		/// Attempts scheduled after a failure.
+		/// </summary>
+		uint64 retries = 0;
+
+		/// <summary>
+		/// Attempts skipped because the circuit breaker was open.
+		/// </summary>
+		uint64 rejected = 0;
+
+		/// <summary>
+		/// Number of times the circuit breaker opened.
+		/// </summary>
+		uint64 circuitOpened = 0;
+	};
+
+	/// <summary>
+	/// Circuit breaker shared by all the operations targeting the same service.
+	/// </summary>
+	/// <remarks>
+	/// After circuitBreakerThreshold consecutive failures, attempts are rejected without reaching the service for circuitBreakerOpenDuration.
+	/// A single trial attempt is then let through: the breaker closes if it succeeds, and opens again if it fails.
+	/// </remarks>
+	class CircuitBreaker
+	{
+	public:
+
+		enum class State
+		{
+			Closed,
+			Open,
+			HalfOpen
+		};
+
+		CircuitBreaker(std::string service, int failureThreshold, std::chrono::milliseconds openDuration)
+			: _service(std::move(service))
+			, _failureThreshold(failureThreshold)
+			, _openDuration(openDuration)
+		{
+		}
+
+		const std::string& service() const
+		{
+			return _service;
+		}
+
+		/// <summary>
+		/// Checks whether an attempt can be sent to the service now.
+		/// </summary>
+		/// <param name="retryAfter">When the attempt is rejected, how long before the breaker lets a trial attempt through.</param>
+		/// <returns>true if the attempt can be sent.</returns>
+		bool tryAcquire(std::chrono::milliseconds& retryAfter)
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			auto now = std::chrono::steady_clock::now();
+			switch (_state)
+			{
+			case State::Closed:
+				break;
+			case State::Open:
+				if (now < _openUntil)
+				{
+					_statistics.rejected++;
+					retryAfter = std::chrono::duration_cast<std::chrono::milliseconds>(_openUntil - now);
+					return false;
+				}
+				_state = State::HalfOpen;
+				break;
+			case State::HalfOpen:
+				// A trial attempt is already in flight.
+				_statistics.rejected++;
+				retryAfter = _openDuration;
+				return false;
+			}
+			_statistics.attempts++;
+			return true;
+		}
+
+		void recordSuccess()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			_consecutiveFailures = 0;
+			_state = State::Closed;
+		}
+
+		void recordFailure()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			_statistics.failures++;
+			_consecutiveFailures++;
+			if (_failureThreshold > 0 && (_state == State::HalfOpen || _consecutiveFailures >= _failureThreshold))
+			{
+				if (_state != State::Open)
+				{
+					_statistics.circuitOpened++;
+				}
+				_state = State::Open;
+				_openUntil = std::chrono::steady_clock::now() + _openDuration;
+			}
+		}
+
+		/// <summary>
+		/// Releases a trial attempt that completed without reaching a conclusion, for instance because it was cancelled,
+		/// or because it failed with an error that is not retried and so says nothing of the health of the service.
+		/// </summary>
+		void recordAbandoned()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			if (_state == State::HalfOpen)
+			{
+				_state = State::Open;
+				_openUntil = std::chrono::steady_clock::now();
+			}
+		}
+
+		void recordRetry()
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			_statistics.retries++;
+		}
+
+		State state() const
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			return _state;
+		}
+
+		RetryStatistics statistics() const
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			return _statistics;
+		}
+
+	private:
+
+		mutable std::mutex _mutex;
+		std::string _service;
+		int _failureThreshold;
+		std::chrono::milliseconds _openDuration;
+		State _state = State::Closed;
+		int _consecutiveFailures = 0;
+		std::chrono::steady_clock::time_point _openUntil;
+		RetryStatistics _statistics;
+	};
+
+	/// <summary>
+	/// Circuit breakers of a client, by service.
+	/// </summary>
+	class CircuitBreakers
+	{
+	public:
+
+		/// <summary>
+		/// Gets the circuit breaker of a service, creating it with the provided options on first use.
+		/// </summary>
+		std::shared_ptr<CircuitBreaker> get(const std::string& service, const RetryPolicyOptions& options)
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			auto& breaker = _breakers[service];
+			if (!breaker)
+			{
+				breaker = std::make_shared<CircuitBreaker>(service, options.circuitBreakerThreshold, options.circuitBreakerOpenDuration);
+			}
+			return breaker;
+		}
+
+		/// <summary>
+		/// Gets the retry counters of every service.
+		/// </summary>
+		std::unordered_map<std::string, RetryStatistics> statistics() const
+		{
+			std::lock_guard<std::mutex> lg(_mutex);
+			std::unordered_map<std::string, RetryStatistics> result;
+			for (const auto& breaker : _breakers)
+			{
+				result.emplace(breaker.first, breaker.second->statistics());
+			}
+			return result;
+		}
+
+	private:
+
+		mutable std::mutex _mutex;
+		std::unordered_map<std::string, std::shared_ptr<CircuitBreaker>> _breakers;
+	};
+
+	/// <summary>
+	/// Runs an asynchronous operation until it succeeds, with exponential backoff and jitter between attempts.
+	/// </summary>
+	/// <remarks>
+	/// Cheap to copy. Policies targeting the same service should share their CircuitBreaker, see UsersApi::createRetryPolicy.
+	/// </remarks>
+	class RetryPolicy
+	{
+	public:
+
+		RetryPolicy() = default;
+
+		RetryPolicy(RetryPolicyOptions options, std::shared_ptr<CircuitBreaker> circuitBreaker = nullptr)
+			: _options(options)
+			, _circuitBreaker(std::move(circuitBreaker))
+		{
+		}
+
+		const RetryPolicyOptions& options() const
+		{
+			return _options;
+		}
+
+		/// <summary>
+		/// Gets the delay to wait after a number of failed attempts.
+		/// </summary>
+		std::chrono::milliseconds delay(int failedAttempts) const
+		{
+			double delay = double(_options.baseDelay.count()) * std::pow(2.0, std::max(0, failedAttempts - 1));
+			delay = std::min(delay, double(_options.maxDelay.count()));
+
+			thread_local std::mt19937 generator{ std::random_device{}() };
+			std::uniform_real_distribution<double> distribution(0.0, 1.0);
+			delay = delay * (1.0 - _options.jitter) + delay * _options.jitter * distribution(generator);
+
+			return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(delay));
+		}
+
+		/// <summary>
+		/// Runs an operation with retries.
+		/// </summary>
+		/// <param name="operation">Operation to run. Receives the cancellation token.</param>
+		/// <param name="shouldRetry">Called with the error of a failed attempt, inside a catch block. Return false to stop retrying. Such errors don't count toward opening the circuit breaker. Optional.</param>
+		/// <param name="ct">Stops retrying when cancelled.</param>
+		/// <param name="dispatcher">Dispatcher on which attempts are started. Optional.</param>
+		/// <returns>The result of the first successful attempt, or the error of the last one.</returns>
+		template<typename T>
+		pplx::task<T> execute(
+			std::function<pplx::task<T>(pplx::cancellation_token)> operation,
+			std::function<bool(const std::exception&)> shouldRetry = nullptr,
+			pplx::cancellation_token ct = pplx::cancellation_token::none(),
+			std::shared_ptr<IActionDispatcher> dispatcher = nullptr) const
+		{
+			return attempt<T>(1, std::move(operation), std::move(shouldRetry), ct, std::move(dispatcher));
+		}
+
+	private:
+
+		template<typename T>
+		pplx::task<T> attempt(
+			int attemptNumber,
+			std::function<pplx::task<T>(pplx::cancellation_token)> operation,
+			std::function<bool(const std::exception&)> shouldRetry,
+			pplx::cancellation_token ct,
+			std::shared_ptr<IActionDispatcher> dispatcher) const
+		{
+			if (ct.is_canceled())
+			{
+				return pplx::task_from_exception<T>(pplx::task_canceled());
+			}
+
+			std::chrono::milliseconds retryAfter(0);
+			if (_circuitBreaker && !_circuitBreaker->tryAcquire(retryAfter))
+			{
+				try
+				{
+					throw CircuitOpenException(_circuitBreaker->service());
+				}
+				catch (const std::exception& ex)
+				{
+					if (!canRetry(attemptNumber) || (shouldRetry && !shouldRetry(ex)))
+					{
+						return pplx::task_from_exception<T>(std::current_exception());
+					}
+				}
+				return retry<T>(attemptNumber, retryAfter, std::move(operation), std::move(shouldRetry), ct, std::move(dispatcher));
+			}
+
+			pplx::task<T> task;
+			try
+			{
+				task = operation(ct);
+			}
+			catch (...)
+			{
+				task = pplx::task_from_exception<T>(std::current_exception());
+			}
+
+			auto policy = *this;
+			return task.then([policy, attemptNumber, operation, shouldRetry, ct, dispatcher](pplx::task<T> t)
+			{
+				try
+				{
+					t.get();
+					if (policy._circuitBreaker)
+					{
+						policy._circuitBreaker->recordSuccess();
+					}
+					return t;
+				}
+				catch (const pplx::task_canceled&)
+				{
+					if (policy._circuitBreaker)
+					{
+						policy._circuitBreaker->recordAbandoned();
+					}
+					throw;
+				}
+				catch (const std::exception& ex)
+				{
+					// Only the errors that would be retried count toward opening the circuit breaker.
+					// Others, like authentication failures, come from a service that is up.
+					bool retryable = !ct.is_canceled() && (!shouldRetry || shouldRetry(ex));
+					if (policy._circuitBreaker)
+					{
+						if (retryable)
+						{
+							policy._circuitBreaker->recordFailure();
+						}
+						else
+						{
+							policy._circuitBreaker->recordAbandoned();
+						}
+					}
+					if (!retryable || !policy.canRetry(attemptNumber))
+					{
+						throw;
+					}
+				}
+				return policy.retry<T>(attemptNumber, std::chrono::milliseconds(0), operation, shouldRetry, ct, dispatcher);
+			});
+		}
+
+		template<typename T>
+		pplx::task<T> retry(
+			int failedAttempts,
+			std::chrono::milliseconds minDelay,
+			std::function<pplx::task<T>(pplx::cancellation_token)> operation,
+			std::function<bool(const std::exception&)> shouldRetry,
+			pplx::cancellation_token ct,
+			std::shared_ptr<IActionDispatcher> dispatcher) const
+		{
+			if (_circuitBreaker)
+			{
+				_circuitBreaker->recordRetry();
+			}
+
+			auto policy = *this;
+			auto next = [policy, failedAttempts, operation, shouldRetry, ct, dispatcher]()
+			{
+				return policy.attempt<T>(failedAttempts + 1, operation, shouldRetry, ct, dispatcher);
+			};
+			auto delayTask = taskDelay(std::max(delay(failedAttempts), minDelay), ct);
+			return dispatcher ? delayTask.then(next, dispatcher) : delayTask.then(next);
+		}
+
+		bool canRetry(int attemptNumber) const
+		{
+			return _options.maxAttempts <= 0 || attemptNumber < _options.maxAttempts;
+		}
+
+		RetryPolicyOptions _options;
+		std::shared_ptr<CircuitBreaker> _circuitBreaker;
+	};
+}
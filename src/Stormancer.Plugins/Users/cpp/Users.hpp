@@ -10,6 +10,8 @@
 #include "stormancer/Utilities/TaskUtilities.h"
 #include "stormancer/Utilities/PointerUtilities.h"
 #include "stormancer/IPlugin.h"
+#include "Users/RetryPolicy.hpp"
+#include "Users/PeriodicTaskScheduler.hpp"
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -41,6 +43,25 @@ namespace Stormancer
 	/// </example>
 	namespace Users
 	{
+		/// <summary>
+		/// Keys to use in Configuration::additionalParameters map to customize the Users plugin behavior.
+		/// </summary>
+		namespace ConfigurationKeys
+		{
+			/// <summary>
+			/// Prefix of the retry policy keys of the login and automatic reconnection (see RetryPolicyOptions), for instance "users.login.retry.maxDelayMs".
+			/// Defaults: 1s base delay, 30s max delay, unlimited attempts.
+			/// </summary>
+			constexpr const char* LoginRetryPrefix = "users.login";
+
+			/// <summary>
+			/// Prefix of the retry policy keys used when ClientAPI::getService connects to a service scene, followed by the service type.
+			/// For instance "service.stormancer.plugins.leaderboard.retry.maxAttempts".
+			/// Defaults: 500ms base delay, 5s max delay, 3 attempts.
+			/// </summary>
+			constexpr const char* ServiceRetryPrefix = "service.";
+		}
+
 		class UnrecoverableException : public StormancerException
 		{
 		public:
@@ -424,7 +445,14 @@ namespace Stormancer
 				, _logger(client->dependencyResolver().resolve<ILogger>())
 				, _authenticationEventHandlers(authEventHandlers)
 				, _userDispatcher(userDispatcher)
+				, _circuitBreakers(std::make_shared<CircuitBreakers>())
+				, _configuration(client->dependencyResolver().resolve<Configuration>())
 			{
+				RetryPolicyOptions loginRetryOptions;
+				loginRetryOptions.baseDelay = std::chrono::milliseconds(1000);
+				loginRetryOptions.maxDelay = std::chrono::milliseconds(30000);
+				loginRetryOptions.circuitBreakerOpenDuration = std::chrono::milliseconds(30000);
+				_loginRetryPolicy = createRetryPolicy(ConfigurationKeys::LoginRetryPrefix, loginRetryOptions);
 			}
 
 			~UsersApi()
@@ -432,6 +460,26 @@ namespace Stormancer
 				_connectionSubscription.unsubscribe();
 			}
 
+			/// <summary>
+			/// Creates a retry policy for a service, sharing its circuit breaker with the other policies of the same service.
+			/// </summary>
+			/// <param name="service">Name of the service. Also used as prefix of the configuration keys overriding the default options.</param>
+			/// <param name="defaults">Options used for the keys missing from Configuration::additionalParameters.</param>
+			/// <returns></returns>
+			RetryPolicy createRetryPolicy(const std::string& service, RetryPolicyOptions defaults = RetryPolicyOptions())
+			{
+				defaults.load(_configuration->additionalParameters, service);
+				return RetryPolicy(defaults, _circuitBreakers->get(service, defaults));
+			}
+
+			/// <summary>
+			/// Gets the circuit breakers of the client, and through them the retry counters of each service.
+			/// </summary>
+			std::shared_ptr<CircuitBreakers> circuitBreakers() const
+			{
+				return _circuitBreakers;
+			}
+
 			void setAutoReconnect(bool autoReconnect)
 			{
 				_autoReconnectEnabled = autoReconnect;
@@ -766,7 +814,7 @@ namespace Stormancer
 					}
 					else
 					{
-						_authTask = std::make_shared<pplx::task<std::shared_ptr<Scene>>>(withRetries<std::shared_ptr<Scene>>([wThat, userDispatcher = _userDispatcher](pplx::cancellation_token ct)
+						_authTask = std::make_shared<pplx::task<std::shared_ptr<Scene>>>(_loginRetryPolicy.execute<std::shared_ptr<Scene>>([wThat, userDispatcher = _userDispatcher](pplx::cancellation_token ct)
 							{
 								auto that = wThat.lock();
 								if (!that)
@@ -775,7 +823,7 @@ namespace Stormancer
 								}
 								that->_lastError = "";
 								return that->loginImpl(ct);
-							}, 1000ms, int(RETRY_COUNTER_MAX), [wThat, logger = _logger](const std::exception& ex)
+							}, [wThat, logger = _logger](const std::exception& ex)
 								{
 									// determine if the work should continue (retry)
 									if (auto that = wThat.lock())
@@ -802,7 +850,7 @@ namespace Stormancer
 										return retry;
 									}
 									return false;
-								}, _userDispatcher, ct));
+								}, ct, _userDispatcher));
 					}
 				}
 
@@ -1074,7 +1122,6 @@ namespace Stormancer
 		private:
 
 			std::unordered_map<std::string, std::string> _currentStatus;
-			static constexpr int RETRY_COUNTER_MAX = std::numeric_limits<int>::max();
 
 #pragma region private_methods
 
@@ -1436,6 +1483,9 @@ namespace Stormancer
 			std::unordered_map<std::string, std::function<pplx::task<void>(OperationCtx&)>> _operationHandlers;
 			std::vector<std::shared_ptr<IAuthenticationEventHandler>> _authenticationEventHandlers;
 			std::shared_ptr<IActionDispatcher> _userDispatcher;
+			std::shared_ptr<CircuitBreakers> _circuitBreakers;
+			std::shared_ptr<Configuration> _configuration;
+			RetryPolicy _loginRetryPolicy;
 			// The current platform-specific local user, set by the game using setCurrentLocalUser().
 			std::shared_ptr<PlatformUserId> _currentLocalUser;
 
@@ -1463,6 +1513,7 @@ namespace Stormancer
 					ContainerBuilder::All<IAuthenticationEventHandler>,
 					IActionDispatcher
 				>().singleInstance();
+				builder.registerDependency<PeriodicTaskScheduler, Configuration, ILogger>().singleInstance();
 			}
 
 			void clientDisconnecting(std::shared_ptr<IClient> client) override
@@ -0,0 +1,135 @@
+#include "pch.h"
+
+#include "replication/CommandLog.hpp"
+
+using Stormancer::CommandLog::LogEntry;
+using Stormancer::CommandLog::details::LogReorderBuffer;
+
+static std::vector<LogEntry> entries(std::initializer_list<int> ids)
+{
+	std::vector<LogEntry> result;
+	for (auto id : ids)
+	{
+		LogEntry entry;
+		entry.id = id;
+		entry.type = "command";
+		entry.content.push_back((Stormancer::byte)id);
+		result.push_back(entry);
+	}
+	return result;
+}
+
+static std::vector<int> ids(const std::vector<LogEntry>& logEntries)
+{
+	std::vector<int> result;
+	for (const auto& entry : logEntries)
+	{
+		result.push_back(entry.id);
+	}
+	return result;
+}
+
+TEST(CommandLog, ReorderBufferDeliversContiguousEntries)
+{
+	LogReorderBuffer buffer;
+	auto received = entries({ 1, 2, 3 });
+
+	auto delivered = buffer.add(received, 0);
+
+	EXPECT_EQ(std::vector<int>({ 1, 2, 3 }), ids(delivered));
+	EXPECT_EQ(3, delivered[2].content[0]);
+	EXPECT_EQ(0, buffer.size());
+	EXPECT_TRUE(buffer.missingRanges(3).empty());
+}
+
+TEST(CommandLog, ReorderBufferHoldsEntriesAfterAGap)
+{
+	LogReorderBuffer buffer;
+	auto received = entries({ 3, 4, 7 });
+
+	auto delivered = buffer.add(received, 1);
+
+	EXPECT_TRUE(delivered.empty());
+	EXPECT_EQ(3, buffer.size());
+
+	auto missing = buffer.missingRanges(1);
+	ASSERT_EQ(2, missing.size());
+	EXPECT_EQ(2, missing[0].first);
+	EXPECT_EQ(2, missing[0].last);
+	EXPECT_EQ(5, missing[1].first);
+	EXPECT_EQ(6, missing[1].last);
+
+	// The missing entry arrives: the entries up to the next gap are delivered.
+	auto late = entries({ 2 });
+	delivered = buffer.add(late, 1);
+
+	EXPECT_EQ(std::vector<int>({ 2, 3, 4 }), ids(delivered));
+	EXPECT_EQ(1, buffer.size());
+	missing = buffer.missingRanges(4);
+	ASSERT_EQ(1, missing.size());
+	EXPECT_EQ(5, missing[0].first);
+	EXPECT_EQ(6, missing[0].last);
+}
+
+TEST(CommandLog, ReorderBufferIgnoresDuplicatesAndOldEntries)
+{
+	LogReorderBuffer buffer;
+	auto received = entries({ 5, 5, 6 });
+	buffer.add(received, 3);
+	EXPECT_EQ(2, buffer.size());
+
+	// Entries already applied
+	auto old = entries({ 2, 3 });
+	auto delivered = buffer.add(old, 3);
+
+	EXPECT_TRUE(delivered.empty());
+	EXPECT_EQ(2, buffer.size());
+}
+
+TEST(CommandLog, ReorderBufferDropsHighestEntriesBeyondCapacity)
+{
+	LogReorderBuffer buffer(2);
+	auto received = entries({ 4, 6, 5 });
+
+	auto delivered = buffer.add(received, 2);
+
+	EXPECT_TRUE(delivered.empty());
+	EXPECT_EQ(2, buffer.size());
+
+	// 6 was dropped: it is reported missing again once 3 to 5 are delivered.
+	auto late = entries({ 3 });
+	delivered = buffer.add(late, 2);
+	EXPECT_EQ(std::vector<int>({ 3, 4, 5 }), ids(delivered));
+	EXPECT_EQ(0, buffer.size());
+}
+
+TEST(CommandLog, ReorderBufferDeliversContiguousBatchLargerThanCapacity)
+{
+	LogReorderBuffer buffer(2);
+	auto received = entries({ 1, 2, 3, 4, 5, 7, 8, 9 });
+
+	auto delivered = buffer.add(received, 0);
+
+	EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4, 5 }), ids(delivered));
+	// Only the entries after the gap count toward the capacity.
+	EXPECT_EQ(2, buffer.size());
+	auto missing = buffer.missingRanges(5);
+	ASSERT_EQ(1, missing.size());
+	EXPECT_EQ(6, missing[0].first);
+	EXPECT_EQ(6, missing[0].last);
+}
+
+TEST(CommandLog, ReorderBufferDiscardsEntriesCoveredBySnapshot)
+{
+	LogReorderBuffer buffer;
+	auto received = entries({ 3, 5, 8 });
+	buffer.add(received, 1);
+
+	buffer.discardUpTo(5);
+
+	EXPECT_EQ(1, buffer.size());
+	auto missing = buffer.missingRanges(5);
+	ASSERT_EQ(1, missing.size());
+	EXPECT_EQ(6, missing[0].first);
+	EXPECT_EQ(7, missing[0].last);
+}
@@ -0,0 +1,135 @@
+#include "pch.h"
+
+#include "gamefinder/GameFinder.hpp"
+
+using Stormancer::GameFinder::GameFinderStatus;
+using Stormancer::GameFinder::GameFinderStatusDetails;
+using Stormancer::GameFinder::details::GameFinderStatusFrame;
+
+static void writeVarint(std::vector<Stormancer::byte>& buffer, Stormancer::uint64 value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back((Stormancer::byte)(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back((Stormancer::byte)value);
+}
+
+static bool readFrame(std::vector<Stormancer::byte>& buffer, GameFinderStatus& status, GameFinderStatusDetails& details, std::string& ticketId, bool& progressOnly)
+{
+	Stormancer::ibytestream stream(buffer.data(), buffer.size());
+	return GameFinderStatusFrame::read(stream, status, details, ticketId, progressOnly);
+}
+
+TEST(GameFinder, StatusFrameVarint)
+{
+	for (Stormancer::uint64 value : { 0ULL, 1ULL, 127ULL, 128ULL, 300ULL, 16383ULL, 16384ULL, 0xFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL })
+	{
+		std::vector<Stormancer::byte> buffer;
+		writeVarint(buffer, value);
+		Stormancer::ibytestream stream(buffer.data(), buffer.size());
+
+		Stormancer::uint64 read;
+		ASSERT_TRUE(GameFinderStatusFrame::readVarint(stream, read));
+		EXPECT_EQ(value, read);
+		EXPECT_EQ(0, stream.availableSize());
+	}
+}
+
+TEST(GameFinder, StatusFrameVarintRejectsTruncatedAndOversizedValues)
+{
+	std::vector<Stormancer::byte> truncated{ 0x80, 0x80 };
+	Stormancer::ibytestream truncatedStream(truncated.data(), truncated.size());
+	Stormancer::uint64 value;
+	EXPECT_FALSE(GameFinderStatusFrame::readVarint(truncatedStream, value));
+
+	// More than 10 bytes with the continuation bit set
+	std::vector<Stormancer::byte> oversized(11, 0xFF);
+	Stormancer::ibytestream oversizedStream(oversized.data(), oversized.size());
+	EXPECT_FALSE(GameFinderStatusFrame::readVarint(oversizedStream, value));
+}
+
+TEST(GameFinder, StatusFrameWithoutOptionalFields)
+{
+	std::vector<Stormancer::byte> buffer{ GameFinderStatusFrame::Version, (Stormancer::byte)GameFinderStatus::WaitingPlayersReady, 0 };
+	writeVarint(buffer, 123456);
+	writeVarint(buffer, 4500);
+
+	GameFinderStatus status;
+	GameFinderStatusDetails details;
+	std::string ticketId;
+	bool progressOnly;
+	ASSERT_TRUE(readFrame(buffer, status, details, ticketId, progressOnly));
+
+	EXPECT_EQ(GameFinderStatus::WaitingPlayersReady, status);
+	EXPECT_FALSE(progressOnly);
+	EXPECT_TRUE(ticketId.empty());
+	EXPECT_TRUE(details.available);
+	EXPECT_EQ(std::chrono::milliseconds(123456), details.serverTime);
+	EXPECT_EQ(std::chrono::milliseconds(4500), details.searchTime);
+	EXPECT_EQ(std::chrono::milliseconds(-1), details.estimatedWait);
+	EXPECT_EQ(-1, details.queuePosition);
+	EXPECT_EQ(-1, details.criteriaLevel);
+}
+
+TEST(GameFinder, StatusFrameWithAllFields)
+{
+	std::string expectedTicketId = "ticket-1";
+	std::vector<Stormancer::byte> buffer{
+		GameFinderStatusFrame::Version,
+		(Stormancer::byte)GameFinderStatus::Searching,
+		GameFinderStatusFrame::TicketId | GameFinderStatusFrame::EstimatedWait | GameFinderStatusFrame::QueuePosition | GameFinderStatusFrame::CriteriaLevel | GameFinderStatusFrame::ProgressOnly
+	};
+	writeVarint(buffer, 1000);
+	writeVarint(buffer, 200);
+	writeVarint(buffer, expectedTicketId.size());
+	buffer.insert(buffer.end(), expectedTicketId.begin(), expectedTicketId.end());
+	writeVarint(buffer, 30000);
+	writeVarint(buffer, 7);
+	writeVarint(buffer, 2);
+	// Payload following the frame
+	buffer.push_back(0xC0);
+
+	Stormancer::ibytestream stream(buffer.data(), buffer.size());
+	GameFinderStatus status;
+	GameFinderStatusDetails details;
+	std::string ticketId;
+	bool progressOnly;
+	ASSERT_TRUE(GameFinderStatusFrame::read(stream, status, details, ticketId, progressOnly));
+
+	EXPECT_EQ(GameFinderStatus::Searching, status);
+	EXPECT_TRUE(progressOnly);
+	EXPECT_EQ(expectedTicketId, ticketId);
+	EXPECT_EQ(std::chrono::milliseconds(30000), details.estimatedWait);
+	EXPECT_EQ(7, details.queuePosition);
+	EXPECT_EQ(2, details.criteriaLevel);
+	EXPECT_EQ(1, stream.availableSize());
+}
+
+TEST(GameFinder, StatusFrameRejectsInvalidFrames)
+{
+	GameFinderStatus status;
+	GameFinderStatusDetails details;
+	std::string ticketId;
+	bool progressOnly;
+
+	std::vector<Stormancer::byte> header{ GameFinderStatusFrame::Version, 0 };
+	EXPECT_FALSE(readFrame(header, status, details, ticketId, progressOnly));
+
+	std::vector<Stormancer::byte> unknownVersion{ GameFinderStatusFrame::Version + 1, 0, 0, 0, 0 };
+	EXPECT_FALSE(readFrame(unknownVersion, status, details, ticketId, progressOnly));
+
+	std::vector<Stormancer::byte> missingSearchTime{ GameFinderStatusFrame::Version, 0, 0, 0 };
+	EXPECT_FALSE(readFrame(missingSearchTime, status, details, ticketId, progressOnly));
+
+	// Ticket id longer than the rest of the frame
+	std::vector<Stormancer::byte> truncatedTicketId{ GameFinderStatusFrame::Version, 0, GameFinderStatusFrame::TicketId, 0, 0, 10, 'a', 'b' };
+	EXPECT_FALSE(readFrame(truncatedTicketId, status, details, ticketId, progressOnly));
+
+	std::vector<Stormancer::byte> emptyTicketId{ GameFinderStatusFrame::Version, 0, GameFinderStatusFrame::TicketId, 0, 0, 0 };
+	EXPECT_FALSE(readFrame(emptyTicketId, status, details, ticketId, progressOnly));
+
+	std::vector<Stormancer::byte> missingQueuePosition{ GameFinderStatusFrame::Version, 0, GameFinderStatusFrame::QueuePosition, 0, 0 };
+	EXPECT_FALSE(readFrame(missingQueuePosition, status, details, ticketId, progressOnly));
+}
@@ -0,0 +1,143 @@
+#include "pch.h"
+
+#include "users/LookupCache.hpp"
+
+#include <atomic>
+
+using Cache = Stormancer::LookupCache<std::string, std::string>;
+
+// Resolves every key except "unknown", counting the requests and the keys requested.
+struct FakeLookup
+{
+	std::shared_ptr<std::atomic<int>> requests = std::make_shared<std::atomic<int>>(0);
+	std::shared_ptr<std::vector<std::string>> requestedKeys = std::make_shared<std::vector<std::string>>();
+
+	Cache::Fetch fetch()
+	{
+		auto requests = this->requests;
+		auto requestedKeys = this->requestedKeys;
+		return [requests, requestedKeys](const std::vector<std::string>& keys)
+		{
+			(*requests)++;
+			Cache::Map values;
+			for (const auto& key : keys)
+			{
+				requestedKeys->push_back(key);
+				if (key != "unknown")
+				{
+					values[key] = "value-" + key;
+				}
+			}
+			return pplx::task_from_result(values);
+		};
+	}
+};
+
+TEST(LookupCache, FetchesOnlyMissingKeys)
+{
+	FakeLookup lookup;
+	auto cache = std::make_shared<Cache>(lookup.fetch(), 16, std::chrono::minutes(1));
+
+	auto first = cache->get({ "a", "b" }).get();
+	EXPECT_EQ(2, first.size());
+	EXPECT_EQ("value-a", first["a"]);
+	EXPECT_EQ(1, lookup.requests->load());
+
+	auto second = cache->get({ "a", "b", "c" }).get();
+	EXPECT_EQ(3, second.size());
+	EXPECT_EQ(2, lookup.requests->load());
+	EXPECT_EQ(std::vector<std::string>({ "a", "b", "c" }), *lookup.requestedKeys);
+}
+
+TEST(LookupCache, DoesNotCacheUnknownKeys)
+{
+	FakeLookup lookup;
+	auto cache = std::make_shared<Cache>(lookup.fetch(), 16, std::chrono::minutes(1));
+
+	EXPECT_TRUE(cache->get({ "unknown" }).get().empty());
+	EXPECT_TRUE(cache->get({ "unknown" }).get().empty());
+	EXPECT_EQ(2, lookup.requests->load());
+}
+
+TEST(LookupCache, ExpiredValuesAreFetchedAgain)
+{
+	FakeLookup lookup;
+	auto cache = std::make_shared<Cache>(lookup.fetch(), 16, std::chrono::milliseconds(0));
+
+	cache->get({ "a" }).get();
+	cache->get({ "a" }).get();
+	EXPECT_EQ(2, lookup.requests->load());
+}
+
+TEST(LookupCache, EvictsLeastRecentlyUsedValues)
+{
+	FakeLookup lookup;
+	auto cache = std::make_shared<Cache>(lookup.fetch(), 2, std::chrono::minutes(1));
+
+	cache->get({ "a" }).get();
+	cache->get({ "b" }).get();
+	// "a" becomes the most recently used value, "b" is evicted by "c".
+	cache->get({ "a" }).get();
+	cache->get({ "c" }).get();
+	EXPECT_EQ(3, lookup.requests->load());
+
+	cache->get({ "a" }).get();
+	EXPECT_EQ(3, lookup.requests->load());
+	cache->get({ "b" }).get();
+	EXPECT_EQ(4, lookup.requests->load());
+}
+
+TEST(LookupCache, InvalidatedValuesAreFetchedAgain)
+{
+	FakeLookup lookup;
+	auto cache = std::make_shared<Cache>(lookup.fetch(), 16, std::chrono::minutes(1));
+
+	cache->get({ "a" }).get();
+	cache->invalidate("a");
+	cache->get({ "a" }).get();
+	EXPECT_EQ(2, lookup.requests->load());
+}
+
+TEST(LookupCache, KeysInFlightAreFetchedOnce)
+{
+	auto requests = std::make_shared<std::atomic<int>>(0);
+	pplx::task_completion_event<Cache::Map> response;
+	auto cache = std::make_shared<Cache>([requests, response](const std::vector<std::string>&)
+	{
+		(*requests)++;
+		return pplx::create_task(response);
+	}, 16, std::chrono::minutes(1));
+
+	auto first = cache->get({ "a" });
+	auto second = cache->get({ "a" });
+	EXPECT_EQ(1, requests->load());
+
+	Cache::Map values;
+	values["a"] = "value-a";
+	response.set(values);
+
+	EXPECT_EQ("value-a", first.get()["a"]);
+	EXPECT_EQ("value-a", second.get()["a"]);
+	EXPECT_EQ(1, requests->load());
+}
+
+TEST(LookupCache, CancelledLookupDoesNotCancelOtherLookups)
+{
+	pplx::task_completion_event<Cache::Map> response;
+	auto cache = std::make_shared<Cache>([response](const std::vector<std::string>&)
+	{
+		return pplx::create_task(response);
+	}, 16, std::chrono::minutes(1));
+
+	pplx::cancellation_token_source cts;
+	auto cancelled = cache->get({ "a" }, cts.get_token());
+	auto other = cache->get({ "a" });
+	cts.cancel();
+
+	EXPECT_THROW(cancelled.get(), pplx::task_canceled);
+
+	Cache::Map values;
+	values["a"] = "value-a";
+	response.set(values);
+	EXPECT_EQ("value-a", other.get()["a"]);
+}
@@ -0,0 +1,74 @@
+#include "pch.h"
+
+#include "spectate/Spectate.hpp"
+
+using Stormancer::Spectate::SpectatePlaybackOptions;
+using Stormancer::Spectate::details::PlayoutClock;
+
+static SpectatePlaybackOptions options()
+{
+	SpectatePlaybackOptions options;
+	options.timeUnitsPerSecond = 1000;
+	options.minDelay = 200;
+	options.maxDelay = 1000;
+	return options;
+}
+
+TEST(Spectate, LivePlayoutLagsTheNewestFrameByTheDelay)
+{
+	auto now = std::chrono::steady_clock::now();
+	PlayoutClock clock(options(), now);
+
+	// What SpectatePlayback::start() does when the game already sent frames
+	clock.anchor(clock.liveTarget(10000), true, now);
+
+	EXPECT_EQ(200, clock.currentDelay());
+	EXPECT_EQ(9800, clock.playoutTime(10000, now));
+	EXPECT_TRUE(clock.isLive());
+	EXPECT_EQ(9900, clock.playoutTime(10000, now + std::chrono::milliseconds(100)));
+}
+
+TEST(Spectate, LivePlayoutStartedByTheFirstFramesLagsThemByTheDelay)
+{
+	auto now = std::chrono::steady_clock::now();
+	PlayoutClock clock(options(), now);
+	clock.waitLive();
+	EXPECT_FALSE(clock.isStarted());
+
+	clock.onFrameReceived(5000, now);
+	clock.anchor(clock.liveTarget(5000), true, now);
+
+	EXPECT_TRUE(clock.isStarted());
+	EXPECT_EQ(4800, clock.playoutTime(5000, now));
+}
+
+TEST(Spectate, PlayoutRebuildsTheDelayAfterAnUnderrun)
+{
+	auto now = std::chrono::steady_clock::now();
+	PlayoutClock clock(options(), now);
+	clock.anchor(clock.liveTarget(10000), true, now);
+
+	// No frame received for 300ms: playout passed the newest frame.
+	EXPECT_EQ(9800, clock.playoutTime(10000, now + std::chrono::milliseconds(300)));
+}
+
+TEST(Spectate, PlayoutSkipsForwardWhenTooFarBehind)
+{
+	auto now = std::chrono::steady_clock::now();
+	PlayoutClock clock(options(), now);
+	clock.anchor(clock.liveTarget(10000), true, now);
+
+	EXPECT_EQ(19800, clock.playoutTime(20000, now));
+}
+
+TEST(Spectate, PlayoutGoesLiveWhenItCatchesUpAfterASeek)
+{
+	auto now = std::chrono::steady_clock::now();
+	PlayoutClock clock(options(), now);
+	clock.anchor(9500, false, now);
+
+	EXPECT_EQ(9500, clock.playoutTime(10000, now));
+	EXPECT_FALSE(clock.isLive());
+	EXPECT_EQ(9800, clock.playoutTime(10000, now + std::chrono::milliseconds(300)));
+	EXPECT_TRUE(clock.isLive());
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+
+#include "spectate/Spectate.hpp"
+
+using Stormancer::Spectate::details::FrameBatch;
+using Stormancer::Spectate::details::FrameBatchSequencer;
+
+static std::vector<Stormancer::uint64> sequences(const std::vector<std::shared_ptr<FrameBatch>>& batches)
+{
+	std::vector<Stormancer::uint64> result;
+	for (const auto& batch : batches)
+	{
+		result.push_back(batch->dto.sequence);
+	}
+	return result;
+}
+
+TEST(Spectate, UploadBatchesAreNumberedInOrder)
+{
+	FrameBatchSequencer sequencer;
+	for (int i = 0; i < 3; i++)
+	{
+		EXPECT_FALSE(sequencer.push(std::make_shared<FrameBatch>()));
+	}
+
+	std::vector<std::shared_ptr<FrameBatch>> transmitted;
+	while (auto batch = sequencer.nextToTransmit())
+	{
+		transmitted.push_back(batch);
+	}
+
+	EXPECT_EQ(std::vector<Stormancer::uint64>({ 1, 2, 3 }), sequences(transmitted));
+	EXPECT_EQ(3, sequencer.unacknowledged().size());
+}
+
+TEST(Spectate, UploadBatchesPushedDuringTransmissionKeepTheirOrder)
+{
+	FrameBatchSequencer sequencer;
+	sequencer.push(std::make_shared<FrameBatch>());
+	auto first = sequencer.nextToTransmit();
+	sequencer.push(std::make_shared<FrameBatch>());
+	sequencer.push(std::make_shared<FrameBatch>());
+
+	ASSERT_TRUE(first);
+	EXPECT_EQ(1, first->dto.sequence);
+	EXPECT_EQ(2, sequencer.nextToTransmit()->dto.sequence);
+	EXPECT_EQ(3, sequencer.nextToTransmit()->dto.sequence);
+	EXPECT_FALSE(sequencer.nextToTransmit());
+}
+
+TEST(Spectate, UploadAcknowledgementsAreCumulative)
+{
+	FrameBatchSequencer sequencer;
+	for (int i = 0; i < 4; i++)
+	{
+		sequencer.push(std::make_shared<FrameBatch>());
+	}
+
+	EXPECT_EQ(std::vector<Stormancer::uint64>({ 1, 2, 3 }), sequences(sequencer.acknowledge(3)));
+	EXPECT_EQ(1, sequencer.unacknowledged().size());
+
+	// Acknowledgement of a batch already acknowledged, for instance sent again by the server after a rejected batch
+	EXPECT_TRUE(sequencer.acknowledge(2).empty());
+	EXPECT_EQ(1, sequencer.unacknowledged().size());
+
+	EXPECT_EQ(std::vector<Stormancer::uint64>({ 4 }), sequences(sequencer.acknowledge(4)));
+	EXPECT_TRUE(sequencer.unacknowledged().empty());
+}
+
+TEST(Spectate, UploadStopsTrackingOldestBatchesBeyondLimit)
+{
+	FrameBatchSequencer sequencer(2);
+	EXPECT_FALSE(sequencer.push(std::make_shared<FrameBatch>()));
+	EXPECT_FALSE(sequencer.push(std::make_shared<FrameBatch>()));
+
+	auto dropped = sequencer.push(std::make_shared<FrameBatch>());
+
+	ASSERT_TRUE(dropped);
+	EXPECT_EQ(1, dropped->dto.sequence);
+	ASSERT_EQ(2, sequencer.unacknowledged().size());
+	EXPECT_EQ(2, sequencer.unacknowledged().front()->dto.sequence);
+
+	// The batch no longer tracked is still transmitted, so that the server receives contiguous sequence numbers.
+	EXPECT_EQ(1, sequencer.nextToTransmit()->dto.sequence);
+}